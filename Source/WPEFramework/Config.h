@@ -160,6 +160,7 @@ namespace PluginHost {
                     , OOMAdjust(0)
                     , Policy()
                     , StackSize(0)
+                    , Reactors(1)
                     , Umask(1)
                 {
                     Add(_T("user"), &User);
@@ -168,6 +169,7 @@ namespace PluginHost {
                     Add(_T("policy"), &Policy);
                     Add(_T("oomadjust"), &OOMAdjust);
                     Add(_T("stacksize"), &StackSize);
+                    Add(_T("reactors"), &Reactors);
                     Add(_T("umask"), &Umask);
                 }
                 ProcessSet(const ProcessSet& copy)
@@ -178,6 +180,7 @@ namespace PluginHost {
                     , OOMAdjust(copy.OOMAdjust)
                     , Policy(copy.Policy)
                     , StackSize(copy.StackSize)
+                    , Reactors(copy.Reactors)
                     , Umask(copy.Umask)
                 {
                     Add(_T("user"), &User);
@@ -186,6 +189,7 @@ namespace PluginHost {
                     Add(_T("policy"), &Policy);
                     Add(_T("oomadjust"), &OOMAdjust);
                     Add(_T("stacksize"), &StackSize);
+                    Add(_T("reactors"), &Reactors);
                     Add(_T("umask"), &Umask);
                 }
                 ~ProcessSet() override = default;
@@ -198,6 +202,7 @@ namespace PluginHost {
                     Policy = RHS.Policy;
                     OOMAdjust = RHS.OOMAdjust;
                     StackSize = RHS.StackSize;
+                    Reactors = RHS.Reactors;
                     Umask = RHS.Umask;
 
                     return (*this);
@@ -209,6 +214,7 @@ namespace PluginHost {
                 Core::JSON::DecSInt8 OOMAdjust;
                 Core::JSON::EnumType<Core::ProcessInfo::scheduler> Policy;
                 Core::JSON::DecUInt32 StackSize;
+                Core::JSON::DecUInt8 Reactors;
                 Core::JSON::DecUInt16 Umask;
             };
 
@@ -253,6 +259,111 @@ namespace PluginHost {
                 Core::JSON::Boolean OutputEnabled;
             };
 
+            class CompressionConfig : public Core::JSON::Container {
+            public:
+                CompressionConfig()
+                    : Threshold(1024)
+                    , WebSocket(false)
+                    , ContextTakeover(true)
+                {
+                    Add(_T("threshold"), &Threshold);
+                    Add(_T("websocket"), &WebSocket);
+                    Add(_T("contexttakeover"), &ContextTakeover);
+                }
+                CompressionConfig(const CompressionConfig& copy)
+                    : Threshold(copy.Threshold)
+                    , WebSocket(copy.WebSocket)
+                    , ContextTakeover(copy.ContextTakeover)
+                {
+                    Add(_T("threshold"), &Threshold);
+                    Add(_T("websocket"), &WebSocket);
+                    Add(_T("contexttakeover"), &ContextTakeover);
+                }
+                ~CompressionConfig() override = default;
+
+                CompressionConfig& operator=(const CompressionConfig& RHS)
+                {
+                    Threshold = RHS.Threshold;
+                    WebSocket = RHS.WebSocket;
+                    ContextTakeover = RHS.ContextTakeover;
+                    return (*this);
+                }
+
+                Core::JSON::DecUInt32 Threshold;
+                Core::JSON::Boolean WebSocket;
+                Core::JSON::Boolean ContextTakeover;
+            };
+
+            class TLSConfig : public Core::JSON::Container {
+            public:
+                TLSConfig()
+                    : Sessions(32)
+                    , Timeout(300)
+                    , Tickets(true)
+                {
+                    Add(_T("sessions"), &Sessions);
+                    Add(_T("timeout"), &Timeout);
+                    Add(_T("tickets"), &Tickets);
+                }
+                TLSConfig(const TLSConfig& copy)
+                    : Sessions(copy.Sessions)
+                    , Timeout(copy.Timeout)
+                    , Tickets(copy.Tickets)
+                {
+                    Add(_T("sessions"), &Sessions);
+                    Add(_T("timeout"), &Timeout);
+                    Add(_T("tickets"), &Tickets);
+                }
+                ~TLSConfig() override = default;
+
+                TLSConfig& operator=(const TLSConfig& RHS)
+                {
+                    Sessions = RHS.Sessions;
+                    Timeout = RHS.Timeout;
+                    Tickets = RHS.Tickets;
+                    return (*this);
+                }
+
+                Core::JSON::DecUInt32 Sessions;
+                Core::JSON::DecUInt32 Timeout;
+                Core::JSON::Boolean Tickets;
+            };
+
+            class OutboundConfig : public Core::JSON::Container {
+            public:
+                OutboundConfig()
+                    : Messages(0)
+                    , Bytes(0)
+                    , Policy(PluginHost::Channel::DROP_OLDEST)
+                {
+                    Add(_T("messages"), &Messages);
+                    Add(_T("bytes"), &Bytes);
+                    Add(_T("policy"), &Policy);
+                }
+                OutboundConfig(const OutboundConfig& copy)
+                    : Messages(copy.Messages)
+                    , Bytes(copy.Bytes)
+                    , Policy(copy.Policy)
+                {
+                    Add(_T("messages"), &Messages);
+                    Add(_T("bytes"), &Bytes);
+                    Add(_T("policy"), &Policy);
+                }
+                ~OutboundConfig() override = default;
+
+                OutboundConfig& operator=(const OutboundConfig& RHS)
+                {
+                    Messages = RHS.Messages;
+                    Bytes = RHS.Bytes;
+                    Policy = RHS.Policy;
+                    return (*this);
+                }
+
+                Core::JSON::DecUInt32 Messages;
+                Core::JSON::DecUInt32 Bytes;
+                Core::JSON::EnumType<PluginHost::Channel::overflow> Policy;
+            };
+
 #ifdef PROCESSCONTAINERS_ENABLED
 
             class ProcessContainerConfig : public Core::JSON::Container {
@@ -315,6 +426,11 @@ namespace PluginHost {
                 , DefaultTraceCategories(false)
                 , Process()
                 , Input()
+                , Compression()
+                , TLS()
+                , Outbound()
+                , Startup(1)
+                , Zygote(false)
                 , Configs()
                 , Environments()
                 , ExitReasons()
@@ -343,6 +459,11 @@ namespace PluginHost {
                 Add(_T("redirect"), &Redirect);
                 Add(_T("process"), &Process);
                 Add(_T("input"), &Input);
+                Add(_T("compression"), &Compression);
+                Add(_T("tls"), &TLS);
+                Add(_T("outbound"), &Outbound);
+                Add(_T("startup"), &Startup);
+                Add(_T("zygote"), &Zygote);
                 Add(_T("plugins"), &Plugins);
                 Add(_T("configs"), &Configs);
                 Add(_T("environments"), &Environments);
@@ -375,6 +496,11 @@ namespace PluginHost {
             Core::JSON::String DefaultTraceCategories;
             ProcessSet Process;
             InputConfig Input;
+            CompressionConfig Compression;
+            TLSConfig TLS;
+            OutboundConfig Outbound;
+            Core::JSON::DecUInt8 Startup;
+            Core::JSON::Boolean Zygote;
             Core::JSON::String Configs;
             Core::JSON::ArrayType<Plugin::Config> Plugins;
             Core::JSON::ArrayType<Environment> Environments;
@@ -492,6 +618,17 @@ namespace PluginHost {
         Config(Core::File& file, const bool background, Core::OptionalType<Core::JSON::Error>& error)
             : _background(background)
             , _security(nullptr)
+            , _compressionThreshold(~0)
+            , _webSocketCompression(false)
+            , _contextTakeover(true)
+            , _tlsSessions(32)
+            , _tlsTimeout(300)
+            , _tlsTickets(true)
+            , _outboundMessages(0)
+            , _outboundBytes(0)
+            , _outboundPolicy(PluginHost::Channel::DROP_OLDEST)
+            , _startup(1)
+            , _zygote(false)
             , _inputInfo()
             , _processInfo()
             , _plugins()
@@ -522,7 +659,21 @@ namespace PluginHost {
                 _interface = config.Interface.Value();
                 _portNumber = config.Port.Value();
                 _stackSize = config.Process.IsSet() ? config.Process.StackSize.Value() : 0;
+                _reactors = config.Process.IsSet() ? config.Process.Reactors.Value() : 1;
                 _inputInfo.Set(config.Input);
+
+                // Without a compression section, nothing is compressed.
+                _compressionThreshold = (config.Compression.IsSet() ? config.Compression.Threshold.Value() : ~0);
+                _webSocketCompression = (config.Compression.IsSet() && config.Compression.WebSocket.Value());
+                _contextTakeover = config.Compression.ContextTakeover.Value();
+                _tlsSessions = config.TLS.Sessions.Value();
+                _tlsTimeout = config.TLS.Timeout.Value();
+                _tlsTickets = config.TLS.Tickets.Value();
+                _outboundMessages = config.Outbound.Messages.Value();
+                _outboundBytes = config.Outbound.Bytes.Value();
+                _outboundPolicy = config.Outbound.Policy.Value();
+                _startup = config.Startup.Value();
+                _zygote = config.Zygote.Value();
                 _processInfo.Set(config.Process);
 
                 _traceCategoriesFile = config.DefaultTraceCategories.IsQuoted();
@@ -676,6 +827,9 @@ namespace PluginHost {
         inline uint32_t StackSize() const {
             return (_stackSize);
         }
+        inline uint8_t Reactors() const {
+            return (_reactors);
+        }
         inline const InputInfo& Input() const {
             return(_inputInfo);
         }
@@ -685,6 +839,44 @@ namespace PluginHost {
         inline bool IPv6() const {
             return (_IPV6);
         }
+        // HTTP response bodies of this size, or larger, are compressed if the client accepts it.
+        inline uint32_t CompressionThreshold() const {
+            return (_compressionThreshold);
+        }
+        inline bool WebSocketCompression() const {
+            return (_webSocketCompression);
+        }
+        inline bool ContextTakeover() const {
+            return (_contextTakeover);
+        }
+        // Outbound TLS connections remember this many sessions, for timeout seconds, to resume them.
+        inline uint32_t TLSSessions() const {
+            return (_tlsSessions);
+        }
+        inline uint32_t TLSTimeout() const {
+            return (_tlsTimeout);
+        }
+        inline bool TLSTickets() const {
+            return (_tlsTickets);
+        }
+        // Per channel limits on queued outbound messages/bytes (0 is unlimited) and what to do when they are hit.
+        inline uint32_t OutboundMessages() const {
+            return (_outboundMessages);
+        }
+        inline uint32_t OutboundBytes() const {
+            return (_outboundBytes);
+        }
+        inline PluginHost::Channel::overflow OutboundPolicy() const {
+            return (_outboundPolicy);
+        }
+        // Number of autostart plugins that may be activated at the same time, 1 activates them one by one.
+        inline uint8_t StartupConcurrency() const {
+            return (_startup);
+        }
+        // Launch out-of-process plugins by forking a preloaded host process instead of fork/exec.
+        inline bool Zygote() const {
+            return (_zygote);
+        }
         const Plugin::Config* Plugin(const string& name) const {
             Core::JSON::ArrayType<Plugin::Config>::ConstIterator index(_plugins.Elements());
 
@@ -827,6 +1019,18 @@ namespace PluginHost {
         bool _IPV6;
         uint16_t _idleTime;
         uint32_t _stackSize;
+        uint8_t _reactors;
+        uint32_t _compressionThreshold;
+        bool _webSocketCompression;
+        bool _contextTakeover;
+        uint32_t _tlsSessions;
+        uint32_t _tlsTimeout;
+        bool _tlsTickets;
+        uint32_t _outboundMessages;
+        uint32_t _outboundBytes;
+        PluginHost::Channel::overflow _outboundPolicy;
+        uint8_t _startup;
+        bool _zygote;
         InputInfo _inputInfo;
         ProcessInfo _processInfo;
         Core::JSON::ArrayType<Plugin::Config> _plugins;
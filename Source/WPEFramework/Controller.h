@@ -263,6 +263,13 @@ namespace Plugin {
                 newElement = snapshot.Slot[teller];
                 data.ThreadPoolRuns.Add(newElement);
             }
+
+#ifdef SECURESOCKETS_ENABLED
+            const Crypto::SecureSocketPort::Statistics handshakes = Crypto::SecureSocketPort::Handshakes();
+
+            data.FullHandshakes = handshakes.Full;
+            data.ResumedHandshakes = handshakes.Resumed;
+#endif
 		}
         void SubSystems();
         void SubSystems(Core::JSON::ArrayType<Core::JSON::EnumType<PluginHost::ISubSystem::subsystem>>::ConstIterator& index);
@@ -282,6 +289,7 @@ namespace Plugin {
         uint32_t endpoint_harakiri();
         uint32_t get_status(const string& index, Core::JSON::ArrayType<PluginHost::MetaData::Service>& response) const;
         uint32_t get_links(Core::JSON::ArrayType<PluginHost::MetaData::Channel>& response) const;
+        uint32_t get_metrics(const string& index, Core::JSON::ArrayType<PluginHost::MetaData::Metrics>& response) const;
         uint32_t get_processinfo(PluginHost::MetaData::Server& response) const;
         uint32_t get_subsystems(Core::JSON::ArrayType<JsonData::Controller::SubsystemsParamsData>& response) const;
         uint32_t get_discoveryresults(Core::JSON::ArrayType<PluginHost::MetaData::Bridge>& response) const;
@@ -41,6 +41,7 @@ namespace Plugin {
         Register<void,void>(_T("harakiri"), &Controller::endpoint_harakiri, this);
         Property<Core::JSON::ArrayType<PluginHost::MetaData::Service>>(_T("status"), &Controller::get_status, nullptr, this);
         Property<Core::JSON::ArrayType<PluginHost::MetaData::Channel>>(_T("links"), &Controller::get_links, nullptr, this);
+        Property<Core::JSON::ArrayType<PluginHost::MetaData::Metrics>>(_T("metrics"), &Controller::get_metrics, nullptr, this);
         Property<PluginHost::MetaData::Server>(_T("processinfo"), &Controller::get_processinfo, nullptr, this);
         Property<Core::JSON::ArrayType<SubsystemsParamsData>>(_T("subsystems"), &Controller::get_subsystems, nullptr, this);
         Property<Core::JSON::ArrayType<PluginHost::MetaData::Bridge>>(_T("discoveryresults"), &Controller::get_discoveryresults, nullptr, this);
@@ -62,6 +63,7 @@ namespace Plugin {
         Unregister(_T("discoveryresults"));
         Unregister(_T("subsystems"));
         Unregister(_T("processinfo"));
+        Unregister(_T("metrics"));
         Unregister(_T("links"));
         Unregister(_T("status"));
         Unregister(_T("clone"));
@@ -291,6 +293,34 @@ namespace Plugin {
         return result;
     }
 
+    // Property: metrics - Latency percentiles of the requests handled by the plugins
+    // Return codes:
+    //  - ERROR_NONE: Success
+    //  - ERROR_UNKNOWN_KEY: The service does not exist
+    uint32_t Controller::get_metrics(const string& index, Core::JSON::ArrayType<PluginHost::MetaData::Metrics>& response) const
+    {
+        uint32_t result = Core::ERROR_UNKNOWN_KEY;
+        Core::ProxyType<PluginHost::Server::Service> service;
+
+        ASSERT(_pluginServer != nullptr);
+
+        if (index.empty() == true) {
+            _pluginServer->Services().GetMetrics(response);
+            result = Core::ERROR_NONE;
+        }
+        else {
+            if (_pluginServer->Services().FromIdentifier(index, service) == Core::ERROR_NONE) {
+                ASSERT(service.IsValid());
+
+                service->GetMetrics(response.Add());
+
+                result = Core::ERROR_NONE;
+            }
+        }
+
+        return result;
+    }
+
     // Property: links - Information about active connections
     // Return codes:
     //  - ERROR_NONE: Success
@@ -34,6 +34,7 @@ set(PRIORITY 0 CACHE STRING "Change the nice level [-20 - 20]")
 set(POLICY "OTHER" CACHE STRING "NA")
 set(OOMADJUST 0 CACHE STRING "Adapt the OOM score [-15 - 15]")
 set(STACKSIZE 0 CACHE STRING "Default stack size per thread")
+set(REACTORS 1 CACHE STRING "Number of threads handling the sockets and other monitored resources")
 set(KEY_OUTPUT_DISABLED false CACHE STRING "New outputs on the VirtualInput will be disabled by default")
 set(EXIT_REASONS "Failure;MemoryExceeded;WatchdogExpired" CACHE STRING "Process exit reason list for which the postmortem is required")
 
@@ -62,6 +63,7 @@ map()
     kv(policy ${POLICY})
     kv(oomadjust ${OOMADJUST})
     kv(stacksize ${STACKSIZE})
+    kv(reactors ${REACTORS})
 end()
 ans(PROCESS_CONFIG)
 map_append(${CONFIG} process ${PROCESS_CONFIG})
@@ -355,6 +355,12 @@ namespace PluginHost {
                 if (_config->StackSize() != 0) {
                     Core::Thread::DefaultStackSize(_config->StackSize()); 
                 }
+                if (_config->Reactors() > 1) {
+                    Core::ResourceMonitor::Reactors(_config->Reactors());
+                }
+#ifdef SECURESOCKETS_ENABLED
+                Crypto::SecureSocketPort::SessionCache(_config->TLSSessions(), _config->TLSTimeout(), _config->TLSTickets());
+#endif
 
 #ifndef __WINDOWS__
                 if (_config->Process().UMask() != 0) {
@@ -620,6 +626,7 @@ namespace PluginHost {
                         info.descriptor = ~0;
                         info.events = 0;
                         info.monitor = 0;
+                        info.ready = 0;
 
                         while (monitor.Info(index, info) == true) {
 #ifdef __WINDOWS__
@@ -648,7 +655,7 @@ namespace PluginHost {
                             flags[7] = '\0';
 #endif
                       
-                            printf ("%6d [%s]: %s\n", info.descriptor, flags, Core::ClassNameOnly(info.classname).Text().c_str());
+                            printf ("%6d [%s] %8u: %s\n", info.descriptor, flags, info.ready, Core::ClassNameOnly(info.classname).Text().c_str());
                             index++;
                         }
                         break;
@@ -656,9 +663,14 @@ namespace PluginHost {
                     case 'Q':
                         break;
                     case 'R': {
-                        printf("\nMonitor callstack:\n");
-                        printf("============================================================\n");
-                        ::DumpCallStack(Core::ResourceMonitor::Instance().Id(), stdout);
+                        Core::ResourceMonitor& monitor = Core::ResourceMonitor::Instance();
+                        for (uint8_t index = 0; index < monitor.Reactors(); index++) {
+                            if (monitor.Id(index) != 0) {
+                                printf("\nMonitor callstack [%d]:\n", index);
+                                printf("============================================================\n");
+                                ::DumpCallStack(monitor.Id(index), stdout);
+                            }
+                        }
                         break;
                     }
                     case '0':
@@ -175,6 +175,10 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
 
             newInfo.Activity = client->HasActivity();
             newInfo.Remote = client->RemoteId();
+            newInfo.Queued = client->QueuedMessages();
+            newInfo.QueuedBytes = client->QueuedBytes();
+            newInfo.Peak = client->PeakMessages();
+            newInfo.Dropped = client->DroppedMessages();
             newInfo.JSONState = (client->IsWebSocket() ? ((client->State() != PluginHost::Channel::RAW) ? MetaData::Channel::RAWSOCKET : MetaData::Channel::WEBSOCKET) : (client->IsWebServer() ? MetaData::Channel::WEBSERVER : MetaData::Channel::SUSPENDED));
             string name = client->Name();
 
@@ -331,6 +335,8 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
             } else {
 
                 State(ACTIVATION);
+                _activationStart = Core::Time::Now().Ticks();
+                _activationEnd = 0;
                 _administrator.StateChange(this);
 
                 Unlock();
@@ -347,6 +353,7 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
 
                     Lock();
                     ReleaseInterfaces();
+                    _activationEnd = Core::Time::Now().Ticks();
                     State(DEACTIVATED);
                     _administrator.StateChange(this);
                 } else {
@@ -365,6 +372,7 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
 
                     SYSLOG(Logging::Startup, (_T("Activated plugin [%s]:[%s]"), className.c_str(), callSign.c_str()));
                     Lock();
+                    _activationEnd = Core::Time::Now().Ticks();
                     State(ACTIVATED);
                     _administrator.StateChange(this);
 
@@ -541,6 +549,14 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
         , _service()
     {
         TRACE(Activity, (_T("Construct a link with ID: [%d] to [%s]"), Id(), remoteId.QualifiedName().c_str()));
+
+        ContentCompression(_parent._config.CompressionThreshold());
+
+        if (_parent._config.WebSocketCompression() == true) {
+            MessageCompression(true, _parent._config.ContextTakeover());
+        }
+
+        Limits(_parent._config.OutboundMessages(), _parent._config.OutboundBytes(), _parent._config.OutboundPolicy());
     }
 
     /* virtual */ Server::Channel::~Channel()
@@ -709,6 +725,10 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
         _dispatcher.Run();
         Dispatcher().Open(MAX_EXTERNAL_WAITS);
 
+        // Never occupy all threads of the pool, plugins might need it themselves while they initialize.
+        const uint8_t concurrency = std::max(std::min(_config.StartupConcurrency(), static_cast<uint8_t>(THREADPOOL_COUNT - 1)), static_cast<uint8_t>(1));
+        Activator activator(_dispatcher, concurrency);
+
         // Right we have the shells for all possible services registered, time to activate what is needed :-)
         ServiceMap::Iterator iterator(_services.Services());
 
@@ -717,11 +737,179 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
             Core::ProxyType<Service> service(*iterator);
 
             if (service->AutoStart() == true) {
-                service->Activate(PluginHost::IShell::STARTUP);
+                activator.Add(service);
             } else {
                 SYSLOG(Logging::Startup, (_T("Activation of plugin [%s]:[%s] blocked"), service->ClassName().c_str(), service->Callsign().c_str()));
             }
         }
+
+        activator.Run();
+    }
+
+    void Server::Activator::Add(const Core::ProxyType<Service>& service)
+    {
+        Entry& entry(_entries[service->Callsign()]);
+
+        entry.Plugin = service;
+        entry.Pending = 0;
+        entry.Started = false;
+        entry.Blocked = false;
+
+        _order.push_back(service->Callsign());
+    }
+
+    void Server::Activator::Run()
+    {
+        // Resolve the explicit dependencies. Subsystem preconditions need no ordering, a plugin
+        // waiting for them is postponed by its activation and picked up when they are met.
+        for (const string& callsign : _order) {
+            Entry& entry(_entries[callsign]);
+            Core::JSON::ArrayType<Core::JSON::String>::ConstIterator index(entry.Plugin->PluginHost::Service::Configuration().Dependencies.Elements());
+
+            while (index.Next() == true) {
+                std::map<string, Entry>::iterator dependency(_entries.find(index.Current().Value()));
+
+                if ((dependency == _entries.end()) || (dependency->first == callsign)) {
+                    SYSLOG(Logging::Startup, (_T("Dependency [%s] of plugin [%s] is not started automatically, ignored"), index.Current().Value().c_str(), callsign.c_str()));
+                } else {
+                    dependency->second.Dependents.push_back(callsign);
+                    entry.Pending++;
+                }
+            }
+
+            if (entry.Pending == 0) {
+                _ready.push_back(callsign);
+            }
+        }
+
+        _remaining = static_cast<uint32_t>(_entries.size());
+
+        if (_concurrency <= 1) {
+            // Keep activating on this thread, one by one, just as if there is no scheduling at all.
+            Entry* entry;
+
+            _adminLock.Lock();
+
+            while ((entry = Next()) != nullptr) {
+                Core::ProxyType<Service> service(entry->Plugin);
+
+                _adminLock.Unlock();
+
+                Activate(service);
+
+                _adminLock.Lock();
+            }
+
+            _adminLock.Unlock();
+        } else if (_remaining > 0) {
+            _adminLock.Lock();
+            Schedule();
+            _adminLock.Unlock();
+
+            _done.Lock(Core::infinite);
+        }
+    }
+
+    // Must be called with the _adminLock taken.
+    Server::Activator::Entry* Server::Activator::Next()
+    {
+        Entry* result = nullptr;
+
+        if ((_ready.empty() == true) && (_running == 0) && (_remaining > 0)) {
+            // Nothing is running and nothing can be started, there must be a circular dependency.
+            // Break it by starting the first plugin that has not been started yet.
+            std::list<string>::const_iterator index(_order.begin());
+
+            while ((index != _order.end()) && (_entries[*index].Started == true)) {
+                index++;
+            }
+
+            ASSERT(index != _order.end());
+
+            SYSLOG(Logging::Startup, (_T("Circular dependency detected, activating plugin [%s] anyway"), index->c_str()));
+            _ready.push_back(*index);
+        }
+
+        if (_ready.empty() == false) {
+            result = &(_entries[_ready.front()]);
+            _ready.pop_front();
+
+            result->Started = true;
+            _running++;
+        }
+
+        return (result);
+    }
+
+    // Must be called with the _adminLock taken.
+    void Server::Activator::Schedule()
+    {
+        Entry* entry;
+
+        while ((_running < _concurrency) && ((entry = Next()) != nullptr)) {
+            _workerPool.Submit(Core::ProxyType<Core::IDispatch>(Core::ProxyType<Job>::Create(*this, entry->Plugin)));
+        }
+    }
+
+    // Must be called with the _adminLock taken.
+    void Server::Activator::Release(const string& callsign, const bool available)
+    {
+        const Entry& entry(_entries[callsign]);
+
+        for (const string& name : entry.Dependents) {
+            Entry& dependent(_entries[name]);
+
+            ASSERT(dependent.Pending > 0);
+
+            dependent.Pending--;
+            dependent.Blocked = (dependent.Blocked || (available == false));
+
+            if ((dependent.Pending == 0) && (dependent.Started == false)) {
+                if (dependent.Blocked == false) {
+                    _ready.push_back(name);
+                } else {
+                    // Not activated, so whatever depends on it is not activated either.
+                    SYSLOG(Logging::Startup, (_T("Activation of plugin [%s] skipped, a plugin it depends on is not activated"), name.c_str()));
+
+                    dependent.Started = true;
+                    _remaining--;
+
+                    Release(name, false);
+                }
+            }
+        }
+    }
+
+    void Server::Activator::Activate(const Core::ProxyType<Service>& service)
+    {
+        service->Activate(PluginHost::IShell::STARTUP);
+
+        const PluginHost::IShell::state state(service->State());
+
+        _adminLock.Lock();
+
+        if ((state == PluginHost::IShell::PRECONDITION) && (_entries[service->Callsign()].Dependents.empty() == false)) {
+            // It is activated as soon as its subsystems are there, its dependents do not wait for that.
+            SYSLOG(Logging::Startup, (_T("Plugin [%s] is postponed, the plugins depending on it are activated without it"), service->Callsign().c_str()));
+        }
+
+        Release(service->Callsign(), ((state == PluginHost::IShell::ACTIVATED) || (state == PluginHost::IShell::PRECONDITION)));
+
+        _running--;
+        _remaining--;
+
+        const bool completed = (_remaining == 0);
+
+        if (_concurrency > 1) {
+            Schedule();
+        }
+
+        _adminLock.Unlock();
+
+        // Once signalled, Run() returns and the activator is gone, so this must be the last thing done.
+        if ((completed == true) && (_concurrency > 1)) {
+            _done.SetEvent();
+        }
     }
 
     void Server::Close()
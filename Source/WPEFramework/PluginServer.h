@@ -400,6 +400,86 @@ namespace PluginHost {
                 uint32_t _value;
             };
 
+            // Latency histograms of the web requests and JSON-RPC methods handled by this plugin.
+            class Metrics {
+            private:
+                // Method names come from the requests, do not let a misbehaving client grow this forever.
+                static constexpr uint16_t MaxMethods = 128;
+
+                typedef Core::HistogramType<> Histogram;
+                typedef std::map<string, Histogram> Methods;
+
+            public:
+                Metrics(const Metrics&) = delete;
+                Metrics& operator=(const Metrics&) = delete;
+
+                Metrics()
+                    : _lock()
+                    , _requests()
+                    , _methods()
+                {
+                }
+                ~Metrics()
+                {
+                }
+
+            public:
+                inline void Request(const uint32_t duration)
+                {
+                    _requests.Set(duration);
+                }
+                void Method(const string& name, const uint32_t duration)
+                {
+                    Histogram* histogram = nullptr;
+
+                    _lock.Lock();
+
+                    Methods::iterator index(_methods.find(name));
+
+                    if (index != _methods.end()) {
+                        histogram = &(index->second);
+                    } else if (_methods.size() < MaxMethods) {
+                        histogram = &(_methods.emplace(std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple()).first->second);
+                    }
+
+                    _lock.Unlock();
+
+                    // Entries are never removed, so recording can be done without the lock.
+                    if (histogram != nullptr) {
+                        histogram->Set(duration);
+                    }
+                }
+                void Get(MetaData::Metrics& metaData) const
+                {
+                    Fill(_requests, metaData.Requests);
+
+                    _lock.Lock();
+
+                    for (const std::pair<const string, Histogram>& entry : _methods) {
+                        MetaData::Metrics::Latency& latency(metaData.Methods.Add());
+                        latency.Method = entry.first;
+                        Fill(entry.second, latency);
+                    }
+
+                    _lock.Unlock();
+                }
+
+            private:
+                static void Fill(const Histogram& histogram, MetaData::Metrics::Latency& latency)
+                {
+                    latency.Count = histogram.Measurements();
+                    latency.P50 = histogram.Percentile(50);
+                    latency.P90 = histogram.Percentile(90);
+                    latency.P99 = histogram.Percentile(99);
+                    latency.Max = histogram.Max();
+                }
+
+            private:
+                mutable Core::CriticalSection _lock;
+                Histogram _requests;
+                Methods _methods;
+            };
+
         public:
             Service(const PluginHost::Config& server, const Plugin::Config& plugin, ServiceMap& administrator)
                 : PluginHost::Service(plugin, server.WebPrefix(), server.PersistentPath(), server.DataPath(), server.VolatilePath())
@@ -416,6 +496,9 @@ namespace PluginHost {
                 , _termination(plugin.Termination, false)
                 , _activity(0)
                 , _connection(nullptr)
+                , _activationStart(0)
+                , _activationEnd(0)
+                , _metrics()
                 , _administrator(administrator)
             {
             }
@@ -582,7 +665,7 @@ namespace PluginHost {
                     result = _unavailableHandler;
                 } else if (IsWebServerRequest(request.Path) == true) {
                     result = IFactories::Instance().Response();
-                    FileToServe(request.Path, *result);
+                    FileToServe(request, *result);
                 } else if (request.Verb == Web::Request::HTTP_OPTIONS) {
 
                     result = IFactories::Instance().Response();
@@ -623,7 +706,9 @@ namespace PluginHost {
                     IncrementProcessedRequests();
 #endif
                     Core::InterlockedIncrement(_activity);
+                    const uint64_t start = Core::Time::Now().Ticks();
                     result = service->Process(request);
+                    _metrics.Request(static_cast<uint32_t>(std::min(Core::Time::Now().Ticks() - start, static_cast<uint64_t>(~static_cast<uint32_t>(0)))));
                     Core::InterlockedDecrement(_activity);
 
                     service->Release();
@@ -648,9 +733,16 @@ namespace PluginHost {
                     IncrementProcessedRequests();
 #endif
                     Core::InterlockedIncrement(_activity);
+                    const uint64_t start = Core::Time::Now().Ticks();
                     result = service->Invoke(token, id, message);
+                    const uint64_t duration = Core::Time::Now().Ticks() - start;
                     Core::InterlockedDecrement(_activity);
 
+                    // Calls to methods that do not exist are not worth a histogram.
+                    if ((result.IsValid() == false) || (result->Error.Code.IsSet() == false) || ((result->Error.Code.Value() != -32601) && (result->Error.Code.Value() != -32600))) {
+                        _metrics.Method(message.Method(), static_cast<uint32_t>(std::min(duration, static_cast<uint64_t>(~static_cast<uint32_t>(0)))));
+                    }
+
                     service->Release();
                 } else {
                     Unlock();
@@ -740,9 +832,19 @@ namespace PluginHost {
                     metaData.Module = _moduleName;
                 if (_versionHash.empty() == false)
                     metaData.Hash = _versionHash;
+                if (_activationStart != 0) {
+                    metaData.ActivationStart = _activationStart;
+                    if (_activationEnd != 0)
+                        metaData.ActivationEnd = _activationEnd;
+                }
 
                 PluginHost::Service::GetMetaData(metaData);
             }
+            inline void GetMetrics(MetaData::Metrics& metaData) const
+            {
+                metaData.Callsign = Callsign();
+                _metrics.Get(metaData);
+            }
             inline void Evaluate()
             {
                 Lock();
@@ -995,6 +1097,9 @@ namespace PluginHost {
             Condition _termination;
             uint32_t _activity;
             RPC::IRemoteConnection* _connection;
+            uint64_t _activationStart;
+            uint64_t _activationEnd;
+            Metrics _metrics;
 
             ServiceMap& _administrator;
             static Core::ProxyType<Web::Response> _unavailableHandler;
@@ -1087,6 +1192,7 @@ namespace PluginHost {
                     const string& appPath,
                     const string& proxyStubPath,
                     const string& postMortemPath,
+                    const bool zygote,
                     const Core::ProxyType<RPC::InvokeServer>& handler)
                     : RPC::Communicator(node, proxyStubPath.empty() == false ? Core::Directory::Normalize(proxyStubPath) : proxyStubPath, Core::ProxyType<Core::IIPCServer>(handler))
                     , _parent(parent)
@@ -1102,6 +1208,8 @@ namespace PluginHost {
 #else
                     , _application(EXPAND_AND_QUOTE(HOSTING_COMPROCESS))
 #endif
+                    , _zygotePath()
+                    , _zygote(false)
                     , _adminLock()
                 {
                     // Make sure the engine knows how to call the Announcment handler..
@@ -1113,16 +1221,47 @@ namespace PluginHost {
                         // We need to pass the communication channel NodeId via an environment variable, for process,
                         // not being started by the rpcprocess...
                         Core::SystemInfo::SetEnvironment(string(CommunicatorConnector), RPC::Communicator::Connector());
+
+#ifndef __WINDOWS__
+                        if ((zygote == true) && (_volatilePath.empty() == true)) {
+                            SYSLOG(Logging::Startup, (_T("The zygote needs a volatile path for its socket, plugins are launched with fork/exec.")));
+                        } else if (zygote == true) {
+                            // A host process that has everything loaded already and only needs to fork
+                            // for every out-of-process plugin. Until it listens, we fall back to fork/exec.
+                            // The zygote only listens if the directory of its socket is private to us.
+                            uint32_t id;
+                            string socketPath(_volatilePath + _T("zygote/socket"));
+                            Core::Process::Options options(_application);
+
+                            options.Add(_T("-z")).Add(socketPath);
+                            if (_proxyStubPath.empty() == false) {
+                                options.Add(_T("-m")).Add('"' + _proxyStubPath + '"');
+                            }
+
+                            if (_zygote.Launch(options, &id) == Core::ERROR_NONE) {
+                                _zygotePath = socketPath;
+                            } else {
+                                SYSLOG(Logging::Startup, (_T("Could not launch the zygote, plugins are launched with fork/exec.")));
+                            }
+                        }
+#endif
                     }
                 }
                 virtual ~CommunicatorServer()
                 {
+                    if (_zygotePath.empty() == false) {
+                        _zygote.Kill(false);
+                        if (_zygote.WaitProcessCompleted(1000) != Core::ERROR_NONE) {
+                            _zygote.Kill(true);
+                        }
+                        Core::File(_zygotePath).Destroy();
+                    }
                 }
 
             public:
                 void* Create(uint32_t& connectionId, const RPC::Object& instance, const string& classname, const string& callsign, const uint32_t waitTime, const string& dataPath, const string& persistentPath, const string& volatilePath)
                 {
-                    return (RPC::Communicator::Create(connectionId, instance, RPC::Config(RPC::Communicator::Connector(), _application, persistentPath, _systemPath, dataPath, volatilePath, _appPath, _proxyStubPath, _postMortemPath), waitTime));
+                    return (RPC::Communicator::Create(connectionId, instance, RPC::Config(RPC::Communicator::Connector(), _application, persistentPath, _systemPath, dataPath, volatilePath, _appPath, _proxyStubPath, _postMortemPath, _zygotePath), waitTime));
                 }
                 const string& PersistentPath() const
                 {
@@ -1156,6 +1295,10 @@ namespace PluginHost {
                 {
                     return (_application);
                 }
+                const string& Zygote() const
+                {
+                    return (_zygotePath);
+                }
 
             private:
                 RPC::Communicator::RemoteConnection* CreateStarter(const RPC::Config& config, const RPC::Object& instance) override
@@ -1186,6 +1329,8 @@ namespace PluginHost {
                 const string _proxyStubPath;
                 const string _postMortemPath;
                 const string _application;
+                string _zygotePath;
+                Core::Process _zygote;
                 mutable Core::CriticalSection _adminLock;
             };
             class RemoteInstantiation : public IRemoteInstantiation {
@@ -1254,7 +1399,7 @@ namespace PluginHost {
                     }
 
                     uint32_t id;
-                    RPC::Config config(_connector, _comms.Application(), persistentPath, _comms.SystemPath(), dataPath, volatilePath, _comms.AppPath(), _comms.ProxyStubPath(), _comms.PostMortemPath());
+                    RPC::Config config(_connector, _comms.Application(), persistentPath, _comms.SystemPath(), dataPath, volatilePath, _comms.AppPath(), _comms.ProxyStubPath(), _comms.PostMortemPath(), _comms.Zygote());
                     RPC::Object instance(libraryName, className, callsign, interfaceId, version, user, group, threads, priority, RPC::Object::HostType::LOCAL, _T(""), configuration);
 
                     RPC::Process process(requestId, config, instance);
@@ -1549,6 +1694,7 @@ namespace PluginHost {
                     config.AppPath(), 
                     config.ProxyStubPath(), 
                     config.PostMortemPath(), 
+                    config.Zygote(),
                     _engine)
                 , _server(server)
                 , _subSystems(this)
@@ -1802,6 +1948,25 @@ namespace PluginHost {
                     duplicates.pop_front();
                 }
             }
+            void GetMetrics(Core::JSON::ArrayType<MetaData::Metrics>& metaData) const
+            {
+                _adminLock.Lock();
+
+                std::list<Core::ProxyType<Service>> duplicates;
+                std::map<const string, Core::ProxyType<Service>>::const_iterator index(_services.begin());
+
+                while (index != _services.end()) {
+                    duplicates.push_back(index->second);
+                    index++;
+                }
+
+                _adminLock.Unlock();
+
+                while (duplicates.size() > 0) {
+                    duplicates.front()->GetMetrics(metaData.Add());
+                    duplicates.pop_front();
+                }
+            }
             uint32_t FromIdentifier(const string& callSign, Core::ProxyType<Service>& service)
             {
                 uint32_t result = Core::ERROR_UNAVAILABLE;
@@ -2766,6 +2931,88 @@ namespace PluginHost {
             Core::ProxyType<Core::IDispatchType<void>> _job;
         };
 
+        // Activates the autostart plugins. A plugin is activated once all plugins it depends on are
+        // done, independent plugins are activated concurrently on the worker pool.
+        class Activator {
+        private:
+            Activator() = delete;
+            Activator(const Activator&) = delete;
+            Activator& operator=(const Activator&) = delete;
+
+            class Job : public Core::IDispatch {
+            private:
+                Job() = delete;
+                Job(const Job&) = delete;
+                Job& operator=(const Job&) = delete;
+
+            public:
+                Job(Activator& parent, const Core::ProxyType<Service>& service)
+                    : _parent(parent)
+                    , _service(service)
+                {
+                }
+                ~Job() override
+                {
+                }
+
+            public:
+                void Dispatch() override
+                {
+                    _parent.Activate(_service);
+                }
+
+            private:
+                Activator& _parent;
+                Core::ProxyType<Service> _service;
+            };
+
+            struct Entry {
+                Core::ProxyType<Service> Plugin;
+                uint32_t Pending;
+                bool Started;
+                bool Blocked;
+                std::list<string> Dependents;
+            };
+
+        public:
+            Activator(Core::WorkerPool& workerPool, const uint8_t concurrency)
+                : _adminLock()
+                , _workerPool(workerPool)
+                , _concurrency(concurrency)
+                , _order()
+                , _entries()
+                , _ready()
+                , _running(0)
+                , _remaining(0)
+                , _done(false, true)
+            {
+            }
+            ~Activator()
+            {
+            }
+
+        public:
+            void Add(const Core::ProxyType<Service>& service);
+            void Run();
+
+        private:
+            void Activate(const Core::ProxyType<Service>& service);
+            void Release(const string& callsign, const bool available);
+            Entry* Next();
+            void Schedule();
+
+        private:
+            Core::CriticalSection _adminLock;
+            Core::WorkerPool& _workerPool;
+            const uint8_t _concurrency;
+            std::list<string> _order;
+            std::map<string, Entry> _entries;
+            std::list<string> _ready;
+            uint32_t _running;
+            uint32_t _remaining;
+            Core::Event _done;
+        };
+
     public:
         Server(Config& configuration, const bool background);
         virtual ~Server();
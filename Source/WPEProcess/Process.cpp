@@ -7,6 +7,10 @@
 #include <client/linux/handler/exception_handler.h>
 #endif
 
+#ifndef __WINDOWS__
+#include <sys/syscall.h>
+#endif
+
 MODULE_NAME_DECLARATION(BUILD_REFERENCE)
 
 namespace WPEFramework {
@@ -131,7 +135,7 @@ namespace Process {
     class ConsoleOptions : public Core::Options {
     public:
         ConsoleOptions(int argumentCount, TCHAR* arguments[])
-            : Core::Options(argumentCount, arguments, _T("h:l:c:r:p:s:d:a:m:i:u:g:t:e:x:V:v:P:"))
+            : Core::Options(argumentCount, arguments, _T("h:l:c:r:p:s:d:a:m:i:u:g:t:e:x:V:v:P:z:"))
             , Locator(nullptr)
             , ClassName(nullptr)
             , RemoteChannel(nullptr)
@@ -149,6 +153,7 @@ namespace Process {
             , Group(nullptr)
             , Threads(1)
             , EnabledLoggings(0)
+            , Zygote(nullptr)
         {
             Parse();
         }
@@ -174,6 +179,7 @@ namespace Process {
         const TCHAR* Group;
         uint8_t Threads;
         uint32_t EnabledLoggings;
+        const TCHAR* Zygote;
 
     private:
         string Strip(const TCHAR text[]) const
@@ -242,6 +248,9 @@ namespace Process {
             case 't':
                 Threads = Core::NumberType<uint8_t>(Core::TextFragment(argument)).Value();
                 break;
+            case 'z':
+                Zygote = argument;
+                break;
             case 'h':
             default:
                 RequestUsage(true);
@@ -250,6 +259,291 @@ namespace Process {
         }
     };
 
+#ifndef __WINDOWS__
+    // The zygote loads what every hosted plugin needs once and then waits, without running any
+    // threads, for requests to fork. The forked process continues as if it was started with the
+    // command line and environment that came with the request.
+    class Zygote {
+    private:
+        static constexpr uint32_t MaxRequestSize = 256 * 1024;
+
+    public:
+        Zygote() = delete;
+        Zygote(const Zygote&) = delete;
+        Zygote& operator=(const Zygote&) = delete;
+
+        Zygote(const string& socketPath, const string& proxyStubPath)
+            : _socketPath(socketPath)
+            , _listener(-1)
+            , _proxyStubs()
+        {
+            if (proxyStubPath.empty() == false) {
+                Core::Directory index(proxyStubPath.c_str(), _T("*.so"));
+
+                while (index.Next() == true) {
+                    Core::Library library(index.Current().c_str());
+
+                    if (library.IsLoaded() == true) {
+                        _proxyStubs.push_back(library);
+                    }
+                }
+            }
+
+            // Whoever can connect can have a process started with a command line of its choice, so
+            // the socket lives in a directory that is ours alone, and is only accessible to us.
+            const string::size_type slash = _socketPath.find_last_of('/');
+
+            if ((slash == string::npos) || (IsPrivate(_socketPath.substr(0, slash)) == false)) {
+                TRACE_L1("Zygote socket %s is not in a private directory", _socketPath.c_str());
+            } else {
+                struct sockaddr_un address;
+
+                ::memset(&address, 0, sizeof(address));
+                address.sun_family = AF_UNIX;
+                ::strncpy(address.sun_path, _socketPath.c_str(), sizeof(address.sun_path) - 1);
+                ::unlink(_socketPath.c_str());
+
+                _listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+                if ((_listener != -1) && ((::bind(_listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) || (::chmod(_socketPath.c_str(), S_IRUSR | S_IWUSR) != 0) || (::listen(_listener, 8) != 0))) {
+                    TRACE_L1("Zygote could not listen on %s, error (%d)", _socketPath.c_str(), errno);
+                    ::close(_listener);
+                    _listener = -1;
+                }
+            }
+
+            // Children are reaped here, but never before their pidfd is taken, see Wait().
+            struct sigaction action;
+
+            ::memset(&action, 0, sizeof(action));
+            action.sa_handler = Reap;
+            action.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+            ::sigaction(SIGCHLD, &action, nullptr);
+        }
+        ~Zygote()
+        {
+            if (_listener != -1) {
+                ::close(_listener);
+                ::unlink(_socketPath.c_str());
+            }
+        }
+
+    public:
+        inline bool IsValid() const
+        {
+            return (_listener != -1);
+        }
+
+        // Returns in the forked process only, with the arguments it should run with.
+        bool Wait(std::vector<string>& arguments)
+        {
+            bool forked = false;
+            bool running = true;
+
+            while ((forked == false) && (running == true)) {
+                int client = ::accept(_listener, nullptr, nullptr);
+
+                if (client == -1) {
+                    switch (errno) {
+                    case EINTR:
+                    case ECONNABORTED:
+                    case EPROTO:
+                        // That request is gone, the next one is welcome.
+                        break;
+                    case EMFILE:
+                    case ENFILE:
+                    case ENOBUFS:
+                    case ENOMEM:
+                        // Out of resources for now, give the system some time to free them.
+                        ::SleepMs(100);
+                        break;
+                    default:
+                        // Plugins are launched with fork/exec from now on.
+                        SYSLOG(Logging::Shutdown, (_T("Zygote stops listening on %s, error (%d)"), _socketPath.c_str(), errno));
+                        running = false;
+                        break;
+                    }
+                } else if (IsOwner(client) == false) {
+                    TRACE_L1("Zygote refused a request from another user");
+                    ::close(client);
+                } else {
+                    struct timeval timeout = { 2, 0 };
+                    std::vector<string> environment;
+                    uint32_t pid = 0;
+                    int descriptor = -1;
+
+                    ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+                    arguments.clear();
+
+                    if (Receive(client, arguments, environment) == true) {
+                        sigset_t reaping;
+
+                        // Until the pidfd is taken, the child may not be reaped, or its pid could be reused.
+                        ::sigemptyset(&reaping);
+                        ::sigaddset(&reaping, SIGCHLD);
+                        ::sigprocmask(SIG_BLOCK, &reaping, nullptr);
+
+                        pid_t child = ::fork();
+
+                        if (child == 0) {
+                            struct timeval forever = { 0, 0 };
+                            char go = 0;
+
+                            ::close(_listener);
+                            _listener = -1;
+                            ::signal(SIGCHLD, SIG_DFL);
+                            ::sigprocmask(SIG_UNBLOCK, &reaping, nullptr);
+                            ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &forever, sizeof(forever));
+
+                            // Only run once the requester has the pid. If it gave up waiting for
+                            // it, it launches the process itself, so this one should not exist.
+                            if (::recv(client, &go, sizeof(go), MSG_WAITALL) != sizeof(go)) {
+                                ::_exit(0);
+                            }
+
+                            ::clearenv();
+                            for (const string& variable : environment) {
+                                size_t position = variable.find('=');
+                                if (position != string::npos) {
+                                    ::setenv(variable.substr(0, position).c_str(), variable.substr(position + 1).c_str(), 1);
+                                }
+                            }
+
+                            forked = true;
+                        } else {
+                            if (child > 0) {
+                                pid = static_cast<uint32_t>(child);
+                                descriptor = Descriptor(child);
+                            }
+
+                            ::sigprocmask(SIG_UNBLOCK, &reaping, nullptr);
+                        }
+                    }
+
+                    if (forked == false) {
+                        Send(client, pid, descriptor);
+
+                        if (descriptor != -1) {
+                            ::close(descriptor);
+                        }
+                    }
+
+                    ::close(client);
+                }
+            }
+
+            return (forked);
+        }
+
+    private:
+        static void Reap(int)
+        {
+            const int error = errno;
+
+            while (::waitpid(-1, nullptr, WNOHANG) > 0) {
+            }
+
+            errno = error;
+        }
+        static int Descriptor(const pid_t child)
+        {
+#ifdef SYS_pidfd_open
+            return (static_cast<int>(::syscall(SYS_pidfd_open, child, 0)));
+#else
+            return (-1);
+#endif
+        }
+        // The pid goes out with its pidfd, if there is one, so the requester can signal the
+        // process without ever hitting another one that got the same pid later on.
+        static void Send(const int client, uint32_t pid, const int descriptor)
+        {
+            struct iovec data = { &pid, sizeof(pid) };
+            struct msghdr message;
+            union {
+                struct cmsghdr header;
+                char buffer[CMSG_SPACE(sizeof(int))];
+            } control;
+
+            ::memset(&message, 0, sizeof(message));
+            message.msg_iov = &data;
+            message.msg_iovlen = 1;
+
+            if (descriptor != -1) {
+                ::memset(&control, 0, sizeof(control));
+                message.msg_control = control.buffer;
+                message.msg_controllen = sizeof(control.buffer);
+
+                struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+                header->cmsg_level = SOL_SOCKET;
+                header->cmsg_type = SCM_RIGHTS;
+                header->cmsg_len = CMSG_LEN(sizeof(int));
+                ::memcpy(CMSG_DATA(header), &descriptor, sizeof(int));
+            }
+
+            ::sendmsg(client, &message, MSG_NOSIGNAL);
+        }
+        static bool IsPrivate(const string& directory)
+        {
+            bool result = false;
+            struct stat info;
+
+            if ((::lstat(directory.c_str(), &info) != 0) && (errno == ENOENT)) {
+                ::mkdir(directory.c_str(), S_IRWXU);
+            }
+
+            // A symbolic link, or a directory of someone else, or one others can look into, will not do.
+            if (::lstat(directory.c_str(), &info) == 0) {
+                result = ((S_ISDIR(info.st_mode)) && (info.st_uid == ::geteuid()) && ((info.st_mode & (S_IRWXG | S_IRWXO)) == 0));
+            }
+
+            return (result);
+        }
+        static bool IsOwner(const int client)
+        {
+            struct ucred credentials;
+            socklen_t length = sizeof(credentials);
+
+            return ((::getsockopt(client, SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0) && (credentials.uid == ::geteuid()));
+        }
+        bool Receive(const int client, std::vector<string>& arguments, std::vector<string>& environment) const
+        {
+            bool result = false;
+            uint32_t length = 0;
+
+            if ((::recv(client, &length, sizeof(length), MSG_WAITALL) == sizeof(length)) && (length > 0) && (length <= MaxRequestSize)) {
+                std::vector<char> request(length);
+
+                if (::recv(client, request.data(), length, MSG_WAITALL) == static_cast<ssize_t>(length)) {
+                    std::vector<string>* target = &arguments;
+                    uint32_t start = 0;
+
+                    // Arguments and environment are separated by an empty string.
+                    for (uint32_t index = 0; index < length; index++) {
+                        if (request[index] == '\0') {
+                            if ((index == start) && (target == &arguments)) {
+                                target = &environment;
+                            } else {
+                                target->emplace_back(&(request[start]), index - start);
+                            }
+                            start = index + 1;
+                        }
+                    }
+
+                    result = (arguments.empty() == false);
+                }
+            }
+
+            return (result);
+        }
+
+    private:
+        string _socketPath;
+        int _listener;
+        std::list<Core::Library> _proxyStubs;
+    };
+#endif
+
     static void* CheckInstance(const string& path, const TCHAR locator[], const TCHAR className[], const uint32_t ID, const uint32_t version)
     {
         void* result = nullptr;
@@ -495,19 +789,34 @@ private:
 
 using namespace WPEFramework;
 
-#ifdef __WINDOWS__
-int _tmain(int argc, _TCHAR* argv[])
-#else
-int main(int argc, char** argv)
-#endif
+static int Run(int argc, TCHAR* argv[])
 {
-    // Give the debugger time to attach to this process..
-    // printf("Starting to sleep so you can attach a debugger\n");
-    // Sleep(20000);
-    // printf("Continueing, I hope you have attached the debugger\n");
-
     Process::ConsoleOptions options(argc, argv);
 
+#ifndef __WINDOWS__
+    if ((options.RequestUsage() == false) && (options.Zygote != nullptr)) {
+        // Only a forked process returns from the Wait, the zygote itself stays there until it is killed.
+        Process::Zygote zygote(options.Zygote, options.ProxyStubPath);
+        std::vector<string> arguments;
+
+        if ((zygote.IsValid() == true) && (zygote.Wait(arguments) == true)) {
+            std::vector<TCHAR*> parameters;
+
+            for (string& argument : arguments) {
+                parameters.push_back(&(argument[0]));
+            }
+            parameters.push_back(nullptr);
+
+            // Start parsing the command line of the forked process from scratch.
+            optind = 0;
+
+            return (Run(static_cast<int>(arguments.size()), parameters.data()));
+        }
+
+        return (0);
+    }
+#endif
+
     if ((options.RequestUsage() == true) || (options.Locator == nullptr) || (options.ClassName == nullptr) || (options.RemoteChannel == nullptr) || (options.Exchange == 0)) {
         printf("Process [-h] \n");
         printf("         -l <locator>\n");
@@ -526,7 +835,8 @@ int main(int argc, char** argv)
         printf("        [-a <app path>]\n");
         printf("        [-m <proxy stub library path>]\n");
         printf("        [-e <enabled SYSLOG categories>]\n");
-        printf("        [-P <post mortem path>]\n\n");
+        printf("        [-P <post mortem path>]\n");
+        printf("        [-z <zygote socket>]\n\n");
         printf("This application spawns a seperate process space for a plugin. The plugins");
         printf("are searched in the same order as they are done in process. Starting from:\n");
         printf(" 1) <persistent path>/<locator>\n");
@@ -536,6 +846,8 @@ int main(int argc, char** argv)
         printf("Within the DSO, the system looks for an object with <classname>, this object must implement ");
         printf("the interface, indicated byt the Id <interfaceId>, and if passed, the object should be of ");
         printf("version <version>. All these conditions must met for an object to be instantiated and thus run.\n\n");
+        printf("With a <zygote socket>, the proxy stubs are loaded once and a process is forked for every command line ");
+        printf("received on that socket.\n\n");
 
         for (uint8_t teller = 0; teller < argc; teller++) {
             printf("Argument [%02d]: %s\n", teller, argv[teller]);
@@ -594,3 +906,17 @@ int main(int argc, char** argv)
     TRACE_L1("End of Process!!!!");
     return 0;
 }
+
+#ifdef __WINDOWS__
+int _tmain(int argc, _TCHAR* argv[])
+#else
+int main(int argc, char** argv)
+#endif
+{
+    // Give the debugger time to attach to this process..
+    // printf("Starting to sleep so you can attach a debugger\n");
+    // Sleep(20000);
+    // printf("Continueing, I hope you have attached the debugger\n");
+
+    return (Run(argc, argv));
+}
@@ -0,0 +1,387 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Demux.h"
+#include "ProgramTable.h"
+
+namespace WPEFramework {
+
+namespace Broadcast {
+
+    uint16_t Demux::Assembler::Append(const uint8_t data[], const uint16_t length)
+    {
+        uint16_t taken = 0;
+
+        if (_buffer.empty() == true) {
+            _buffer.resize(MaxSectionSize);
+        }
+
+        if (_filled < 3) {
+            // table_id and section_length first, than we know how much to expect.
+            while ((_filled < 3) && (taken < length)) {
+                _buffer[_filled++] = data[taken++];
+            }
+
+            if (_filled == 3) {
+                _length = 3 + (((_buffer[1] & 0x0F) << 8) | _buffer[2]);
+
+                if (_length > MaxSectionSize) {
+                    TRACE_L1("Section of %d bytes exceeds the maximum, dropped.", _length);
+                    Drop();
+                    taken = length;
+                }
+            }
+        }
+
+        if ((_length != 0) && (taken < length)) {
+            const uint16_t size = std::min(static_cast<uint16_t>(_length - _filled), static_cast<uint16_t>(length - taken));
+
+            ::memcpy(&(_buffer[_filled]), &(data[taken]), size);
+            _filled += size;
+            taken += size;
+        }
+
+        return (taken);
+    }
+
+    Demux::Demux(const bool repetitions)
+        : _adminLock()
+        , _repetitions(repetitions)
+        , _assemblers()
+        , _versions()
+        , _dispatch()
+        , _changes()
+        , _observer(nullptr)
+        , _partialLength(0)
+        , _packets(0)
+        , _sections(0)
+        , _errors(0)
+    {
+    }
+
+    /* virtual */ Demux::~Demux()
+    {
+        if (_observer != nullptr) {
+            ProgramTable::Instance().Unregister(this);
+            _observer = nullptr;
+        }
+    }
+
+    uint32_t Demux::Filter(const uint16_t pid, const uint8_t tableId, ISection* callback)
+    {
+        _adminLock.Lock();
+
+        if (callback != nullptr) {
+            std::vector<Subscriber>& subscribers(_assemblers[pid].Subscribers());
+            std::vector<Subscriber>::const_iterator index(subscribers.begin());
+
+            while ((index != subscribers.end()) && ((index->TableId != tableId) || (index->Callback != callback))) {
+                index++;
+            }
+
+            if (index == subscribers.end()) {
+                subscribers.push_back({ tableId, callback });
+
+                // A new subscriber should see every section, also the ones we have seen before.
+                _versions.Clear();
+            }
+        } else {
+            Assemblers::iterator entry(_assemblers.find(pid));
+
+            if (entry != _assemblers.end()) {
+                std::vector<Subscriber>& subscribers(entry->second.Subscribers());
+                std::vector<Subscriber>::iterator index(subscribers.begin());
+
+                while (index != subscribers.end()) {
+                    if (index->TableId == tableId) {
+                        index = subscribers.erase(index);
+                    } else {
+                        index++;
+                    }
+                }
+
+                if (entry->second.IsActive() == false) {
+                    entry->second.Drop();
+                    entry->second.Continuity(~0);
+                }
+            }
+        }
+
+        _adminLock.Unlock();
+
+        return (Core::ERROR_NONE);
+    }
+
+    uint32_t Demux::Programs(const uint16_t keyId)
+    {
+        uint32_t result = Core::ERROR_INPROGRESS;
+
+        _adminLock.Lock();
+
+        if (_observer == nullptr) {
+            _observer = ProgramTable::Instance().Register(this, keyId);
+
+            Filter(0, MPEG::PAT::ID, _observer);
+
+            result = Core::ERROR_NONE;
+        }
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    void Demux::Process(const uint8_t data[], const uint32_t length)
+    {
+        uint32_t offset = 0;
+
+        _adminLock.Lock();
+
+        if (_partialLength != 0) {
+            // Complete the packet that was split over the previous and this call.
+            const uint32_t size = std::min(static_cast<uint32_t>(PacketSize - _partialLength), length);
+
+            ::memcpy(&(_partial[_partialLength]), data, size);
+            _partialLength += static_cast<uint8_t>(size);
+            offset = size;
+
+            if (_partialLength == PacketSize) {
+                Packet(_partial);
+                _partialLength = 0;
+            }
+        }
+
+        bool synchronized = true;
+
+        while ((offset + PacketSize) <= length) {
+            // Out of sync, a sync byte might as well be payload. Only trust it if the packet after it
+            // starts with one too, or if it is the last packet there is.
+            if ((data[offset] == SyncByte) && ((synchronized == true) || ((offset + PacketSize) == length) || (data[offset + PacketSize] == SyncByte))) {
+                Packet(&(data[offset]));
+                offset += PacketSize;
+                synchronized = true;
+            } else {
+                if (synchronized == true) {
+                    TRACE_L1("Lost sync at offset %d, looking for the next packet.", offset);
+                    _errors++;
+                    synchronized = false;
+                }
+                offset++;
+            }
+        }
+
+        if (offset < length) {
+            // Keep the start of the last packet, the rest of it comes with the next call.
+            while ((offset < length) && (data[offset] != SyncByte)) {
+                offset++;
+            }
+
+            _partialLength = static_cast<uint8_t>(length - offset);
+
+            if (_partialLength != 0) {
+                ::memcpy(_partial, &(data[offset]), _partialLength);
+            }
+        }
+
+        _adminLock.Unlock();
+    }
+
+    uint32_t Demux::Process(const string& fileName)
+    {
+        uint32_t result = Core::ERROR_UNAVAILABLE;
+        Core::File file(fileName);
+
+        if (file.Open(true) == true) {
+            uint8_t buffer[PacketSize * 64];
+            uint32_t loaded;
+
+            while ((loaded = file.Read(buffer, sizeof(buffer))) != 0) {
+                Process(buffer, loaded);
+            }
+
+            file.Close();
+
+            result = Core::ERROR_NONE;
+        }
+
+        return (result);
+    }
+
+    void Demux::Reset()
+    {
+        _adminLock.Lock();
+
+        for (std::pair<const uint16_t, Assembler>& entry : _assemblers) {
+            entry.second.Drop();
+            entry.second.Continuity(~0);
+        }
+
+        _versions.Clear();
+        _partialLength = 0;
+        _packets = 0;
+        _sections = 0;
+        _errors = 0;
+
+        _adminLock.Unlock();
+    }
+
+    /* virtual */ void Demux::ChangePid(const uint16_t newpid, ISection* observer)
+    {
+        // Called by the ProgramTable from within the section handling, the filters are
+        // changed once the section has been offered to all its subscribers.
+        _changes.emplace_back(observer, newpid);
+    }
+
+    void Demux::Packet(const uint8_t packet[])
+    {
+        _packets++;
+
+        if ((packet[1] & 0x80) != 0) {
+            // transport_error_indicator, the demodulator could not correct this one.
+            _errors++;
+        } else {
+            const uint16_t pid = ((packet[1] & 0x1F) << 8) | packet[2];
+            Assemblers::iterator entry(_assemblers.find(pid));
+
+            if ((entry != _assemblers.end()) && (entry->second.IsActive() == true) && ((packet[3] & 0x10) != 0)) {
+                Assembler& assembler(entry->second);
+                const uint8_t counter = (packet[3] & 0x0F);
+                uint16_t offset = 4;
+
+                if ((packet[3] & 0x20) != 0) {
+                    // Skip the adaptation field. A payload follows, so more than 182 bytes of it
+                    // would run off the packet.
+                    offset += 1 + packet[4];
+                }
+
+                if (offset >= PacketSize) {
+                    // Only the content is corrupt, keep counting so the next packet is no loss.
+                    _errors++;
+                    assembler.Drop();
+                    assembler.Continuity(counter);
+                } else if (counter != assembler.Continuity()) {
+                    // An equal counter is a duplicate packet, which carries nothing new.
+                    if ((assembler.Continuity() <= 0x0F) && (counter != ((assembler.Continuity() + 1) & 0x0F))) {
+                        _errors++;
+                        assembler.Drop();
+                    }
+
+                    assembler.Continuity(counter);
+
+                    Payload(pid, assembler, &(packet[offset]), PacketSize - offset, ((packet[1] & 0x40) != 0));
+                }
+            }
+        }
+    }
+
+    void Demux::Payload(const uint16_t pid, Assembler& assembler, const uint8_t data[], const uint8_t length, const bool start)
+    {
+        uint8_t offset = 0;
+
+        if (start == true) {
+            if ((1 + data[0]) > length) {
+                // pointer_field beyond the packet.
+                _errors++;
+                assembler.Drop();
+                offset = length;
+            } else {
+                offset = 1 + data[0];
+
+                if (assembler.IsAssembling() == true) {
+                    // The bytes up to the pointer complete the section we were working on.
+                    assembler.Append(&(data[1]), data[0]);
+
+                    if (assembler.IsComplete() == true) {
+                        Deliver(pid, assembler);
+                    } else {
+                        _errors++;
+                        assembler.Drop();
+                    }
+                }
+            }
+        } else if (assembler.IsAssembling() == false) {
+            // Nothing to continue, wait for the next section to start.
+            offset = length;
+        }
+
+        // Sections follow each other until the packet ends or is stuffed with 0xFF.
+        while ((offset < length) && ((assembler.IsAssembling() == true) || (data[offset] != 0xFF))) {
+            offset += static_cast<uint8_t>(assembler.Append(&(data[offset]), length - offset));
+
+            if (assembler.IsComplete() == true) {
+                Deliver(pid, assembler);
+            }
+        }
+    }
+
+    void Demux::Deliver(const uint16_t pid, Assembler& assembler)
+    {
+        MPEG::Section section(Core::DataElement(assembler.Length(), assembler.Data()));
+
+        if ((_repetitions == true) || (_versions.IsChanged(pid, section) == true)) {
+            if (section.IsValid() == false) {
+                _errors++;
+            } else {
+                if (_repetitions == false) {
+                    _versions.Update(pid, section);
+                }
+
+                _sections++;
+
+                // Subscribers may change the filters while handling the section.
+                _dispatch = assembler.Subscribers();
+
+                for (const Subscriber& subscriber : _dispatch) {
+                    if (subscriber.TableId == section.TableId()) {
+                        subscriber.Callback->Handle(section);
+                    }
+                }
+            }
+        }
+
+        assembler.Drop();
+
+        for (const std::pair<ISection*, uint16_t>& change : _changes) {
+            for (std::pair<const uint16_t, Assembler>& entry : _assemblers) {
+                std::vector<Subscriber>& subscribers(entry.second.Subscribers());
+                std::vector<Subscriber>::iterator index(subscribers.begin());
+
+                while (index != subscribers.end()) {
+                    if (index->Callback == change.first) {
+                        index = subscribers.erase(index);
+                    } else {
+                        index++;
+                    }
+                }
+            }
+
+            if (change.second != static_cast<uint16_t>(~0)) {
+                Filter(change.second, MPEG::PMT::ID, change.first);
+            } else if (change.first == _observer) {
+                // All PMTs are in, the ProgramTable is done with us.
+                ProgramTable::Instance().Unregister(this);
+                _observer = nullptr;
+            }
+        }
+
+        _changes.clear();
+    }
+
+} // namespace Broadcast
+} // namespace WPEFramework
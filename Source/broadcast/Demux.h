@@ -0,0 +1,174 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BROADCAST_DEMUX_H
+#define BROADCAST_DEMUX_H
+
+#include "Definitions.h"
+#include "MPEGSection.h"
+
+namespace WPEFramework {
+
+namespace Broadcast {
+
+    // User space demultiplexer for an MPEG transport stream coming from a file or memory, e.g.
+    // a capture. Sections are reassembled for all filtered PIDs in a single pass and offered on
+    // the ISection interface, just like the section filters of a tuner do.
+    class EXTERNAL Demux : public IMonitor {
+    private:
+        Demux(const Demux&) = delete;
+        Demux& operator=(const Demux&) = delete;
+
+        static constexpr uint8_t SyncByte = 0x47;
+        static constexpr uint8_t PacketSize = 188;
+        static constexpr uint16_t MaxSectionSize = 4096;
+
+        struct Subscriber {
+            uint8_t TableId;
+            ISection* Callback;
+        };
+
+        class Assembler {
+        private:
+            Assembler(const Assembler&) = delete;
+            Assembler& operator=(const Assembler&) = delete;
+
+        public:
+            Assembler()
+                : _buffer()
+                , _filled(0)
+                , _length(0)
+                , _continuity(~0)
+                , _subscribers()
+            {
+            }
+            ~Assembler()
+            {
+            }
+
+        public:
+            inline bool IsActive() const
+            {
+                return (_subscribers.empty() == false);
+            }
+            inline bool IsAssembling() const
+            {
+                return (_filled != 0);
+            }
+            inline std::vector<Subscriber>& Subscribers()
+            {
+                return (_subscribers);
+            }
+            inline uint8_t Continuity() const
+            {
+                return (_continuity);
+            }
+            inline void Continuity(const uint8_t counter)
+            {
+                _continuity = counter;
+            }
+            inline void Drop()
+            {
+                _filled = 0;
+                _length = 0;
+            }
+            inline uint8_t* Data()
+            {
+                return (_buffer.data());
+            }
+            inline uint16_t Length() const
+            {
+                return (_length);
+            }
+            inline bool IsComplete() const
+            {
+                return ((_length != 0) && (_filled == _length));
+            }
+            // Returns the number of bytes taken, all of them if the section turns out to be corrupt.
+            uint16_t Append(const uint8_t data[], const uint16_t length);
+
+        private:
+            std::vector<uint8_t> _buffer;
+            uint16_t _filled;
+            uint16_t _length;
+            uint8_t _continuity;
+            std::vector<Subscriber> _subscribers;
+        };
+
+        typedef std::unordered_map<uint16_t, Assembler> Assemblers;
+
+    public:
+        // Without repetitions, sections of which this version was already offered are skipped.
+        Demux(const bool repetitions = false);
+        ~Demux() override;
+
+    public:
+        // Same contract as ITuner::Filter: receive the sections of this table on this PID, a
+        // nullptr callback removes the filter.
+        uint32_t Filter(const uint16_t pid, const uint8_t tableId, ISection* callback);
+
+        // Follow the PAT and the PMTs it references into the ProgramTable, under this key.
+        uint32_t Programs(const uint16_t keyId);
+
+        // Feed transport stream data, packets may be split over calls.
+        void Process(const uint8_t data[], const uint32_t length);
+        uint32_t Process(const string& fileName);
+
+        void Reset();
+
+        inline uint32_t Packets() const
+        {
+            return (_packets);
+        }
+        inline uint32_t Sections() const
+        {
+            return (_sections);
+        }
+        // Packets lost or corrupted, and sections dropped because of a bad CRC.
+        inline uint32_t Errors() const
+        {
+            return (_errors);
+        }
+
+    private:
+        void ChangePid(const uint16_t newpid, ISection* observer) override;
+
+        void Packet(const uint8_t packet[]);
+        void Payload(const uint16_t pid, Assembler& assembler, const uint8_t data[], const uint8_t length, const bool start);
+        void Deliver(const uint16_t pid, Assembler& assembler);
+
+    private:
+        Core::CriticalSection _adminLock;
+        const bool _repetitions;
+        Assemblers _assemblers;
+        MPEG::SectionVersions _versions;
+        std::vector<Subscriber> _dispatch;
+        std::vector<std::pair<ISection*, uint16_t>> _changes;
+        ISection* _observer;
+        uint8_t _partial[PacketSize];
+        uint8_t _partialLength;
+        uint32_t _packets;
+        uint32_t _sections;
+        uint32_t _errors;
+    };
+
+} // namespace Broadcast
+} // namespace WPEFramework
+
+#endif // BROADCAST_DEMUX_H
@@ -450,6 +450,8 @@ namespace Broadcast {
                 : _adminLock()
                 , _pidChannel(nullptr)
                 , _messages(nullptr)
+                , _pid(~0)
+                , _versions()
                 , _callback(nullptr)
             {
                 NEXUS_MessageSettings openSettings;
@@ -492,7 +494,11 @@ namespace Broadcast {
                             startSettings.filter.mask[0] = 0x0;
                             // startSettings.filter.exclusion[0] = 0x0;
                         }
+                        _adminLock.Lock();
                         _callback = callback;
+                        _pid = pid;
+                        _versions.Clear();
+                        _adminLock.Unlock();
                         NEXUS_Error rc = NEXUS_Message_Start(_messages, &startSettings);
                         if (rc != 0) {
                             NEXUS_PidChannel_Close(_pidChannel);
@@ -543,8 +549,15 @@ namespace Broadcast {
                         // Looks like the sections are rounded to 32 bits boundaries.
                         size_t sectionLength = ((newSection.Length() + 3) & (static_cast<size_t>(~0) ^ 0x03));
 
-                        if (newSection.IsValid() == true) {
+                        _adminLock.Lock();
+                        bool changed = _versions.IsChanged(_pid, newSection);
+                        _adminLock.Unlock();
+
+                        if (changed == false) {
+                            // A repetition of a section we already passed on, nothing new to parse.
+                        } else if (newSection.IsValid() == true) {
                             _adminLock.Lock();
+                            _versions.Update(_pid, newSection);
                             if (_callback != nullptr) {
                                 _callback->Handle(newSection);
                             }
@@ -565,6 +578,8 @@ namespace Broadcast {
             Core::CriticalSection _adminLock;
             NEXUS_PidChannelHandle _pidChannel;
             NEXUS_MessageHandle _messages;
+            uint16_t _pid;
+            MPEG::SectionVersions _versions;
             ISection* _callback;
         };
 
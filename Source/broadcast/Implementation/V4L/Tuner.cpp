@@ -230,6 +230,8 @@ static constexpr conversion_entry _tableRollOff[] = {
                 , _length(0)
                 , _size(1024)
                 , _buffer(reinterpret_cast<uint8_t*>(::malloc(_size)))
+                , _pid(pid)
+                , _versions()
                 , _callback(callback) {
 
                 char deviceName[32];
@@ -295,7 +297,12 @@ static constexpr conversion_entry _tableRollOff[] = {
                         _offset += loaded;
                         if ((_offset - 3) == _length) {
                             MPEG::Section newSection(Core::DataElement(_offset, _buffer));
-                            _callback->Handle(newSection);
+
+                            // Repeated sections with a known version carry nothing new, skip the parsing.
+                            if ((_versions.IsChanged(_pid, newSection) == true) && (newSection.IsValid() == true)) {
+                                _versions.Update(_pid, newSection);
+                                _callback->Handle(newSection);
+                            }
                             _offset = 0;
                         }
                     }
@@ -344,6 +351,8 @@ static constexpr conversion_entry _tableRollOff[] = {
             uint16_t _length;
             uint16_t _size;
             uint8_t* _buffer;
+            uint16_t _pid;
+            MPEG::SectionVersions _versions;
             ISection* _callback;
         };
 
@@ -62,7 +62,12 @@ namespace Broadcast {
         public:
             inline bool IsValid() const
             {
-                return ((_section.Size() >= Offset()) && (_section.Size() >= Length()) && (!HasSectionSyntax() || ValidCRC()));
+                return ((IsComplete() == true) && (!HasSectionSyntax() || ValidCRC()));
+            }
+            // All bytes announced in the header are there, says nothing about the CRC.
+            inline bool IsComplete() const
+            {
+                return ((_section.Size() >= Offset()) && (_section.Size() >= Length()));
             }
             inline uint8_t TableId() const { return (_section[0]); }
             inline bool HasSectionSyntax() const { return ((_section[1] & 0x80) != 0); }
@@ -124,6 +129,62 @@ namespace Broadcast {
             Core::DataElement _section;
         };
 
+        // Remembers the version of every (PID, table id, extension, section number) that was
+        // passed on. Tables are repeated all the time, sections whose version did not change
+        // are recognised on their header, before the CRC check and the parsing.
+        class EXTERNAL SectionVersions {
+        private:
+            SectionVersions(const SectionVersions&) = delete;
+            SectionVersions& operator=(const SectionVersions&) = delete;
+
+        public:
+            SectionVersions()
+                : _versions()
+            {
+            }
+            ~SectionVersions()
+            {
+            }
+
+        public:
+            // Sections without a version (e.g. TDT/TOT) are always changed.
+            bool IsChanged(const uint16_t pid, const Section& section) const
+            {
+                bool result = (section.IsComplete() == true);
+
+                if ((result == true) && (section.HasSectionSyntax() == true)) {
+                    std::unordered_map<uint64_t, uint8_t>::const_iterator index(_versions.find(Key(pid, section)));
+
+                    result = ((index == _versions.end()) || (index->second != section.Version()));
+                }
+
+                return (result);
+            }
+            // Only remember sections that passed the CRC check, the next copy might be intact.
+            void Update(const uint16_t pid, const Section& section)
+            {
+                ASSERT(section.IsValid() == true);
+
+                if (section.HasSectionSyntax() == true) {
+                    _versions[Key(pid, section)] = section.Version();
+                }
+            }
+            inline void Clear()
+            {
+                _versions.clear();
+            }
+
+        private:
+            static uint64_t Key(const uint16_t pid, const Section& section)
+            {
+                // PID(13)/CurNext(1)/TableId(8)/Extension(16)/SectionNumber(8)
+                return ((static_cast<uint64_t>(pid & 0x1FFF) << 33) | (static_cast<uint64_t>(section.IsCurrent() ? 1 : 0) << 32) | (static_cast<uint64_t>(section.TableId()) << 24) | (static_cast<uint64_t>(section.Extension()) << 8) | section.SectionNumber());
+            }
+
+        private:
+            std::unordered_map<uint64_t, uint8_t> _versions;
+        };
+
         class EXTERNAL Table {
         private:
             Table() = delete;
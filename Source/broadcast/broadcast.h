@@ -23,6 +23,7 @@
 #include "Module.h"
 
 #include "Definitions.h"
+#include "Demux.h"
 #include "Descriptors.h"
 #include "MPEGDescriptor.h"
 #include "MPEGSection.h"
@@ -0,0 +1,103 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <broadcast/broadcast.h>
+#include <core/core.h>
+
+using namespace WPEFramework;
+
+// Counts the sections offered per table, for PID/table combinations of interest.
+class Counter : public Broadcast::ISection {
+public:
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+    Counter(const TCHAR name[])
+        : _name(name)
+        , _sections(0)
+        , _bytes(0)
+    {
+    }
+    ~Counter() override
+    {
+    }
+
+public:
+    void Handle(const Broadcast::MPEG::Section& section) override
+    {
+        _sections++;
+        _bytes += section.Length();
+    }
+    void Print() const
+    {
+        printf("  %-4s %8d sections %10d bytes\n", _name, _sections, _bytes);
+    }
+
+private:
+    const TCHAR* _name;
+    uint32_t _sections;
+    uint32_t _bytes;
+};
+
+int main(int argc, const char* argv[])
+{
+    if (argc < 2) {
+        printf("Usage: %s <capture.ts> [-r]\n", argv[0]);
+        printf("  -r  offer repeated sections as well, not only new versions\n");
+        return 1;
+    }
+
+    const bool repetitions = ((argc > 2) && (strcmp(argv[2], "-r") == 0));
+
+    {
+        Broadcast::Demux demux(repetitions);
+        Counter nit(_T("NIT")), sdt(_T("SDT")), eitActual(_T("EIT")), eitOther(_T("EIT+")), tdt(_T("TDT"));
+
+        demux.Programs(1);
+        demux.Filter(0x10, Broadcast::DVB::NIT::ACTUAL, &nit);
+        demux.Filter(0x11, Broadcast::DVB::SDT::ACTUAL, &sdt);
+        // EIT present/following, actual (0x4E) and other (0x4F) transport stream.
+        demux.Filter(0x12, 0x4E, &eitActual);
+        demux.Filter(0x12, 0x4F, &eitOther);
+        demux.Filter(0x14, Broadcast::DVB::TDT::ID, &tdt);
+
+        const uint64_t start = Core::Time::Now().Ticks();
+        const uint32_t result = demux.Process(string(argv[1]));
+        const uint64_t duration = Core::Time::Now().Ticks() - start;
+
+        if (result != Core::ERROR_NONE) {
+            printf("Could not open %s\n", argv[1]);
+        } else {
+            const double megabytes = (static_cast<double>(demux.Packets()) * 188) / (1024 * 1024);
+
+            printf("%s: %d packets, %d sections, %d errors\n", argv[1], demux.Packets(), demux.Sections(), demux.Errors());
+            printf("Processed in %d ms, %.1f MB/s\n", static_cast<uint32_t>(duration / 1000), (duration != 0 ? (megabytes * 1000000) / duration : 0.0));
+
+            nit.Print();
+            sdt.Print();
+            eitActual.Print();
+            eitOther.Print();
+            tdt.Print();
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return 0;
+}
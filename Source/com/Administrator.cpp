@@ -23,17 +23,39 @@
 namespace WPEFramework {
 namespace RPC {
 
+    // All arenas live in here, a name outside of it that comes in over a channel is never opened.
+#ifdef __WINDOWS__
+    static const TCHAR ArenaPrefix[] = _T("c:/temp/comrpc.");
+#else
+    static const TCHAR ArenaPrefix[] = _T("/dev/shm/comrpc.");
+#endif
+
+    static bool IsArenaName(const string& name)
+    {
+        const string::size_type length = (sizeof(ArenaPrefix) / sizeof(TCHAR)) - 1;
+
+        return ((name.length() > length) && (name.compare(0, length, ArenaPrefix) == 0) && (name.find_first_of(_T("/\\"), length) == string::npos));
+    }
+
     Administrator::Administrator()
         : _adminLock()
         , _stubs()
         , _proxy()
+        , _index()
+        , _libraries()
         , _factory(8)
         , _channelProxyMap()
+        , _channelReferenceMap()
+        , _channelArenaMap()
+        , _arenaSequence(0)
     {
     }
 
     /* virtual */ Administrator::~Administrator()
     {
+        // Unloading these recalls their proxy/stubs, so do it while they are still registered.
+        _libraries.clear();
+
         for (std::pair<uint32_t, IMetadata*> proxy : _proxy) {
             delete proxy.second;
         }
@@ -52,11 +74,10 @@ namespace RPC {
 
     void Administrator::AddRef(Core::ProxyType<Core::IPCChannel>& channel, void* impl, const uint32_t interfaceId)
     {
-        // stub are loaded before any action is taken and destructed if the process closes down, so no need to lock..
-        std::map<uint32_t, ProxyStub::UnknownStub*>::iterator index(_stubs.find(interfaceId));
+        ProxyStub::UnknownStub* stub(Stub(interfaceId));
 
-        if (index != _stubs.end()) {
-            Core::IUnknown* implementation(index->second->Convert(impl));
+        if (stub != nullptr) {
+            Core::IUnknown* implementation(stub->Convert(impl));
 
             ASSERT(implementation != nullptr);
 
@@ -72,11 +93,10 @@ namespace RPC {
 
     void Administrator::Release(Core::ProxyType<Core::IPCChannel>& channel, void* impl, const uint32_t interfaceId, const uint32_t dropCount)
     {
-        // stub are loaded before any action is taken and destructed if the process closes down, so no need to lock..
-        std::map<uint32_t, ProxyStub::UnknownStub*>::iterator index(_stubs.find(interfaceId));
+        ProxyStub::UnknownStub* stub(Stub(interfaceId));
 
-        if (index != _stubs.end()) {
-            Core::IUnknown* implementation(index->second->Convert(impl));
+        if (stub != nullptr) {
+            Core::IUnknown* implementation(stub->Convert(impl));
 
             ASSERT(implementation != nullptr);
 
@@ -126,12 +146,11 @@ namespace RPC {
     {
         uint32_t interfaceId(message->Parameters().InterfaceId());
 
-        // stub are loaded before any action is taken and destructed if the process closes down, so no need to lock..
-        std::map<uint32_t, ProxyStub::UnknownStub*>::iterator index(_stubs.find(interfaceId));
+        ProxyStub::UnknownStub* stub(Stub(interfaceId));
 
-        if (index != _stubs.end()) {
+        if (stub != nullptr) {
             uint32_t methodId(message->Parameters().MethodId());
-            index->second->Handle(methodId, channel, message);
+            stub->Handle(methodId, channel, message);
         } else {
             // Oops this is an unknown interface, Do not think this could happen.
             TRACE_L1("Unknown interface. %d", interfaceId);
@@ -171,6 +190,9 @@ namespace RPC {
 
         if (impl) {
 
+            // Make sure the proxy is there, if it is in a library that has not been loaded yet.
+            Load(id);
+
             _adminLock.Lock();
 
             ChannelMap::iterator index(_channelProxyMap.find(channel.operator->()));
@@ -265,8 +287,73 @@ namespace RPC {
 
     Core::IUnknown* Administrator::Convert(void* rawImplementation, const uint32_t id) 
     {
-        std::map<uint32_t, ProxyStub::UnknownStub*>::const_iterator index (_stubs.find(id));
-        return(index != _stubs.end() ? index->second->Convert(rawImplementation) : nullptr);
+        ProxyStub::UnknownStub* stub(Stub(id));
+        return(stub != nullptr ? stub->Convert(rawImplementation) : nullptr);
+    }
+
+    // Stubs are only deleted if the library announcing them is unloaded, so they can be used unlocked.
+    ProxyStub::UnknownStub* Administrator::Stub(const uint32_t id)
+    {
+        ProxyStub::UnknownStub* result = nullptr;
+
+        do {
+            _adminLock.Lock();
+
+            std::map<uint32_t, ProxyStub::UnknownStub*>::const_iterator index(_stubs.find(id));
+
+            if (index != _stubs.end()) {
+                result = index->second;
+            }
+
+            _adminLock.Unlock();
+
+        } while ((result == nullptr) && (Load(id) == true));
+
+        return (result);
+    }
+
+    bool Administrator::Load(const uint32_t id)
+    {
+        string library;
+
+        _adminLock.Lock();
+
+        std::map<uint32_t, string>::const_iterator index(_index.find(id));
+
+        if (index != _index.end()) {
+            library = index->second;
+        }
+
+        _adminLock.Unlock();
+
+        if (library.empty() == false) {
+            // The library announces its proxy/stubs while it is loaded, that takes the _adminLock,
+            // so do not hold it here, the loader has a lock of its own.
+            Core::Library loaded(library.c_str());
+
+            _adminLock.Lock();
+
+            if (loaded.IsLoaded() == true) {
+                _libraries.push_back(loaded);
+            } else {
+                TRACE_L1("Failed to load proxy/stubs from %s for interface 0x%X.", library.c_str(), id);
+            }
+
+            // Whatever the outcome, there is no need to try this library again.
+            std::map<uint32_t, string>::iterator entry(_index.begin());
+
+            while (entry != _index.end()) {
+                if (entry->second == library) {
+                    entry = _index.erase(entry);
+                } else {
+                    entry++;
+                }
+            }
+
+            _adminLock.Unlock();
+        }
+
+        return (library.empty() == false);
     }
 
     void Administrator::DeleteChannel(const Core::ProxyType<Core::IPCChannel>& channel, std::list<ProxyStub::UnknownProxy*>& pendingProxies)
@@ -309,7 +396,185 @@ namespace RPC {
             }
         }
 
+        // Calls still in flight hold on to their arena, it is gone once they are done.
+        _channelArenaMap.erase(channel.operator->());
+
+        _adminLock.Unlock();
+    }
+
+    Core::ProxyType<Arena> Administrator::Outbound(const Core::ProxyType<Core::IPCChannel>& channel)
+    {
+        Core::ProxyType<Arena> result;
+
+        _adminLock.Lock();
+
+        ArenaSet& arenas(_channelArenaMap[channel.operator->()]);
+
+        if (arenas.Outbound.IsValid() == false) {
+            string name(ArenaPrefix);
+            name += Core::NumberType<uint32_t>(Core::ProcessInfo().Id()).Text() + '.' + Core::NumberType<uint32_t>(_arenaSequence++).Text();
+
+            arenas.Outbound = Core::ProxyType<Arena>::Create(name, static_cast<uint32_t>(ArenaSize));
+
+            if (arenas.Outbound->IsValid() == false) {
+                TRACE_L1("Could not create the COMRPC arena %s, @shared buffers go in the frame.", name.c_str());
+            }
+        }
+
+        result = arenas.Outbound;
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    Core::ProxyType<Arena> Administrator::Inbound(const Core::ProxyType<Core::IPCChannel>& channel, const string& name)
+    {
+        Core::ProxyType<Arena> result;
+
+        _adminLock.Lock();
+
+        ArenaMap::iterator index(_channelArenaMap.find(channel.operator->()));
+
+        if (name.empty() == true) {
+            if (index != _channelArenaMap.end()) {
+                result = index->second.Inbound;
+            }
+        } else if (IsArenaName(name) == false) {
+            TRACE_L1("Refused to open %s as a COMRPC arena.", name.c_str());
+        } else {
+            if (index == _channelArenaMap.end()) {
+                index = _channelArenaMap.emplace(channel.operator->(), ArenaSet()).first;
+            }
+            if ((index->second.Inbound.IsValid() == false) || (index->second.Inbound->Name() != name)) {
+                index->second.Inbound = Core::ProxyType<Arena>::Create(name);
+            }
+
+            result = index->second.Inbound;
+        }
+
         _adminLock.Unlock();
+
+        return (result);
+    }
+
+    BulkBuffer::BulkBuffer(const Core::ProxyType<Core::IPCChannel>& channel, const uint32_t capacity)
+        : _arena()
+        , _offset(~0)
+        , _capacity(capacity)
+    {
+        if (capacity >= ArenaThreshold) {
+            _arena = Administrator::Instance().Outbound(channel);
+
+            if (_arena->IsValid() == true) {
+                _offset = _arena->Allocate(capacity);
+            }
+        }
+    }
+    BulkBuffer::~BulkBuffer()
+    {
+        if (_offset != static_cast<uint32_t>(~0)) {
+            _arena->Free(_offset);
+        }
+    }
+
+    void BulkBuffer::Write(Data::Frame::Writer& writer, const uint8_t data[], const uint32_t length)
+    {
+        ASSERT(length <= _capacity);
+
+        if (_offset != static_cast<uint32_t>(~0)) {
+            if (length != 0) {
+                ::memcpy(_arena->Buffer(_offset), data, length);
+            }
+
+            writer.Number<uint8_t>(SHARED);
+            writer.Text(_arena->Name());
+            writer.Number<uint32_t>(_offset);
+            writer.Number<uint32_t>(_capacity);
+            writer.Number<uint32_t>(length);
+        } else {
+            // Never a truncated buffer, the proxy does not invoke the call if it is not valid.
+            writer.Number<uint8_t>(INLINE);
+            writer.Buffer<uint16_t>((IsValid() == true ? static_cast<uint16_t>(length) : 0), data);
+        }
+    }
+
+    void BulkBuffer::Read(const Data::Frame::Reader& reader, uint8_t data[]) const
+    {
+        const uint8_t* source = nullptr;
+        uint32_t length;
+
+        if (reader.Number<uint8_t>() == SHARED) {
+            ASSERT(_offset != static_cast<uint32_t>(~0));
+
+            length = reader.Number<uint32_t>();
+            source = _arena->Buffer(_offset);
+        } else {
+            length = reader.LockBuffer<uint16_t>(source);
+            reader.UnlockBuffer<uint16_t>(static_cast<uint16_t>(length));
+        }
+
+        if ((data != nullptr) && (length != 0)) {
+            ::memcpy(data, source, std::min(length, _capacity));
+        }
+    }
+
+    /* static */ uint32_t BulkBuffer::Lock(const Core::ProxyType<Core::IPCChannel>& channel, const Data::Frame::Reader& reader, uint8_t*& data, uint32_t& capacity)
+    {
+        uint32_t result;
+
+        data = nullptr;
+        capacity = 0;
+
+        if (reader.Number<uint8_t>() == SHARED) {
+            const string name(reader.Text());
+            const uint32_t offset = reader.Number<uint32_t>();
+            const uint32_t room = reader.Number<uint32_t>();
+            Core::ProxyType<Arena> arena(Administrator::Instance().Inbound(channel, name));
+
+            result = reader.Number<uint32_t>();
+
+            // Everything here comes from the other side, so nothing may point outside of the arena.
+            if ((arena.IsValid() == true) && (arena->IsValid() == true) && (offset <= arena->Size()) && (room <= (arena->Size() - offset)) && (result <= room)) {
+                data = arena->Buffer(offset);
+                capacity = room;
+            } else {
+                TRACE_L1("Could not use %d bytes at %d in the COMRPC arena %s.", room, offset, name.c_str());
+                result = 0;
+            }
+        } else {
+            const uint8_t* buffer = nullptr;
+
+            result = reader.LockBuffer<uint16_t>(buffer);
+            reader.UnlockBuffer<uint16_t>(static_cast<uint16_t>(result));
+
+            // Input is used right where it is in the frame, as the generated stubs always did.
+            if (result != 0) {
+                data = const_cast<uint8_t*>(buffer);
+                capacity = result;
+            }
+        }
+
+        return (result);
+    }
+
+    /* static */ void BulkBuffer::Complete(const Core::ProxyType<Core::IPCChannel>& channel, Data::Frame::Writer& writer, const uint32_t length, const uint8_t data[])
+    {
+        Core::ProxyType<Arena> arena(Administrator::Instance().Inbound(channel, string()));
+
+        if ((arena.IsValid() == true) && (arena->Contains(data) == true)) {
+            writer.Number<uint8_t>(SHARED);
+            writer.Number<uint32_t>(length);
+        } else if (length >= InlineLimit) {
+            // A proxy does not call with a buffer that can only come back truncated.
+            TRACE_L1("Output buffer of %d bytes does not fit in the frame.", length);
+
+            writer.Number<uint8_t>(INLINE);
+            writer.Buffer<uint16_t>(0, nullptr);
+        } else {
+            writer.Number<uint8_t>(INLINE);
+            writer.Buffer<uint16_t>((data != nullptr ? static_cast<uint16_t>(length) : 0), data);
+        }
     }
 
     /* static */ Administrator& Job::_administrator= Administrator::Instance();
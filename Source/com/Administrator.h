@@ -20,6 +20,7 @@
 #ifndef __COM_ADMINISTRATOR_H
 #define __COM_ADMINISTRATOR_H
 
+#include "Arena.h"
 #include "Messages.h"
 #include "Module.h"
 
@@ -39,6 +40,9 @@ namespace RPC {
     enum { CommunicationTimeOut = 10000 }; // Time in ms. 10 Seconden
 #endif
     enum { CommunicationBufferSize = 8120 }; // 8K :-)
+    enum { ArenaSize = 4 * 1024 * 1024 }; // Room for the @shared buffers of the calls in flight on a channel
+    enum { ArenaThreshold = 1024 }; // Smaller @shared buffers are cheaper to just copy into the frame
+    enum { InlineLimit = 60 * 1024 }; // Larger @shared buffers do not fit in a frame, they only go through the arena
 
     class EXTERNAL Administrator {
     private:
@@ -90,6 +94,12 @@ namespace RPC {
         typedef std::map<const Core::IPCChannel*, ProxyList> ChannelMap;
         typedef std::map<const Core::IPCChannel*, std::list< RecoverySet > > ReferenceMap;
 
+        struct ArenaSet {
+            Core::ProxyType<Arena> Outbound;
+            Core::ProxyType<Arena> Inbound;
+        };
+        typedef std::map<const Core::IPCChannel*, ArenaSet> ArenaMap;
+
         struct EXTERNAL IMetadata {
             virtual ~IMetadata(){};
 
@@ -163,6 +173,19 @@ namespace RPC {
             return (_factory.Element());
         }
 
+        // The proxy/stubs of this interface live in the given library, which is loaded on first use
+        // of the interface.
+        void Index(const uint32_t interfaceId, const string& library)
+        {
+            _adminLock.Lock();
+
+            if (_stubs.find(interfaceId) == _stubs.end()) {
+                _index.insert(std::pair<uint32_t, string>(interfaceId, library));
+            }
+
+            _adminLock.Unlock();
+        }
+
         void DeleteChannel(const Core::ProxyType<Core::IPCChannel>& channel, std::list<ProxyStub::UnknownProxy*>& pendingProxies);
 
         template <typename ACTUALINTERFACE>
@@ -241,22 +264,95 @@ namespace RPC {
             _adminLock.Unlock();
         }
         void UnregisterProxy(const ProxyStub::UnknownProxy& proxy);
-        
+
+        // ----------------------------------------------------------------------------------------------------
+        // Shared memory for @shared buffer arguments, see BulkBuffer
+        // ----------------------------------------------------------------------------------------------------
+        // The arena our proxies hand out regions of, it is created on first use.
+        Core::ProxyType<Arena> Outbound(const Core::ProxyType<Core::IPCChannel>& channel);
+        // The arena of the proxies on the other side, it is opened on first use. Without a name, only
+        // an arena that is already open is returned.
+        Core::ProxyType<Arena> Inbound(const Core::ProxyType<Core::IPCChannel>& channel, const string& name);
+
    private:
         // ----------------------------------------------------------------------------------------------------
         // Methods for the Stub Environment
         // ----------------------------------------------------------------------------------------------------
         Core::IUnknown* Convert(void* rawImplementation, const uint32_t id);
         void RegisterUnknownInterface(Core::ProxyType<Core::IPCChannel>& channel, Core::IUnknown* source, const uint32_t id);
+        ProxyStub::UnknownStub* Stub(const uint32_t id);
+        bool Load(const uint32_t id);
 
     private:
         // Seems like we have enough information, open up the Process communcication Channel.
         Core::CriticalSection _adminLock;
         std::map<uint32_t, ProxyStub::UnknownStub*> _stubs;
         std::map<uint32_t, IMetadata*> _proxy;
+        std::map<uint32_t, string> _index;
+        std::list<Core::Library> _libraries;
         Core::ProxyPoolType<InvokeMessage> _factory;
         ChannelMap _channelProxyMap;
         ReferenceMap _channelReferenceMap;
+        ArenaMap _channelArenaMap;
+        uint32_t _arenaSequence;
+    };
+
+    // A buffer argument tagged @shared. On the proxy side it claims a region of the outbound arena
+    // of the channel for the duration of the call, only its offset and length go in the frame. The
+    // stub side works on that region in place. Without an arena, with no room left in it, or for
+    // small buffers, the content goes in the frame like any other buffer. A buffer too large for the
+    // frame that finds no room in the arena can not be passed, the call must fail then.
+    class EXTERNAL BulkBuffer {
+    private:
+        enum mode : uint8_t {
+            INLINE = 0,
+            SHARED = 1
+        };
+
+    public:
+        BulkBuffer() = delete;
+        BulkBuffer(const BulkBuffer&) = delete;
+        BulkBuffer& operator=(const BulkBuffer&) = delete;
+
+        BulkBuffer(const Core::ProxyType<Core::IPCChannel>& channel, const uint32_t capacity);
+        ~BulkBuffer();
+
+    public:
+        // Proxy side, false if the buffer can not be passed, do not invoke the call then.
+        inline bool IsValid() const
+        {
+            return ((_offset != static_cast<uint32_t>(~0)) || (_capacity < InlineLimit));
+        }
+        // Proxy side, pass the content of an input buffer. An output only buffer passes no data.
+        void Write(Data::Frame::Writer& writer, const uint8_t data[], const uint32_t length);
+        // Proxy side, fetch what the stub left in an output buffer.
+        void Read(const Data::Frame::Reader& reader, uint8_t data[]) const;
+
+        // Stub side, returns the length of the input and points data to it, capacity tells how much
+        // may be written there. An output buffer that did not come through the arena has a capacity
+        // of 0 (data is nullptr) or just the length of its input, the stub provides the storage then.
+        template <typename TYPE>
+        static uint32_t Lock(const Core::ProxyType<Core::IPCChannel>& channel, const Data::Frame::Reader& reader, TYPE*& data, uint32_t& capacity)
+        {
+            uint8_t* buffer = nullptr;
+            uint32_t result = Lock(channel, reader, buffer, capacity);
+            data = reinterpret_cast<TYPE*>(buffer);
+            return (result);
+        }
+        template <typename TYPE>
+        static uint32_t Lock(const Core::ProxyType<Core::IPCChannel>& channel, const Data::Frame::Reader& reader, TYPE*& data)
+        {
+            uint32_t capacity;
+            return (Lock(channel, reader, data, capacity));
+        }
+        static uint32_t Lock(const Core::ProxyType<Core::IPCChannel>& channel, const Data::Frame::Reader& reader, uint8_t*& data, uint32_t& capacity);
+        // Stub side, report the length of an output buffer, and its content if it is not in the arena.
+        static void Complete(const Core::ProxyType<Core::IPCChannel>& channel, Data::Frame::Writer& writer, const uint32_t length, const uint8_t data[]);
+
+    private:
+        Core::ProxyType<Arena> _arena;
+        uint32_t _offset;
+        uint32_t _capacity;
     };
 
     class EXTERNAL Job : public Core::IDispatch {
@@ -0,0 +1,89 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Arena.h"
+
+namespace WPEFramework {
+namespace RPC {
+
+    Arena::Arena(const string& name, const uint32_t size)
+        : _adminLock()
+        , _storage(name, Core::File::USER_READ | Core::File::USER_WRITE | Core::File::SHAREABLE | Core::File::CREATE, size)
+        , _regions()
+        , _owner(true)
+    {
+    }
+    Arena::Arena(const string& name)
+        : _adminLock()
+        , _storage(name, Core::File::USER_READ | Core::File::USER_WRITE | Core::File::SHAREABLE, 0)
+        , _regions()
+        , _owner(false)
+    {
+    }
+    Arena::~Arena()
+    {
+        ASSERT(_regions.empty() == true);
+
+        if (_owner == true) {
+            // Our mapping stays valid until it is gone, the other side may still have it mapped.
+            Core::File(_storage.Name()).Destroy();
+        }
+    }
+
+    uint32_t Arena::Allocate(const uint32_t length)
+    {
+        uint32_t result = ~0;
+        const uint32_t size = ((length + Alignment - 1) / Alignment) * Alignment;
+
+        ASSERT(_owner == true);
+
+        _adminLock.Lock();
+
+        if ((IsValid() == true) && (size <= Size())) {
+            uint32_t start = 0;
+            Regions::const_iterator index(_regions.begin());
+
+            // First fit, calls are short lived so the holes do not stay around for long.
+            while ((index != _regions.end()) && ((index->first - start) < size)) {
+                start = index->first + index->second;
+                index++;
+            }
+
+            if ((index != _regions.end()) || ((Size() - start) >= size)) {
+                _regions.emplace(start, size);
+                result = start;
+            }
+        }
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+    void Arena::Free(const uint32_t offset)
+    {
+        _adminLock.Lock();
+
+        ASSERT(_regions.find(offset) != _regions.end());
+
+        _regions.erase(offset);
+
+        _adminLock.Unlock();
+    }
+}
+}
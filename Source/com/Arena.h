@@ -0,0 +1,81 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+namespace WPEFramework {
+namespace RPC {
+
+    // Shared memory, mapped by both ends of a channel, for buffer arguments tagged @shared. The side
+    // that creates it hands out regions for the duration of a call, the other side opens it by name
+    // and reads or writes those regions in place.
+    class EXTERNAL Arena {
+    private:
+        typedef std::map<uint32_t, uint32_t> Regions;
+
+    public:
+        enum { Alignment = 64 };
+
+        Arena() = delete;
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        // Create a new arena of the given size.
+        Arena(const string& name, const uint32_t size);
+        // Open the arena created by the other side.
+        Arena(const string& name);
+        ~Arena();
+
+    public:
+        inline bool IsValid() const
+        {
+            return ((_storage.IsValid() == true) && (_storage.Size() > 0));
+        }
+        inline const string& Name() const
+        {
+            return (_storage.Name());
+        }
+        inline uint32_t Size() const
+        {
+            return (_storage.Size());
+        }
+        inline uint8_t* Buffer(const uint32_t offset)
+        {
+            ASSERT(offset < Size());
+            return (&(_storage.Buffer()[offset]));
+        }
+        inline bool Contains(const uint8_t data[]) const
+        {
+            return ((IsValid() == true) && (data >= _storage.Buffer()) && (data < &(_storage.Buffer()[Size()])));
+        }
+
+        // Returns the offset of a free region of the given length, or ~0 if there is no room.
+        uint32_t Allocate(const uint32_t length);
+        void Free(const uint32_t offset);
+
+    private:
+        Core::CriticalSection _adminLock;
+        Core::DataElementFile _storage;
+        Regions _regions;
+        bool _owner;
+    };
+}
+}
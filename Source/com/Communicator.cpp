@@ -19,9 +19,16 @@
 
 #include "Communicator.h"
 
+#include <fstream>
 #include <limits>
 #include <memory>
 
+#ifndef __WINDOWS__
+#include <sys/syscall.h>
+
+extern char** environ;
+#endif
+
 namespace WPEFramework {
 namespace RPC {
 
@@ -101,24 +108,34 @@ namespace RPC {
         LocalClosingInfo(const LocalClosingInfo& copy) = delete;
         LocalClosingInfo& operator=(const LocalClosingInfo& RHS) = delete;
 
-        explicit LocalClosingInfo(const uint32_t pid)
+        LocalClosingInfo(const uint32_t pid, const int descriptor)
             : _process(pid)
+#ifdef SYS_pidfd_send_signal
+            , _descriptor(descriptor != -1 ? ::fcntl(descriptor, F_DUPFD_CLOEXEC, 0) : -1)
+#endif
+        {
+        }
+        ~LocalClosingInfo() override
         {
+#ifdef SYS_pidfd_send_signal
+            if (_descriptor != -1) {
+                ::close(_descriptor);
+            }
+#endif
         }
-        ~LocalClosingInfo() override = default;
 
     public:
         uint32_t AttemptClose(const uint8_t iteration) override
         {
             uint32_t nextinterval = 0;
-            if (_process.IsActive() != false) {
+            if (IsActive() != false) {
                 switch (iteration) {
                 case 0:
-                    _process.Kill(false);
+                    Kill(false);
                     nextinterval = 10000;
                     break;
                 case 1:
-                    _process.Kill(true);
+                    Kill(true);
                     nextinterval = 4000;
                     break;
                 default:
@@ -130,8 +147,37 @@ namespace RPC {
             return nextinterval;
         }
 
+    private:
+        // With a pidfd, neither the check nor the signal can hit a process that reused the pid.
+        bool IsActive() const
+        {
+#ifdef SYS_pidfd_send_signal
+            struct pollfd info = { _descriptor, POLLIN, 0 };
+
+            // A pidfd becomes readable once its process is gone.
+            return (_descriptor != -1 ? (::poll(&info, 1, 0) == 0) : _process.IsActive());
+#else
+            return (_process.IsActive());
+#endif
+        }
+        void Kill(const bool hardKill)
+        {
+#ifdef SYS_pidfd_send_signal
+            if (_descriptor != -1) {
+                ::syscall(SYS_pidfd_send_signal, _descriptor, (hardKill ? SIGKILL : SIGTERM), nullptr, 0);
+            } else {
+                _process.Kill(hardKill);
+            }
+#else
+            _process.Kill(hardKill);
+#endif
+        }
+
     private:
         Core::Process _process;
+#ifdef SYS_pidfd_send_signal
+        int _descriptor;
+#endif
     };
 
 #ifdef PROCESSCONTAINERS_ENABLED
@@ -199,9 +245,47 @@ namespace RPC {
 
     /* static */ std::atomic<uint32_t> Communicator::RemoteConnection::_sequenceId(1);
 
+    // The ProxyStubGenerator writes the IDs of the interfaces in a proxy/stub library next to it,
+    // in <library>.ids. Only if all of them could be read, the library can be loaded on first use.
+    static bool IndexProxyStubs(const string& library)
+    {
+        std::ifstream file(library + _T(".ids"));
+        std::list<uint32_t> interfaces;
+        bool result = file.is_open();
+
+        while ((result == true) && (file.eof() == false)) {
+            string line;
+            getline(file, line);
+
+            Core::TextSegmentIterator fields(Core::TextFragment(line), true, _T(" \t\r"));
+
+            if ((fields.Next() == true) && (fields.Current()[0] != '#')) {
+                const string id(fields.Current().Text());
+                TCHAR* end;
+                uint32_t value = static_cast<uint32_t>(::strtoul(id.c_str(), &end, 0));
+
+                // An interface of which the generator could not determine the ID, forces a load.
+                result = ((end != id.c_str()) && (*end == '\0'));
+
+                if (result == true) {
+                    interfaces.push_back(value);
+                }
+            }
+        }
+
+        if (result == true) {
+            for (const uint32_t id : interfaces) {
+                Administrator::Instance().Index(id, library);
+            }
+        }
+
+        return (result);
+    }
+
     static void LoadProxyStubs(const string& pathName)
     {
         static std::list<Core::Library> processProxyStubs;
+        static std::list<string> indexedProxyStubs;
 
         Core::Directory index(pathName.c_str(), _T("*.so"));
 
@@ -212,11 +296,15 @@ namespace RPC {
                 loop++;
             }
 
-            if (loop == processProxyStubs.end()) {
-                Core::Library library(index.Current().c_str());
+            if ((loop == processProxyStubs.end()) && (std::find(indexedProxyStubs.begin(), indexedProxyStubs.end(), index.Current()) == indexedProxyStubs.end())) {
+                if (IndexProxyStubs(index.Current()) == true) {
+                    indexedProxyStubs.push_back(index.Current());
+                } else {
+                    Core::Library library(index.Current().c_str());
 
-                if (library.IsLoaded() == true) {
-                    processProxyStubs.push_back(library);
+                    if (library.IsLoaded() == true) {
+                        processProxyStubs.push_back(library);
+                    }
                 }
             }
         }
@@ -263,6 +351,116 @@ namespace RPC {
         return (_remoteId);
     }
 
+#ifndef __WINDOWS__
+    // Only a zygote of our own gets to see our environment.
+    static bool IsOwner(const int channel)
+    {
+        struct ucred credentials;
+        socklen_t length = sizeof(credentials);
+
+        return ((::getsockopt(channel, SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0) && (credentials.uid == ::geteuid()));
+    }
+
+    // The pid of the forked process, and its pidfd if the zygote sent one along.
+    static bool ReceivePid(const int channel, uint32_t& pid, int& descriptor)
+    {
+        struct iovec data = { &pid, sizeof(pid) };
+        struct msghdr message;
+        union {
+            struct cmsghdr header;
+            char buffer[CMSG_SPACE(sizeof(int))];
+        } control;
+
+        ::memset(&message, 0, sizeof(message));
+        message.msg_iov = &data;
+        message.msg_iovlen = 1;
+        message.msg_control = control.buffer;
+        message.msg_controllen = sizeof(control.buffer);
+
+        const bool result = (::recvmsg(channel, &message, MSG_WAITALL | MSG_CMSG_CLOEXEC) == sizeof(pid));
+        struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+
+        if ((header != nullptr) && (header->cmsg_level == SOL_SOCKET) && (header->cmsg_type == SCM_RIGHTS)) {
+            ::memcpy(&descriptor, CMSG_DATA(header), sizeof(descriptor));
+        }
+
+        return (result);
+    }
+#endif
+
+    uint32_t Process::Spawn(uint32_t& id)
+    {
+        uint32_t result = Core::ERROR_UNAVAILABLE;
+
+#ifndef __WINDOWS__
+        // The request is the command line followed by an empty string and the environment of this
+        // process, all '\0' terminated, so the forked process runs as if it was launched from here.
+        string request(_options.Command());
+        request += '\0';
+
+        Core::Process::Options::Iterator index(_options.Get());
+        while (index.Next() == true) {
+            request += index.Current();
+            request += '\0';
+        }
+        request += '\0';
+
+        for (char** variable = environ; *variable != nullptr; variable++) {
+            request += *variable;
+            request += '\0';
+        }
+
+        int channel = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (channel != -1) {
+            struct sockaddr_un address;
+            struct timeval timeout = { 2, 0 };
+            const uint32_t length = static_cast<uint32_t>(request.length());
+            uint32_t pid = 0;
+
+            ::memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            ::strncpy(address.sun_path, _zygote.c_str(), sizeof(address.sun_path) - 1);
+
+            ::setsockopt(channel, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            ::setsockopt(channel, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+            if ((::connect(channel, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == 0) &&
+                (IsOwner(channel) == true) &&
+                (::send(channel, &length, sizeof(length), MSG_NOSIGNAL) == sizeof(length))) {
+
+                uint32_t offset = 0;
+                ssize_t sent = 0;
+
+                while ((offset < length) && ((sent = ::send(channel, &(request.data()[offset]), length - offset, MSG_NOSIGNAL)) > 0)) {
+                    offset += static_cast<uint32_t>(sent);
+                }
+
+                // The forked process waits for this go ahead. Without it, e.g. because the pid came
+                // too late, it exits and the fork/exec fallback is the only process launched.
+                const char go = 1;
+
+                if ((offset == length) && (ReceivePid(channel, pid, _descriptor) == true) && (pid != 0) &&
+                    (::send(channel, &go, sizeof(go), MSG_NOSIGNAL) == sizeof(go))) {
+                    id = pid;
+                    result = Core::ERROR_NONE;
+                } else if (_descriptor != -1) {
+                    ::close(_descriptor);
+                    _descriptor = -1;
+                }
+            }
+
+            ::close(channel);
+        }
+
+        if (result != Core::ERROR_NONE) {
+            TRACE_L1("Zygote at %s did not spawn %s, falling back to fork/exec.", _zygote.c_str(), _options.Command().c_str());
+        }
+#endif
+
+        return (result);
+    }
+
     /* virtual */ void Communicator::LocalProcess::Terminate()
     {
         // Do not yet call the close on the connection, the otherside might close down decently and release all opened interfaces..
@@ -270,7 +468,7 @@ namespace RPC {
 
         // Time to shoot the application, it will trigger a close by definition of the channel, if it is still standing..
         if (_id != 0) {
-            ProcessShutdown::Start<LocalClosingInfo>(_id);
+            ProcessShutdown::Start<LocalClosingInfo>(_id, _process.Descriptor());
         }
     }
 
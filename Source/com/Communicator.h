@@ -201,6 +201,7 @@ namespace RPC {
             , _application()
             , _proxyStub()
             , _postMortem()
+            , _zygote()
         {
         }
         Config(
@@ -212,7 +213,8 @@ namespace RPC {
             const string& volatilePath,
             const string& applicationPath,
             const string& proxyStubPath,
-            const string& postMortem)
+            const string& postMortem,
+            const string& zygote = string())
             : _connector(connector)
             , _hostApplication(hostApplication)
             , _persistent(persistentPath)
@@ -222,6 +224,7 @@ namespace RPC {
             , _application(applicationPath)
             , _proxyStub(proxyStubPath)
             , _postMortem(postMortem)
+            , _zygote(zygote)
         {
         }
         Config(const Config& copy)
@@ -234,6 +237,7 @@ namespace RPC {
             , _application(copy._application)
             , _proxyStub(copy._proxyStub)
             , _postMortem(copy._postMortem)
+            , _zygote(copy._zygote)
         {
         }
         ~Config()
@@ -277,7 +281,11 @@ namespace RPC {
         {
             return (_postMortem);
         }
-
+        // Socket of a pre-forked host process, if empty, processes are launched with fork/exec.
+        inline const string& Zygote() const
+        {
+            return (_zygote);
+        }
 
     private:
         string _connector;
@@ -289,6 +297,7 @@ namespace RPC {
         string _application;
         string _proxyStub;
         string _postMortem;
+        string _zygote;
     };
 
     class EXTERNAL Process {
@@ -299,6 +308,8 @@ namespace RPC {
 
         Process(const uint32_t sequenceNumber, const Config& config, const Object& instance)
             : _options(config.HostApplication())
+            , _zygote(config.Zygote())
+            , _descriptor(-1)
         {
             ASSERT(instance.Locator().empty() == false);
             ASSERT(instance.ClassName().empty() == false);
@@ -346,6 +357,14 @@ namespace RPC {
 
             _priority = instance.Priority();
         }
+        ~Process()
+        {
+#ifndef __WINDOWS__
+            if (_descriptor != -1) {
+                ::close(_descriptor);
+            }
+#endif
+        }
         const string& Command() const
         {
             return (_options.Command());
@@ -354,15 +373,30 @@ namespace RPC {
         {
             return (_options.Get());
         }
+        // A process from the zygote is not our child, its pid may be reused once it is gone. If the
+        // zygote could, it handed us a pidfd, which always refers to the process it launched.
+        inline int Descriptor() const
+        {
+            return (_descriptor);
+        }
         uint32_t Launch(uint32_t& id)
         {
             uint32_t loggingSettings = (Logging::LoggingType<Logging::Startup>::IsEnabled() ? 0x01 : 0) | (Logging::LoggingType<Logging::Shutdown>::IsEnabled() ? 0x02 : 0) | (Logging::LoggingType<Logging::Notification>::IsEnabled() ? 0x04 : 0);
             _options.Add(_T("-e")).Add(Core::NumberType<uint32_t>(loggingSettings).Text());
 
-            // Start the external process launch..
-            Core::Process fork(false);
+            uint32_t result = Core::ERROR_UNAVAILABLE;
+
+            // If there is a zygote, let it fork a warm process, otherwise (or if it does not respond) start from scratch.
+            if (_zygote.empty() == false) {
+                result = Spawn(id);
+            }
 
-            uint32_t result = fork.Launch(_options, &id);
+            if (result != Core::ERROR_NONE) {
+                // Start the external process launch..
+                Core::Process fork(false);
+
+                result = fork.Launch(_options, &id);
+            }
 
             if ((result == Core::ERROR_NONE) && (_priority != 0)) {
                 Core::ProcessInfo newProcess(id);
@@ -372,8 +406,13 @@ namespace RPC {
             return (result);
         }
 
+    private:
+        uint32_t Spawn(uint32_t& id);
+
     private:
         Core::Process::Options _options;
+        string _zygote;
+        int _descriptor;
         int8_t _priority;
     };
 
@@ -413,6 +413,10 @@ namespace ProxyStub {
         {
             return (_unknown.Complete(reader));
         }
+        inline const Core::ProxyType<Core::IPCChannel>& Channel() const
+        {
+            return (_unknown.Channel());
+        }
 
         // -------------------------------------------------------------------------------------------------------------------------------
         // Applications calls to the Proxy
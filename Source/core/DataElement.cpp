@@ -19,6 +19,10 @@
 
 #include "DataElement.h"
 
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
 namespace WPEFramework {
 namespace Core {
 
@@ -71,6 +75,81 @@ namespace Core {
         0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4
     };
 
+#if !defined(__ARM_FEATURE_CRC32)
+    // Slicing-by-8: entry [n][i] is the CRC of byte i followed by n zero bytes, so eight
+    // bytes are folded into the CRC with eight independent lookups.
+    class CRCSlices {
+    public:
+        CRCSlices(const CRCSlices&) = delete;
+        CRCSlices& operator=(const CRCSlices&) = delete;
+
+        CRCSlices()
+        {
+            for (uint16_t index = 0; index < 256; index++) {
+                _table[0][index] = g_CRCtable[index];
+            }
+            for (uint8_t slice = 1; slice < 8; slice++) {
+                for (uint16_t index = 0; index < 256; index++) {
+                    _table[slice][index] = (_table[slice - 1][index] << 8) ^ g_CRCtable[_table[slice - 1][index] >> 24];
+                }
+            }
+        }
+
+    public:
+        // Built on first use, a CRC calculated by a static constructor elsewhere may come first.
+        static const CRCSlices& Instance()
+        {
+            static const CRCSlices slices;
+
+            return (slices);
+        }
+        inline const uint32_t* operator[](const uint8_t slice) const
+        {
+            return (_table[slice]);
+        }
+
+    private:
+        uint32_t _table[8][256];
+    };
+#endif
+
+    static uint32_t CalculateCRC32(uint32_t crc, const uint8_t* data, uint32_t length)
+    {
+#if defined(__ARM_FEATURE_CRC32)
+        // The ARMv8 CRC32 instructions use the same polynomial, but shift LSB first. Mirror
+        // the bits of every byte going in, and of the CRC going in and out, to get MSB first.
+        crc = __rbit(crc);
+
+        while (length >= 8) {
+            uint64_t value;
+            ::memcpy(&value, data, sizeof(value));
+            crc = __crc32d(crc, __rbitll(__builtin_bswap64(value)));
+            data += 8;
+            length -= 8;
+        }
+        while (length-- != 0) {
+            crc = __crc32b(crc, static_cast<uint8_t>(__rbit(*data++) >> 24));
+        }
+
+        crc = __rbit(crc);
+#else
+        const CRCSlices& slices(CRCSlices::Instance());
+
+        while (length >= 8) {
+            const uint32_t word = crc ^ ((static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) | (static_cast<uint32_t>(data[2]) << 8) | data[3]);
+
+            crc = slices[7][word >> 24] ^ slices[6][(word >> 16) & 0xff] ^ slices[5][(word >> 8) & 0xff] ^ slices[4][word & 0xff] ^ slices[3][data[4]] ^ slices[2][data[5]] ^ slices[1][data[6]] ^ slices[0][data[7]];
+            data += 8;
+            length -= 8;
+        }
+        while (length-- != 0) {
+            crc = (crc << 8) ^ g_CRCtable[((crc >> 24) ^ *data++) & 0xff];
+        }
+#endif
+
+        return (crc);
+    }
+
     /// <summary>
     /// Calculates the CRC value over a (part of) the raw buffer.
     /// </summary>
@@ -80,13 +159,8 @@ namespace Core {
     uint32_t DataElement::CRC32(const uint64_t offset, const uint64_t size) const
     {
         ASSERT(offset + size <= m_Size);
-        uint32_t crc = 0xffffffff;
 
-        for (uint32_t index = 0; index < static_cast<uint32_t>(size); ++index) {
-            crc = (crc << 8) ^ g_CRCtable[((crc >> 24) ^ m_Buffer[static_cast<uint32_t>(offset) + index]) & 0xff];
-        }
-
-        return (crc);
+        return (CalculateCRC32(0xffffffff, &(m_Buffer[static_cast<uint32_t>(offset)]), static_cast<uint32_t>(size)));
     }
 
     void LinkedDataElement::GetBuffer(uint64_t offset, uint32_t size, uint8_t* buffer) const
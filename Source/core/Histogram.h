@@ -0,0 +1,144 @@
+ /*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __HISTOGRAM_H
+#define __HISTOGRAM_H
+
+#include "Module.h"
+#include "Portability.h"
+
+namespace WPEFramework {
+namespace Core {
+    // Log-linear histogram: values below 2^PRECISION get a bucket of their own, above that every
+    // power of two is split in 2^PRECISION buckets, so a percentile is off by at most 1/2^PRECISION.
+    // Recording is lock free, so it can be done from any thread without contention.
+    template <const uint8_t PRECISION = 4>
+    class HistogramType {
+    private:
+        static_assert((PRECISION > 0) && (PRECISION < 16), "Precision should be between 1 and 15 bits");
+
+        static constexpr uint32_t SubBuckets = (1 << PRECISION);
+        static constexpr uint32_t Buckets = SubBuckets + ((32 - PRECISION) * SubBuckets);
+
+    public:
+        HistogramType(const HistogramType<PRECISION>&) = delete;
+        HistogramType<PRECISION>& operator=(const HistogramType<PRECISION>&) = delete;
+
+        HistogramType()
+            : _count(0)
+            , _max(0)
+        {
+            for (uint32_t index = 0; index < Buckets; index++) {
+                _buckets[index].store(0, std::memory_order_relaxed);
+            }
+        }
+        ~HistogramType()
+        {
+        }
+
+    public:
+        void Reset()
+        {
+            for (uint32_t index = 0; index < Buckets; index++) {
+                _buckets[index].store(0, std::memory_order_relaxed);
+            }
+            _max.store(0, std::memory_order_relaxed);
+            _count.store(0, std::memory_order_relaxed);
+        }
+        void Set(const uint32_t value)
+        {
+            _buckets[Bucket(value)].fetch_add(1, std::memory_order_relaxed);
+            _count.fetch_add(1, std::memory_order_relaxed);
+
+            uint32_t current = _max.load(std::memory_order_relaxed);
+            while ((value > current) && (_max.compare_exchange_weak(current, value, std::memory_order_relaxed) == false)) {
+                // current is reloaded by the failing exchange, try again.
+            }
+        }
+        inline uint32_t Measurements() const
+        {
+            return (_count.load(std::memory_order_relaxed));
+        }
+        inline uint32_t Max() const
+        {
+            return (_max.load(std::memory_order_relaxed));
+        }
+        // The highest value of the bucket holding the requested percentile (0..100), never above Max().
+        uint32_t Percentile(const uint8_t percentile) const
+        {
+            uint32_t result = 0;
+            const uint32_t count = Measurements();
+
+            if (count > 0) {
+                const uint64_t rank = ((static_cast<uint64_t>(count) * (percentile > 100 ? 100 : percentile)) + 99) / 100;
+                uint64_t seen = 0;
+                uint32_t index = 0;
+
+                while ((index < (Buckets - 1)) && ((seen += _buckets[index].load(std::memory_order_relaxed)) < (rank == 0 ? 1 : rank))) {
+                    index++;
+                }
+
+                result = std::min(Highest(index), Max());
+            }
+
+            return (result);
+        }
+
+    private:
+        static uint32_t Bucket(const uint32_t value)
+        {
+            uint32_t result = value;
+
+            if (value >= SubBuckets) {
+                uint8_t magnitude = PRECISION;
+
+                while ((magnitude < 31) && ((value >> (magnitude + 1)) != 0)) {
+                    magnitude++;
+                }
+
+                const uint8_t shift = magnitude - PRECISION;
+
+                result = SubBuckets + (shift * SubBuckets) + ((value >> shift) - SubBuckets);
+            }
+
+            return (result);
+        }
+        static uint32_t Highest(const uint32_t bucket)
+        {
+            uint32_t result = bucket;
+
+            if (bucket >= SubBuckets) {
+                const uint8_t shift = static_cast<uint8_t>((bucket - SubBuckets) / SubBuckets);
+                const uint64_t lowest = static_cast<uint64_t>(SubBuckets + ((bucket - SubBuckets) % SubBuckets)) << shift;
+
+                result = static_cast<uint32_t>(std::min(lowest + (static_cast<uint64_t>(1) << shift) - 1, static_cast<uint64_t>(~static_cast<uint32_t>(0))));
+            }
+
+            return (result);
+        }
+
+    private:
+        std::atomic<uint32_t> _buckets[Buckets];
+        std::atomic<uint32_t> _count;
+        std::atomic<uint32_t> _max;
+    };
+}
+}
+
+#endif // __HISTOGRAM_H
@@ -69,19 +69,24 @@ namespace Core {
                 _offset = 0;
                 _current = &element;
 
+                // The variable length encoding carries at most 29 bits.
                 ASSERT(_length <= 0x1FFFFFFF);
+                ASSERT(element.Sequence() <= 0x1FFFFFFF);
 
                 return (true);
             }
 
             // The Serialize and Deserialize methods allow the content to be serialized/deserialized.
+            // A frame consists of: [length][label][sequence][payload], where length, label and sequence
+            // are encoded as 7 bit variable length integers (max 4 bytes) and the length covers all
+            // bytes following it.
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength)
             {
                 uint16_t result = 0;
 
                 while ((_current != nullptr) && (result < maxLength)) {
                     if (_offset < 4) {
-                        uint32_t length = _length + CommandSize();
+                        uint32_t length = _length + VariableSize(_current->Label()) + VariableSize(_current->Sequence());
 
                         // Write the length. Continue as long as the top bt is active..
                         while ((_offset < 4) && (result < maxLength)) {
@@ -110,16 +115,29 @@ namespace Core {
                         }
                     }
 
+                    // Write the sequence, Same structure as length..
+                    while ((_offset < 12) && (result < maxLength)) {
+                        uint32_t value = _current->Sequence() >> (7 * (_offset - 8));
+                        stream[result] = ((value & 0x7F) | (value >= 0x80 ? 0x80 : 0x00));
+                        result++;
+
+                        if (value >= 0x80) {
+                            _offset++;
+                        } else {
+                            _offset = 12;
+                        }
+                    }
+
                     if (result < maxLength) {
-                        // Write the command, Same structure as length..
-                        uint16_t handled = _current->Serialize(&stream[result], maxLength - result, _offset - 8);
+                        // Write the payload..
+                        uint16_t handled = _current->Serialize(&stream[result], maxLength - result, _offset - 12);
 
                         result += handled;
                         _offset += handled;
 
-                        ASSERT_VERBOSE((_offset - 8) <= _length, "%d <= %d", (_offset - 8), _length);
+                        ASSERT_VERBOSE((_offset - 12) <= _length, "%d <= %d", (_offset - 12), _length);
 
-                        if ((_offset - 8) == _length) {
+                        if ((_offset - 12) == _length) {
                             const IMessage* ready = _current;
                             _current = nullptr;
 
@@ -134,9 +152,9 @@ namespace Core {
             virtual void Serialized(const IMessage& element) = 0;
 
         private:
-            inline uint32_t CommandSize() const
+            static inline uint32_t VariableSize(const uint32_t value)
             {
-                return (_current->Label() > 0x1FFFFF ? 4 : (_current->Label() > 0xCFFF ? 3 : (_current->Label() > 0x7F ? 2 : 1)));
+                return (value > 0x1FFFFF ? 4 : (value > 0x3FFF ? 3 : (value > 0x7F ? 2 : 1)));
             }
 
         private:
@@ -155,6 +173,7 @@ namespace Core {
                 : _length(0)
                 , _offset(0)
                 , _label(0)
+                , _sequence(0)
                 , _current(nullptr)
             {
             }
@@ -164,15 +183,15 @@ namespace Core {
 
         public:
             virtual void Deserialized(IMessage& element) = 0;
-            virtual IMessage* Element(const uint32_t& label) = 0;
+            virtual IMessage* Element(const uint32_t& label, const uint32_t sequence) = 0;
 
             uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength)
             {
                 uint16_t result = 0;
 
                 while (result < maxLength) {
-					if ((_current == nullptr) && (_offset < 8)) {
-                        // We have nothing, start by getting the length/command
+                    if ((_current == nullptr) && (_offset < 12)) {
+                        // We have nothing, start by getting the length/command/sequence
                         while ((_offset < 4) && (result < maxLength)) {
                             _length |= ((stream[result] & (_offset == 3 ? 0xFF : 0x7F)) << (7 * _offset));
 
@@ -194,30 +213,40 @@ namespace Core {
                             }
                         }
 
-                        if (_offset == 8) {
-                            _current = Element(_label);
+                        while ((_offset < 12) && (result < maxLength)) {
+                            _sequence |= ((stream[result] & (_offset == 11 ? 0xFF : 0x7F)) << (7 * (_offset - 8)));
+                            _length--;
+
+                            if ((stream[result++] & 0x80) != 0) {
+                                _offset++;
+                            } else {
+                                _offset = 12;
+                            }
+                        }
+
+                        if (_offset == 12) {
+                            _current = Element(_label, _sequence);
                             _label = 0;
+                            _sequence = 0;
                         }
                     }
 
-                    ASSERT((_offset - 8) <= _length);
+                    ASSERT((_offset < 12) || ((_offset - 12) <= _length));
 
-                    if ((_offset - 8) < _length) {
+                    if ((_offset >= 12) && ((_offset - 12) < _length)) {
 
                         // There could be multiple packages in this frame, do not read/handle more than what fits in the frame.
-                        uint16_t handled((maxLength - result) > static_cast<uint16_t>(_length - (_offset - 8)) ? static_cast<uint16_t>(_length - (_offset - 8)) : (maxLength - result));
+                        uint16_t handled((maxLength - result) > static_cast<uint16_t>(_length - (_offset - 12)) ? static_cast<uint16_t>(_length - (_offset - 12)) : (maxLength - result));
 
                         if (_current != nullptr) {
-                            handled = _current->Deserialize(&stream[result], handled, _offset - 8);
+                            handled = _current->Deserialize(&stream[result], handled, _offset - 12);
                         }
 
                         _offset += handled;
                         result += handled;
                     }
 
-                    ASSERT((_offset - 8) <= _length);
-
-                    if ((_offset - 8) == _length) {
+                    if ((_offset >= 12) && ((_offset - 12) == _length)) {
                         if (_current != nullptr) {
                             IMessage* ready = _current;
                             _current = nullptr;
@@ -234,6 +263,7 @@ namespace Core {
             uint32_t _length;
             uint32_t _offset;
             uint32_t _label;
+            uint32_t _sequence;
             IMessage* _current;
         };
 
@@ -241,6 +271,7 @@ namespace Core {
         virtual ~IMessage() {}
 
         virtual uint32_t Label() const = 0;
+        virtual uint32_t Sequence() const = 0;
         virtual uint32_t Length() const = 0;
         virtual uint16_t Serialize(uint8_t[] /* stream*/, const uint16_t /* maxLength */, const uint32_t offset) const = 0;
         virtual uint16_t Deserialize(const uint8_t[] /* stream*/, const uint16_t /* maxLength */, const uint32_t offset) = 0;
@@ -251,6 +282,8 @@ namespace Core {
         virtual ~IIPC();
 
         virtual uint32_t Label() const = 0;
+        virtual uint32_t Sequence() const = 0;
+        virtual void Sequence(const uint32_t sequence) = 0;
         virtual ProxyType<IMessage> IParameters() = 0;
         virtual ProxyType<IMessage> IResponse() = 0;
     };
@@ -304,6 +337,10 @@ namespace Core {
             {
                 return (REALIDENTIFIER);
             }
+            virtual uint32_t Sequence() const
+            {
+                return (_parent.Sequence());
+            }
             virtual uint32_t Length() const
             {
                 return (_Length<PACKAGE, REALIDENTIFIER>());
@@ -435,11 +472,13 @@ namespace Core {
         IPCMessageType()
             : _parameters(*this)
             , _response(*this)
+            , _sequence(0)
         {
         }
         IPCMessageType(const PARAMETERS& info)
             : _parameters(*this, info)
             , _response(*this)
+            , _sequence(0)
         {
         }
 #ifdef __WINDOWS__
@@ -472,6 +511,14 @@ namespace Core {
         {
             return (IDENTIFIER);
         }
+        virtual uint32_t Sequence() const
+        {
+            return (_sequence);
+        }
+        virtual void Sequence(const uint32_t sequence)
+        {
+            _sequence = sequence;
+        }
         virtual ProxyType<IMessage> IParameters()
         {
             return ProxyType<IMessage>(&_parameters, &_parameters);
@@ -489,6 +536,7 @@ namespace Core {
     private:
         RawSerializedType<PARAMETERS, (IDENTIFIER << 1)> _parameters;
         RawSerializedType<RESPONSE, ((IDENTIFIER << 1) | 0x1)> _response;
+        uint32_t _sequence;
     };
 
     class EXTERNAL IPCChannel {
@@ -504,11 +552,53 @@ namespace Core {
             IPCFactory(const IPCFactory& copy) = delete;
             IPCFactory& operator=(const IPCFactory&) = delete;
 
+            // Outbound calls that have been submitted but not yet responded to, keyed
+            // on the sequence number that is tagged onto the frames of both the call
+            // and its response. This allows multiple calls to be in flight on a single
+            // channel, while the responses can be matched back in any order.
+            class Outbound {
+            public:
+                Outbound() = delete;
+                Outbound& operator=(const Outbound&) = delete;
+
+                Outbound(const Core::ProxyType<IIPC>& message, IDispatchType<IIPC>* callback)
+                    : _message(message)
+                    , _callback(callback)
+                {
+                }
+                Outbound(const Outbound& copy)
+                    : _message(copy._message)
+                    , _callback(copy._callback)
+                {
+                }
+                ~Outbound()
+                {
+                }
+
+            public:
+                inline Core::ProxyType<IIPC>& Message()
+                {
+                    return (_message);
+                }
+                inline void Dispatch()
+                {
+                    if (_callback != nullptr) {
+                        _callback->Dispatch(*_message);
+                    }
+                }
+
+            private:
+                Core::ProxyType<IIPC> _message;
+                IDispatchType<IIPC>* _callback;
+            };
+
+            typedef std::map<uint32_t, Outbound> OutboundMap;
+
             IPCFactory()
                 : _lock()
                 , _inbound()
                 , _outbound()
-                , _callback(nullptr)
+                , _sequence(0)
                 , _factory()
                 , _handlers()
             {
@@ -521,11 +611,11 @@ namespace Core {
             }
 
         public:
-            IPCFactory(Core::ProxyType<FactoryType<IIPC, uint32_t>>& factory)
+            IPCFactory(Core::ProxyType<FactoryType<IIPC, uint32_t>>& factory, const uint32_t sequence = 0)
                 : _lock()
                 , _inbound()
                 , _outbound()
-                , _callback(nullptr)
+                , _sequence(sequence & 0x1FFFFFFF)
                 , _factory(factory)
                 , _handlers()
             {
@@ -546,6 +636,7 @@ namespace Core {
                 }
 
                 _handlers.clear();
+                _outbound.clear();
             }
 
         public:
@@ -578,10 +669,27 @@ namespace Core {
 
             inline bool InProgress() const
             {
-                return (_outbound.IsValid());
+                _lock.Lock();
+
+                bool result = (_outbound.empty() == false);
+
+                _lock.Unlock();
+
+                return (result);
             }
 
-            inline ProxyType<IMessage> Element(const uint32_t& identifier)
+            inline uint32_t Pending() const
+            {
+                _lock.Lock();
+
+                uint32_t result = static_cast<uint32_t>(_outbound.size());
+
+                _lock.Unlock();
+
+                return (result);
+            }
+
+            inline ProxyType<IMessage> Element(const uint32_t& identifier, const uint32_t sequence)
             {
                 ProxyType<IMessage> result;
                 uint32_t searchIdentifier(identifier >> 1);
@@ -589,10 +697,12 @@ namespace Core {
                 _lock.Lock();
 
                 if (identifier & 0x01) {
-                    if ((_outbound.IsValid() == true) && (_outbound->Label() == searchIdentifier)) {
-                        result = _outbound->IResponse();
+                    OutboundMap::iterator index(_outbound.find(sequence));
+
+                    if ((index != _outbound.end()) && (index->second.Message()->Label() == searchIdentifier)) {
+                        result = index->second.Message()->IResponse();
                     } else {
-                        TRACE_L1("Unexpected response message for ID [%d].\n", searchIdentifier);
+                        TRACE_L1("Unexpected response message for ID [%d], sequence [%d].\n", searchIdentifier, sequence);
                     }
                 } else {
                     ASSERT(_inbound.IsValid() == false);
@@ -600,6 +710,9 @@ namespace Core {
                     ProxyType<IIPC> rpcCall(_factory->Element(searchIdentifier));
 
                     if (rpcCall.IsValid() == true) {
+                        // The response must be tagged with the same sequence so the
+                        // caller on the otherside can match it to its request.
+                        rpcCall->Sequence(sequence);
                         _inbound = rpcCall;
                         result = rpcCall->IParameters();
                     } else {
@@ -618,11 +731,8 @@ namespace Core {
 
                 TRACE_L1("Flushing the IPC mechanims. %d", __LINE__);
 
-                _callback = nullptr;
+                _outbound.clear();
 
-                if (_outbound.IsValid() == true) {
-                    _outbound.Release();
-                }
                 if (_inbound.IsValid() == true) {
                     _inbound.Release();
                 }
@@ -636,17 +746,16 @@ namespace Core {
 
                 _lock.Lock();
 
-                if ((_outbound.IsValid() == true) && (_outbound->IResponse() == rhs)) {
+                OutboundMap::iterator index(_outbound.find(rhs->Sequence()));
 
-                    ASSERT(_callback != nullptr);
+                if ((index != _outbound.end()) && (index->second.Message()->IResponse() == rhs)) {
 
-                    ProxyType<IIPC> handledObject(_outbound);
+                    Outbound handledObject(index->second);
 
-                    _outbound.Release();
-                    _callback->Dispatch(*handledObject);
-                    _callback = nullptr;
+                    _outbound.erase(index);
+                    handledObject.Dispatch();
                 }
-                // If this is *NOT* the outbound call, it is inbound and thus it must have been registered
+                // If this is *NOT* an outbound call, it is inbound and thus it must have been registered
                 else if (_inbound.IsValid() == true) {
 
                     std::map<uint32_t, ProxyType<IIPCServer>>::iterator index(_handlers.find(_inbound->Label()));
@@ -670,37 +779,73 @@ namespace Core {
                 return (procedure);
             }
 
-            inline void SetOutbound(const Core::ProxyType<IIPC>& outbound, IDispatchType<IIPC>* callback)
+            inline bool SetOutbound(const Core::ProxyType<IIPC>& outbound, IDispatchType<IIPC>* callback)
             {
+                bool result = false;
+
                 _lock.Lock();
 
                 ASSERT((outbound.IsValid() == true) && (callback != nullptr));
-                ASSERT((_outbound.IsValid() == false) && (_callback == nullptr));
 
-                _outbound = outbound;
-                _callback = callback;
+                // The same message can not be in flight twice, its sequence identifies the call.
+                OutboundMap::iterator index(_outbound.find(outbound->Sequence()));
+
+                if ((index == _outbound.end()) || (index->second.Message() != outbound)) {
+
+                    // Skip sequence 0 and any sequence still in use by a (very) long running call. Only 29 bits
+                    // of the sequence are carried in a frame, so it wraps within those.
+                    do {
+                        _sequence = (_sequence + 1) & 0x1FFFFFFF;
+                    } while ((_sequence == 0) || (_outbound.find(_sequence) != _outbound.end()));
+
+                    outbound->Sequence(_sequence);
+                    _outbound.insert(std::pair<uint32_t, Outbound>(_sequence, Outbound(outbound, callback)));
+
+                    result = true;
+                }
 
                 _lock.Unlock();
+
+                return (result);
             }
 
-            inline bool AbortOutbound()
+            inline bool AbortOutbound(const Core::ProxyType<IIPC>& outbound)
             {
                 bool result = false;
 
                 _lock.Lock();
 
-                if (_outbound.IsValid() == true) {
+                OutboundMap::iterator index(_outbound.find(outbound->Sequence()));
+
+                if ((index != _outbound.end()) && (index->second.Message() == outbound)) {
+
+                    Outbound handledObject(index->second);
 
                     result = true;
 
-                    if (_callback != nullptr) {
-                        _callback->Dispatch(*_outbound);
-                        _callback = nullptr;
-                    }
+                    _outbound.erase(index);
+                    handledObject.Dispatch();
+                }
 
-                    _outbound.Release();
-                } else {
-                    ASSERT(_callback == nullptr);
+                _lock.Unlock();
+
+                return (result);
+            }
+
+            inline bool AbortOutbound()
+            {
+                bool result = false;
+
+                _lock.Lock();
+
+                while (_outbound.empty() == false) {
+
+                    Outbound handledObject(_outbound.begin()->second);
+
+                    result = true;
+
+                    _outbound.erase(_outbound.begin());
+                    handledObject.Dispatch();
                 }
 
                 _lock.Unlock();
@@ -711,8 +856,8 @@ namespace Core {
         private:
             mutable CriticalSection _lock;
             Core::ProxyType<IIPC> _inbound;
-            mutable Core::ProxyType<IIPC> _outbound;
-            IDispatchType<IIPC>* _callback;
+            OutboundMap _outbound;
+            uint32_t _sequence;
             Core::ProxyType<FactoryType<IIPC, uint32_t>> _factory;
             std::map<uint32_t, ProxyType<IIPCServer>> _handlers;
         };
@@ -891,8 +1036,9 @@ namespace Core {
             IPCTrigger& operator=(const IPCTrigger&) = delete;
 
         public:
-            IPCTrigger(IPCFactory& administration)
+            IPCTrigger(IPCFactory& administration, ProxyType<IIPC>& command)
                 : _administration(administration)
+                , _command(command)
                 , _signal(false, true)
             {
             }
@@ -907,10 +1053,10 @@ namespace Core {
 
                 // Now we wait for ever, to get a signal that we are done :-)
                 if (_signal.Lock(waitTime) != Core::ERROR_NONE) {
-                    _administration.AbortOutbound();
+                    _administration.AbortOutbound(_command);
 
                     result = Core::ERROR_TIMEDOUT;
-                } else if (_administration.AbortOutbound() == true) {
+                } else if (_administration.AbortOutbound(_command) == true) {
                     result = Core::ERROR_ASYNC_FAILED;
                 }
 
@@ -923,6 +1069,7 @@ namespace Core {
 
         private:
             IPCFactory& _administration;
+            ProxyType<IIPC>& _command;
             Event _signal;
         };
 
@@ -1029,6 +1176,10 @@ namespace Core {
         {
             return (_administration.InProgress());
         }
+        inline uint32_t Pending() const
+        {
+            return (_administration.Pending());
+        }
         virtual uint32_t ReportResponse(Core::ProxyType<IIPC>& inbound)
         {
 
@@ -1064,46 +1215,42 @@ namespace Core {
         {
             uint32_t success = Core::ERROR_UNAVAILABLE;
 
-            _serialize.Lock();
-
-            if (_administration.InProgress() == true) {
-                success = Core::ERROR_INPROGRESS;
-            } else if (_link.IsOpen() == true) {
+            if (_link.IsOpen() == true) {
                 // We need to accept a CONST object to avoid an additional object creation
                 // proxy casted objects.
-                _administration.SetOutbound(command, completed);
-
-                // Send out the
-                _link.Submit(command->IParameters());
+                if (_administration.SetOutbound(command, completed) == false) {
+                    success = Core::ERROR_INPROGRESS;
+                } else {
+                    // Send out the
+                    _link.Submit(command->IParameters());
 
-                success = Core::ERROR_NONE;
+                    success = Core::ERROR_NONE;
+                }
             }
 
-            _serialize.Unlock();
-
             return (success);
         }
         virtual uint32_t Execute(ProxyType<IIPC>& command, const uint32_t waitTime)
         {
             uint32_t success = Core::ERROR_CONNECTION_CLOSED;
 
-            _serialize.Lock();
-
+            // No need to serialize the callers, every call is tagged with its own sequence
+            // so multiple calls can be in flight on this channel simultaneously.
             if (_link.IsOpen() == true) {
-                IPCTrigger sink(_administration);
+                IPCTrigger sink(_administration, command);
 
                 // We need to accept a CONST object to avoid an additional object creation
                 // proxy casted objects.
-                _administration.SetOutbound(command, &sink);
-
-                // Send out the
-                _link.Submit(command->IParameters());
+                if (_administration.SetOutbound(command, &sink) == false) {
+                    success = Core::ERROR_INPROGRESS;
+                } else {
+                    // Send out the
+                    _link.Submit(command->IParameters());
 
-                success = sink.Wait(waitTime);
+                    success = sink.Wait(waitTime);
+                }
             }
 
-            _serialize.Unlock();
-
             return (success);
         }
         inline void CallProcedure(ProxyType<IIPCServer>& procedure, ProxyType<IIPC>& message)
@@ -1112,7 +1259,6 @@ namespace Core {
         }
 
     private:
-        CriticalSection _serialize;
         IPCLink _link;
         EXTENSION _extension;
     };
@@ -23,6 +23,12 @@
 #include <map>
 #include <vector>
 
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__AVX2__))
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "Enumerate.h"
 #include "FileSystem.h"
 #include "Number.h"
@@ -87,27 +93,43 @@ namespace Core {
 
             static char NullTag[];
 
+            // Initial amount of space a direct serialization (ToString) starts with.
+            static constexpr uint32_t DirectChunkSize = 1024;
+
             virtual ~IElement() {}
 
+            // Serialize straight into the string. The elements can resume where they left
+            // off, so if the text does not fit, the space is doubled and serialization
+            // continues at the end of what was written. Typically the first pass does it all.
             template <typename INSTANCEOBJECT>
             static bool ToString(const INSTANCEOBJECT& realObject, string& text)
             {
-                char buffer[1024];
-                uint16_t loaded;
-                uint16_t offset = 0;
+                uint32_t offset = 0;
+                size_t used = 0;
+                size_t space = std::max(text.capacity(), static_cast<size_t>(DirectChunkSize));
 
                 text.clear();
 
-                // Serialize object
                 do {
-                    loaded = static_cast<const IElement&>(realObject).Serialize(buffer, sizeof(buffer), offset);
+                    ASSERT(space <= NUMBER_MAX_UNSIGNED(uint32_t));
 
-                    ASSERT(loaded <= sizeof(buffer));
-                    DEBUG_VARIABLE(loaded);
+                    text.resize(used + space);
+
+                    uint32_t loaded = static_cast<const IElement&>(realObject).Serialize(&(text[used]), static_cast<uint32_t>(space), offset);
+
+                    ASSERT(loaded <= space);
+
+                    used += loaded;
+
+                    if (loaded != space) {
+                        break;
+                    }
 
-                    text += string(buffer, loaded);
+                    space = std::min(2 * space, static_cast<size_t>(NUMBER_MAX_UNSIGNED(uint32_t)));
 
-                } while ((offset != 0) && (loaded == sizeof(buffer)));
+                } while (offset != 0);
+
+                text.resize(used);
 
                 return (offset == 0);
             }
@@ -122,13 +144,13 @@ namespace Core {
             template <typename INSTANCEOBJECT>
             static bool FromString(const string& text, INSTANCEOBJECT& realObject, Core::OptionalType<Error>& error)
             {
-                uint16_t offset = 0;
+                uint32_t offset = 0;
 
                 realObject.Clear();
 
                 if (text.empty() == false) {
                     // Deserialize object
-                    uint16_t loaded = static_cast<IElement&>(realObject).Deserialize(text.c_str(), static_cast<uint16_t>(text.length() + 1), offset, error);
+                    uint32_t loaded = static_cast<IElement&>(realObject).Deserialize(text.c_str(), static_cast<uint32_t>(text.length() + 1), offset, error);
 
                     ASSERT(loaded <= (text.length() + 1));
                     DEBUG_VARIABLE(loaded);
@@ -170,8 +192,8 @@ namespace Core {
                 if (fileObject.IsOpen()) {
 
                     char buffer[1024];
-                    uint16_t loaded;
-                    uint16_t offset = 0;
+                    uint32_t loaded;
+                    uint32_t offset = 0;
 
                     // Serialize object
                     do {
@@ -200,15 +222,15 @@ namespace Core {
                 if (fileObject.IsOpen()) {
 
                     char buffer[1024];
-                    uint16_t readBytes;
-                    uint16_t loaded;
-                    uint16_t offset = 0;
+                    uint32_t readBytes;
+                    uint32_t loaded;
+                    uint32_t offset = 0;
 
                     realObject.Clear();
 
                     // Serialize object
                     do {
-                        readBytes = static_cast<uint16_t>(fileObject.Read(reinterpret_cast<uint8_t*>(buffer), sizeof(buffer)));
+                        readBytes = static_cast<uint32_t>(fileObject.Read(reinterpret_cast<uint8_t*>(buffer), sizeof(buffer)));
 
                         if (readBytes == 0) {
                             loaded = ~0;
@@ -258,11 +280,11 @@ namespace Core {
             virtual void Clear() = 0;
             virtual bool IsSet() const = 0;
             virtual bool IsNull() const = 0;
-            virtual uint16_t Serialize(char Stream[], const uint16_t MaxLength, uint16_t& offset) const = 0;
-            uint16_t Deserialize(const char Stream[], const uint16_t MaxLength, uint16_t& offset)
+            virtual uint32_t Serialize(char Stream[], const uint32_t MaxLength, uint32_t& offset) const = 0;
+            uint32_t Deserialize(const char Stream[], const uint32_t MaxLength, uint32_t& offset)
             {
                 Core::OptionalType<Error> error;
-                uint16_t loaded = Deserialize(Stream, MaxLength, offset, error);
+                uint32_t loaded = Deserialize(Stream, MaxLength, offset, error);
 
                 if (error.IsSet() == true) {
                     Clear();
@@ -272,7 +294,7 @@ namespace Core {
 
                 return loaded;
             }
-            virtual uint16_t Deserialize(const char Stream[], const uint16_t MaxLength, uint16_t& offset, Core::OptionalType<Error>& error) = 0;
+            virtual uint32_t Deserialize(const char Stream[], const uint32_t MaxLength, uint32_t& offset, Core::OptionalType<Error>& error) = 0;
         };
 
         struct EXTERNAL IMessagePack {
@@ -280,37 +302,49 @@ namespace Core {
 
             static constexpr uint8_t NullValue = 0xC0;
 
+            // Same approach as IElement::ToString, the vector is the serialization buffer.
             template <typename INSTANCEOBJECT>
             static bool ToBuffer(std::vector<uint8_t>& stream, const INSTANCEOBJECT& realObject)
             {
-                uint8_t buffer[1024];
-                uint16_t loaded;
-                uint16_t offset = 0;
+                uint32_t offset = 0;
+                size_t used = 0;
+                size_t space = std::max(stream.capacity(), static_cast<size_t>(IElement::DirectChunkSize));
 
                 stream.clear();
-                // Serialize object
+
                 do {
-                    loaded = static_cast<const IMessagePack&>(realObject).Serialize(buffer, sizeof(buffer), offset);
+                    ASSERT(space <= NUMBER_MAX_UNSIGNED(uint32_t));
 
-                    ASSERT(loaded <= sizeof(buffer));
-                    DEBUG_VARIABLE(loaded);
+                    stream.resize(used + space);
+
+                    uint32_t loaded = static_cast<const IMessagePack&>(realObject).Serialize(&(stream[used]), static_cast<uint32_t>(space), offset);
+
+                    ASSERT(loaded <= space);
+
+                    used += loaded;
+
+                    if (loaded != space) {
+                        break;
+                    }
 
-                    stream.reserve(stream.size() + loaded);
-                    stream.insert(stream.end(), buffer, buffer + loaded);
-                } while ((offset != 0) && (loaded == sizeof(buffer)));
+                    space = std::min(2 * space, static_cast<size_t>(NUMBER_MAX_UNSIGNED(uint32_t)));
+
+                } while (offset != 0);
+
+                stream.resize(used);
 
                 return (offset == 0);
             }
             template <typename INSTANCEOBJECT>
             static bool FromBuffer(const std::vector<uint8_t>& stream, INSTANCEOBJECT& realObject)
             {
-                uint16_t offset = 0;
+                uint32_t offset = 0;
 
                 realObject.Clear();
 
                 if (stream.size() != 0) {
                     // Deserialize object
-                    uint16_t loaded = static_cast<IMessagePack&>(realObject).Deserialize(&stream[0], static_cast<uint16_t>(stream.size() + 1), offset);
+                    uint32_t loaded = static_cast<IMessagePack&>(realObject).Deserialize(&stream[0], static_cast<uint32_t>(stream.size() + 1), offset);
 
                     ASSERT(loaded <= (stream.size() + 1));
                     DEBUG_VARIABLE(loaded);
@@ -331,8 +365,8 @@ namespace Core {
                 if (fileObject.IsOpen()) {
 
                     uint8_t buffer[1024];
-                    uint16_t loaded;
-                    uint16_t offset = 0;
+                    uint32_t loaded;
+                    uint32_t offset = 0;
 
                     // Serialize object
                     do {
@@ -357,15 +391,15 @@ namespace Core {
                 if (fileObject.IsOpen()) {
 
                     uint8_t buffer[1024];
-                    uint16_t readBytes;
-                    uint16_t loaded;
-                    uint16_t offset = 0;
+                    uint32_t readBytes;
+                    uint32_t loaded;
+                    uint32_t offset = 0;
 
                     realObject.Clear();
 
                     // Serialize object
                     do {
-                        readBytes = static_cast<uint16_t>(fileObject.Read(reinterpret_cast<uint8_t*>(buffer), sizeof(buffer)));
+                        readBytes = static_cast<uint32_t>(fileObject.Read(reinterpret_cast<uint8_t*>(buffer), sizeof(buffer)));
 
                         if (readBytes == 0) {
                             loaded = ~0;
@@ -415,8 +449,70 @@ namespace Core {
             virtual void Clear() = 0;
             virtual bool IsSet() const = 0;
             virtual bool IsNull() const = 0;
-            virtual uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const = 0;
-            virtual uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) = 0;
+            virtual uint32_t Serialize(uint8_t stream[], const uint32_t maxLength, uint32_t& offset) const = 0;
+            virtual uint32_t Deserialize(const uint8_t stream[], const uint32_t maxLength, uint32_t& offset) = 0;
+        };
+
+        // Text in a JSON string is mostly plain, only quotes and backslashes need a closer
+        // look. Plain() returns the first of those in [begin, end), or end if there is none.
+        // Where the compiler targets it, 32 (AVX2) or 16 (SSE2, NEON) characters are checked
+        // at once, the remainder, and any other target, goes through PlainScalar().
+        struct Scanner {
+            static const char* PlainScalar(const char* begin, const char* end)
+            {
+                while ((begin < end) && (*begin != '\"') && (*begin != '\\')) {
+                    begin++;
+                }
+                return (begin);
+            }
+
+            static const char* Plain(const char* begin, const char* end)
+            {
+#if defined(__GNUC__) && defined(__AVX2__)
+                const __m256i quote = _mm256_set1_epi8('\"');
+                const __m256i backslash = _mm256_set1_epi8('\\');
+
+                while ((end - begin) >= 32) {
+                    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+                    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash))));
+
+                    if (mask != 0) {
+                        return (begin + __builtin_ctz(mask));
+                    }
+                    begin += 32;
+                }
+#endif
+#if defined(__GNUC__) && defined(__SSE2__)
+                const __m128i quote16 = _mm_set1_epi8('\"');
+                const __m128i backslash16 = _mm_set1_epi8('\\');
+
+                while ((end - begin) >= 16) {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+                    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote16), _mm_cmpeq_epi8(chunk, backslash16))));
+
+                    if (mask != 0) {
+                        return (begin + __builtin_ctz(mask));
+                    }
+                    begin += 16;
+                }
+#elif defined(__GNUC__) && defined(__ARM_NEON)
+                const uint8x16_t quote = vdupq_n_u8('\"');
+                const uint8x16_t backslash = vdupq_n_u8('\\');
+
+                while ((end - begin) >= 16) {
+                    const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(begin));
+                    const uint8x16_t match = vorrq_u8(vceqq_u8(chunk, quote), vceqq_u8(chunk, backslash));
+                    // Narrow every byte of the match to a nibble, so the 16 results fit in 64 bits.
+                    const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+
+                    if (mask != 0) {
+                        return (begin + (__builtin_ctzll(mask) >> 2));
+                    }
+                    begin += 16;
+                }
+#endif
+                return (PlainScalar(begin, end));
+            }
         };
 
         enum class ValueValidity : int8_t {
@@ -426,7 +522,7 @@ namespace Core {
             VALID
         };
 
-        static ValueValidity IsNullValue(const char stream[], const uint16_t maxLength, uint16_t& offset, uint16_t& loaded)
+        static ValueValidity IsNullValue(const char stream[], const uint32_t maxLength, uint32_t& offset, uint32_t& loaded)
         {
             ValueValidity validity = ValueValidity::INVALID;
             const size_t nullTagLen = strlen(IElement::NullTag);
@@ -547,9 +643,9 @@ namespace Core {
         private:
             // IElement iface:
             // If this should be serialized/deserialized, it is indicated by a MinSize > 0)
-            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(char stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
                 ASSERT(maxLength > 0);
 
@@ -610,9 +706,9 @@ namespace Core {
                 return (loaded);
             }
 
-            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error) override
+            uint32_t Deserialize(const char stream[], const uint32_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error) override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
                 if (offset == 0) {
                     // We are starting, see what the current char is
@@ -740,7 +836,7 @@ namespace Core {
             }
 
             // IMessagePack iface:
-            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(uint8_t stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
                 if ((_set & UNDEFINED) != 0) {
                     stream[0] = IMessagePack::NullValue;
@@ -749,7 +845,7 @@ namespace Core {
                 return (Convert(stream, maxLength, offset, TemplateIntToType<SIGNED>()));
             }
 
-            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override
+            uint32_t Deserialize(const uint8_t stream[], const uint32_t maxLength, uint32_t& offset) override
             {
                 uint8_t loaded = 0;
                 if (offset == 0) {
@@ -787,10 +883,34 @@ namespace Core {
                 return (loaded);
             }
 
-            uint16_t Convert(char stream[], const uint16_t maxLength, uint16_t& offset, const TYPE serialize) const
+            uint32_t Convert(char stream[], const uint32_t maxLength, uint32_t& offset, const TYPE serialize) const
             {
                 uint8_t parsed = 4;
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
+
+                if ((offset == 4) && (maxLength >= (sizeof(TYPE) * 3))) {
+                    // It fits for sure, write it out back to front in one go..
+                    char digits[sizeof(TYPE) * 3];
+                    uint8_t index = sizeof(digits);
+                    TYPE value = serialize;
+
+                    do {
+                        uint8_t digit = static_cast<uint8_t>(value % BASETYPE);
+                        digits[--index] = ((BASETYPE != BASE_HEXADECIMAL) || (digit < 10) ? static_cast<char>('0' + digit) : static_cast<char>('A' - 10 + digit));
+                        value /= BASETYPE;
+                    } while (value != 0);
+
+                    loaded = sizeof(digits) - index;
+                    ::memcpy(stream, &(digits[index]), loaded);
+                    offset += loaded;
+
+                    if ((BASETYPE == BASE_DECIMAL) && (loaded < maxLength)) {
+                        offset = 0;
+                    }
+
+                    return (loaded);
+                }
+
                 TYPE divider = 1;
                 TYPE value = (serialize / BASETYPE);
 
@@ -822,17 +942,17 @@ namespace Core {
                 return (loaded);
             }
 
-            uint16_t Convert(char stream[], const uint16_t maxLength, uint16_t& offset, const TemplateIntToType<false>& /* For compile time diffrentiation */) const
+            uint32_t Convert(char stream[], const uint32_t maxLength, uint32_t& offset, const TemplateIntToType<false>& /* For compile time diffrentiation */) const
             {
                 return (Convert(stream, maxLength, offset, _value));
             }
 
-            uint16_t Convert(char stream[], const uint16_t maxLength, uint16_t& offset, const TemplateIntToType<true>& /* For c ompile time diffrentiation */) const
+            uint32_t Convert(char stream[], const uint32_t maxLength, uint32_t& offset, const TemplateIntToType<true>& /* For c ompile time diffrentiation */) const
             {
                 return (Convert(stream, maxLength, offset, ::abs(_value)));
             }
 
-            uint16_t Convert(uint8_t stream[], const uint16_t maxLength, uint16_t& offset, const TemplateIntToType<false>& /* For compile time diffrentiation */) const
+            uint32_t Convert(uint8_t stream[], const uint32_t maxLength, uint32_t& offset, const TemplateIntToType<false>& /* For compile time diffrentiation */) const
             {
                 uint8_t loaded = 0;
                 uint8_t bytes = (_value <= 0x7F ? 0 : _value < 0xFF ? 1 : _value < 0xFFFF ? 2 : _value < 0xFFFFFFFF ? 4 : 8);
@@ -875,7 +995,7 @@ namespace Core {
                 return (loaded);
             }
 
-            uint16_t Convert(uint8_t stream[], const uint16_t maxLength, uint16_t& offset, const TemplateIntToType<true>& /* For c ompile time diffrentiation */) const
+            uint32_t Convert(uint8_t stream[], const uint32_t maxLength, uint32_t& offset, const TemplateIntToType<true>& /* For c ompile time diffrentiation */) const
             {
                 uint8_t loaded = 0;
                 uint8_t bytes = (((_value < 16) && (_value > -15)) ? 0 : ((_value < 128) && (_value > -127)) ? 1 : ((_value < 32767) && (_value > -32766)) ? 2 : ((_value < 2147483647) && (_value > -2147483646)) ? 4 : 8);
@@ -1041,9 +1161,9 @@ namespace Core {
         private:
             // IElement iface:
             // If this should be serialized/deserialized, it is indicated by a MinSize > 0)
-            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(char stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
                 ASSERT(maxLength > 0);
 
@@ -1067,9 +1187,9 @@ namespace Core {
                 return loaded;
             }
             
-            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error) override
+            uint32_t Deserialize(const char stream[], const uint32_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error) override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
                 if (offset == 0) {
                     _value = 0;
@@ -1130,7 +1250,7 @@ namespace Core {
             // IMessagePack iface:
             // Refer to https://github.com/msgpack/msgpack/blob/master/spec.md#float-format-family 
             // for MessagePack format for float.
-            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(uint8_t stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
                 if ((_set & UNDEFINED) != 0 || 
                     std::isinf(_value) ||
@@ -1140,7 +1260,7 @@ namespace Core {
                     return (1);
                 }
 
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
                 uint8_t bytes = std::is_same<float,TYPE>::value ? 4 : 8;
 
                 if (offset == 0) {
@@ -1166,9 +1286,9 @@ namespace Core {
                 return loaded;
             }
 
-            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override
+            uint32_t Deserialize(const uint8_t stream[], const uint32_t maxLength, uint32_t& offset) override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
                 int bytes = 0;
                 if (offset == 0) {
                     // First byte depicts a lot. Find out what we need to read
@@ -1295,12 +1415,12 @@ namespace Core {
 
         private:
             // IElement iface:
-            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(char stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
                 static constexpr char trueBuffer[] = "true";
                 static constexpr char falseBuffer[] = "false";
 
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
                 if ((_value & NullBit) != 0) {
                     while ((loaded < maxLength) && (offset < 4)) {
                         stream[loaded++] = NullTag[offset++];
@@ -1326,9 +1446,9 @@ namespace Core {
                 return (loaded);
             }
 
-            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error) override
+            uint32_t Deserialize(const char stream[], const uint32_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error) override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
                 static constexpr char trueBuffer[] = "true";
                 static constexpr char falseBuffer[] = "false";
 
@@ -1379,7 +1499,7 @@ namespace Core {
             }
 
             // IMessagePack iface:
-            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(uint8_t stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
                 if ((_value & NullBit) != 0) {
                     stream[0] = IMessagePack::NullValue;
@@ -1391,7 +1511,7 @@ namespace Core {
                 return (1);
             }
 
-            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override
+            uint32_t Deserialize(const uint8_t stream[], const uint32_t maxLength, uint32_t& offset) override
             {
                 if ((stream[0] == IMessagePack::NullValue) != 0) {
                     _value = NullBit;
@@ -1623,16 +1743,16 @@ namespace Core {
             }
 
             // IElement iface:
-            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(char stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
                 bool quoted = IsQuoted();
-                uint16_t result = 0;
+                uint32_t result = 0;
 
                 ASSERT(maxLength > 0);
 
                 if ((quoted == false) || ((_scopeCount & NullBit) != 0)) {
                     std::string source((_value.empty() || (_scopeCount & NullBit)) ? NullTag : _value);
-                    result = static_cast<uint16_t>(source.copy(stream, maxLength - result, offset));
+                    result = static_cast<uint32_t>(source.copy(stream, maxLength - result, offset));
                     offset = (result < maxLength ? 0 : offset + result);
                 } else {
                     if (offset == 0) {
@@ -1642,7 +1762,7 @@ namespace Core {
                         _unaccountedCount = 0;
                     }
 
-                    uint16_t length = static_cast<uint16_t>(_value.length()) - (offset - 1);
+                    uint32_t length = static_cast<uint32_t>(_value.length()) - (offset - 1);
                     if (length > 0) {
                         const TCHAR* source = &(_value[offset - 1]);
                         offset += length;
@@ -1651,9 +1771,20 @@ namespace Core {
 
                             // See where we are and add...
                             if ((*source != '\"') || (_unaccountedCount == 1)) {
+                                uint32_t run = 1;
+
+                                if (_unaccountedCount == 0) {
+                                    // Everything up to the next quote goes in one go..
+                                    const uint32_t room = std::min(length, maxLength - result);
+                                    const char* quote = static_cast<const char*>(::memchr(source, '\"', room));
+                                    run = (quote == nullptr ? room : static_cast<uint32_t>(quote - source));
+                                }
+
                                 _unaccountedCount = 0;
-                                stream[result++] = *source++;
-                                length--;
+                                ::memcpy(&(stream[result]), source, run);
+                                result += run;
+                                source += run;
+                                length -= run;
                             } else {
                                 // Check if we need to escape...
                                 if(*(source - 1) != '\\')
@@ -1682,10 +1813,10 @@ namespace Core {
                 return (result);
             }
 
-            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error) override
+            uint32_t Deserialize(const char stream[], const uint32_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error) override
             {
                 bool finished = false;
-                uint16_t result = 0;
+                uint32_t result = 0;
                 ASSERT(maxLength > 0);
 
                 if (offset == 0) {
@@ -1704,6 +1835,18 @@ namespace Core {
                 // Might be that the last character we added was a
                 while ((result < maxLength) && (finished == false)) {
 
+                    if ((escapedSequence == false) && ((_scopeCount & QuoteFoundBit) != 0)) {
+                        // Within quotes, only a quote or backslash changes anything, the rest is copied as is.
+                        const char* begin = &(stream[result]);
+                        const uint32_t plain = static_cast<uint32_t>(Scanner::Plain(begin, &(stream[maxLength])) - begin);
+
+                        if (plain != 0) {
+                            _value.append(begin, plain);
+                            result += plain;
+                            continue;
+                        }
+                    }
+
                     TCHAR current = stream[result];
 
                     if (escapedSequence == false) {
@@ -1793,7 +1936,7 @@ namespace Core {
                 }
 
                 if (finished == false) {
-                    offset = static_cast<uint16_t>(_value.length()) + _unaccountedCount;
+                    offset = static_cast<uint32_t>(_value.length()) + _unaccountedCount;
                 } else {
                     offset = 0;
                     _scopeCount |= ((_scopeCount & QuoteFoundBit) ? SetBit : (_value == NullTag ? NullBit : SetBit));
@@ -1803,9 +1946,9 @@ namespace Core {
             }
 
             // IMessagePack iface:
-            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(uint8_t stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
                 if (offset == 0) {
                     if ((_scopeCount & NullBit) != 0) {
                         stream[loaded++] = IMessagePack::NullValue;
@@ -1822,7 +1965,9 @@ namespace Core {
                         stream[loaded++] = 0xDA;
                         offset++;
                     } else {
-                        stream[loaded++] = IMessagePack::NullValue;
+                        _unaccountedCount = 5;
+                        stream[loaded++] = 0xDB;
+                        offset++;
                     }
                 }
 
@@ -1832,9 +1977,9 @@ namespace Core {
                         offset++;
                     }
 
-                    uint16_t copied = 0;
+                    uint32_t copied = 0;
                     while ((loaded < maxLength) && (offset != 0)) {
-                        copied = static_cast<uint16_t>(_value.copy(reinterpret_cast<char*>(&stream[loaded]), (maxLength - loaded), offset - _unaccountedCount));
+                        copied = static_cast<uint32_t>(_value.copy(reinterpret_cast<char*>(&stream[loaded]), (maxLength - loaded), offset - _unaccountedCount));
                         offset += copied;
                         loaded += copied;
                         if (_unaccountedCount) {
@@ -1851,43 +1996,50 @@ namespace Core {
                 return (loaded);
             }
 
-            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override
+            uint32_t Deserialize(const uint8_t stream[], const uint32_t maxLength, uint32_t& offset) override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
                 if (offset == 0) {
                     _value.clear();
                     if (stream[loaded] == IMessagePack::NullValue) {
                         _scopeCount |= NullBit;
                         loaded++;
-                    } else if ((stream[loaded] & 0xA0) == 0xA0) {
-                        _unaccountedCount = stream[loaded] & 0x1F;
-                        offset = 3;
-                        loaded++;
                     } else if (stream[loaded] == 0xD9) {
                         _unaccountedCount = 0;
-                        offset = 2;
+                        offset = 4;
                         loaded++;
                     } else if (stream[loaded] == 0xDA) {
+                        _unaccountedCount = 0;
+                        offset = 3;
+                        loaded++;
+                    } else if (stream[loaded] == 0xDB) {
                         _unaccountedCount = 0;
                         offset = 1;
                         loaded++;
+                    } else if ((stream[loaded] & 0xE0) == 0xA0) {
+                        _unaccountedCount = stream[loaded] & 0x1F;
+                        offset = 5;
+                        loaded++;
                     } else {
                         loaded = maxLength;
                     }
                 }
 
                 if (offset != 0) {
-                    while ((loaded < maxLength) && (offset < 3)) {
+                    // Offset 1..4 are the (big endian) length bytes still to go, from 5 on the payload.
+                    while ((loaded < maxLength) && (offset < 5)) {
                         _unaccountedCount = (_unaccountedCount << 8) + stream[loaded++];
                         offset++;
                     }
 
-                    while ((loaded < maxLength) && ((offset - 3) < static_cast<uint16_t>(_unaccountedCount))) {
-                        _value += static_cast<char>(stream[loaded++]);
-                        offset++;
+                    if ((loaded < maxLength) && ((offset - 5) < _unaccountedCount)) {
+                        uint32_t copied = std::min(maxLength - loaded, _unaccountedCount - (offset - 5));
+                        _value.append(reinterpret_cast<const char*>(&stream[loaded]), copied);
+                        loaded += copied;
+                        offset += copied;
                     }
 
-                    if ((offset >= 3) && (static_cast<uint16_t>(offset - 3) == _unaccountedCount)) {
+                    if ((offset >= 5) && ((offset - 5) == _unaccountedCount)) {
                         offset = 0;
                         _scopeCount |= ((_scopeCount & QuoteFoundBit) ? SetBit : (_value == NullTag ? NullBit : SetBit));
                     }
@@ -2024,13 +2176,13 @@ namespace Core {
 
         protected:
             // IElement iface:
-            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(char stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
                 static const TCHAR base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
                                                     "abcdefghijklmnopqrstuvwxyz"
                                                     "0123456789+/";
 
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
                 if (offset == 0) {
                     _state = 0;
@@ -2084,9 +2236,9 @@ namespace Core {
                 return (loaded);
             }
 
-            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error) override
+            uint32_t Deserialize(const char stream[], const uint32_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error) override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
                 if (offset == 0) {
                     _state = 0xFF;
@@ -2186,41 +2338,46 @@ namespace Core {
             }
 
             // IMessagePack iface:
-            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(uint8_t stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
                 if (offset == 0) {
                     if ((_state & UNDEFINED) != 0) {
                         stream[loaded++] = IMessagePack::NullValue;
                     } else if (_length <= 0xFF) {
                         _index = 0;
                         stream[loaded++] = 0xC4;
-                        offset = 2;
-                    } else {
+                        offset = 4;
+                    } else if (_length <= 0xFFFF) {
                         _index = 0;
                         stream[loaded++] = 0xC5;
+                        offset = 3;
+                    } else {
+                        _index = 0;
+                        stream[loaded++] = 0xC6;
                         offset = 1;
                     }
                 }
 
                 if (offset != 0) {
-                    while ((loaded < maxLength) && (offset < 3)) {
-                        stream[loaded++] = static_cast<uint8_t>((_length >> (8 * (2 - offset))) & 0xFF);
+                    // Offset 1..4 are the (big endian) length bytes still to go, 5 is the payload.
+                    while ((loaded < maxLength) && (offset < 5)) {
+                        stream[loaded++] = static_cast<uint8_t>((_length >> (8 * (4 - offset))) & 0xFF);
                         offset++;
                     }
 
                     while ((loaded < maxLength) && (_index < _length)) {
                         stream[loaded++] = _buffer[_index++];
                     }
-                    offset = (_index == _length);
+                    offset = (_index == _length ? 0 : 5);
                 }
 
                 return (loaded);
             }
 
-            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override
+            uint32_t Deserialize(const uint8_t stream[], const uint32_t maxLength, uint32_t& offset) override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
                 if (offset == 0) {
                     _state = 0;
                     _length = 0;
@@ -2230,9 +2387,12 @@ namespace Core {
                         _state = UNDEFINED;
                         loaded++;
                     } else if (stream[loaded] == 0xC4) {
-                        offset = 2;
+                        offset = 4;
                         loaded++;
                     } else if (stream[loaded] == 0xC5) {
+                        offset = 3;
+                        loaded++;
+                    } else if (stream[loaded] == 0xC6) {
                         offset = 1;
                         loaded++;
                     } else {
@@ -2241,18 +2401,18 @@ namespace Core {
                 }
 
                 if (offset != 0) {
-                    while ((loaded < maxLength) && (offset < 3)) {
+                    while ((loaded < maxLength) && (offset < 5)) {
                         _length = (_length << 8) + stream[loaded++];
                         offset++;
                     }
 
-                    if (offset == 3) {
+                    if (offset == 5) {
                         if (_length > _maxLength) {
                             _maxLength = _length;
                             ::free(_buffer);
                             _buffer = reinterpret_cast<uint8_t*>(::malloc(_maxLength));
                         }
-                        offset = 4;
+                        offset = 6;
                     }
 
                     while ((loaded < maxLength) && (_index < _length)) {
@@ -2270,9 +2430,9 @@ namespace Core {
         private:
             mutable uint8_t _state;
             mutable uint8_t _lastStuff;
-            mutable uint16_t _index;
-            uint16_t _length;
-            uint16_t _maxLength;
+            mutable uint32_t _index;
+            uint32_t _length;
+            uint32_t _maxLength;
             uint8_t* _buffer;
         };
 
@@ -2371,7 +2531,7 @@ namespace Core {
 
         private:
             // IElement iface:
-            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(char stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
                 if (offset == 0) {
                     if ((_state & UNDEFINED) != 0) {
@@ -2383,9 +2543,9 @@ namespace Core {
                 return (static_cast<const IElement&>(_parser).Serialize(stream, maxLength, offset));
             }
 
-            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error) override
+            uint32_t Deserialize(const char stream[], const uint32_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error) override
             {
-                uint16_t result = static_cast<IElement&>(_parser).Deserialize(stream, maxLength, offset, error);
+                uint32_t result = static_cast<IElement&>(_parser).Deserialize(stream, maxLength, offset, error);
 
                 if (offset == 0) {
 
@@ -2412,9 +2572,9 @@ namespace Core {
             }
 
             // IMessagePack iface:
-            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(uint8_t stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
                 if (offset == 0) {
                     if ((_state & UNDEFINED) != 0) {
@@ -2427,9 +2587,9 @@ namespace Core {
                 return (loaded == 0 ? static_cast<const IMessagePack&>(_package).Serialize(stream, maxLength, offset) : loaded);
             }
 
-            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override
+            uint32_t Deserialize(const uint8_t stream[], const uint32_t maxLength, uint32_t& offset) override
             {
-                uint16_t result = 0;
+                uint32_t result = 0;
 
                 if ((offset == 0) && (stream[0] == IMessagePack::NullValue)) {
                     _state = UNDEFINED;
@@ -2457,7 +2617,249 @@ namespace Core {
             mutable NumberType<uint32_t, FALSE, BASE_HEXADECIMAL> _package;
         };
 
+        // Storage for the elements of an ArrayType. The elements live in chunks of which
+        // every next one is twice as big as the previous one, so adding elements hardly
+        // ever allocates, an element is never moved once added (references and iterators
+        // stay valid) and indexing is O(1). Cleared chunks are kept for reuse.
         template <typename ELEMENT>
+        class ArenaType {
+        private:
+            static constexpr uint32_t BaseBits = 2;
+            static constexpr uint32_t Base = (1 << BaseBits);
+
+            template <typename CONTAINER, typename TYPE>
+            class IndexIterator {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef TYPE value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef TYPE* pointer;
+                typedef TYPE& reference;
+
+                IndexIterator()
+                    : _container(nullptr)
+                    , _index(0)
+                    , _chunk(0)
+                    , _offset(0)
+                {
+                }
+                IndexIterator(CONTAINER& container, const uint32_t index)
+                    : _container(&container)
+                    , _index(index)
+                    , _chunk(0)
+                    , _offset(0)
+                {
+                    Locate(_index, _chunk, _offset);
+                }
+                template <typename OTHERCONTAINER, typename OTHERTYPE>
+                IndexIterator(const IndexIterator<OTHERCONTAINER, OTHERTYPE>& copy)
+                    : _container(copy._container)
+                    , _index(copy._index)
+                    , _chunk(copy._chunk)
+                    , _offset(copy._offset)
+                {
+                }
+                ~IndexIterator() = default;
+
+            public:
+                inline bool operator==(const IndexIterator<CONTAINER, TYPE>& rhs) const
+                {
+                    return (_index == rhs._index);
+                }
+                inline bool operator!=(const IndexIterator<CONTAINER, TYPE>& rhs) const
+                {
+                    return (!operator==(rhs));
+                }
+                IndexIterator<CONTAINER, TYPE>& operator++()
+                {
+                    _index++;
+                    _offset++;
+
+                    if (_offset == (Base << _chunk)) {
+                        _chunk++;
+                        _offset = 0;
+                    }
+
+                    return (*this);
+                }
+                IndexIterator<CONTAINER, TYPE> operator++(int)
+                {
+                    IndexIterator<CONTAINER, TYPE> result(*this);
+                    operator++();
+                    return (result);
+                }
+                inline TYPE& operator*() const
+                {
+                    ASSERT(_index < _container->_size);
+
+                    return (_container->_chunks[_chunk][_offset]);
+                }
+                inline TYPE* operator->() const
+                {
+                    return (&(operator*()));
+                }
+
+            private:
+                template <typename OTHERCONTAINER, typename OTHERTYPE>
+                friend class IndexIterator;
+
+                CONTAINER* _container;
+                uint32_t _index;
+                uint8_t _chunk;
+                uint32_t _offset;
+            };
+
+        public:
+            typedef IndexIterator<ArenaType<ELEMENT>, ELEMENT> iterator;
+            typedef IndexIterator<const ArenaType<ELEMENT>, const ELEMENT> const_iterator;
+
+            ArenaType()
+                : _chunks()
+                , _size(0)
+            {
+            }
+            ArenaType(const ArenaType<ELEMENT>& copy)
+                : _chunks()
+                , _size(0)
+            {
+                for (const ELEMENT& element : copy) {
+                    push_back(element);
+                }
+            }
+            ~ArenaType()
+            {
+                clear();
+
+                for (ELEMENT* chunk : _chunks) {
+                    ::operator delete(chunk);
+                }
+            }
+
+            ArenaType<ELEMENT>& operator=(const ArenaType<ELEMENT>& RHS)
+            {
+                if (&RHS != this) {
+                    clear();
+
+                    for (const ELEMENT& element : RHS) {
+                        push_back(element);
+                    }
+                }
+
+                return (*this);
+            }
+
+        public:
+            inline uint32_t size() const
+            {
+                return (_size);
+            }
+            inline bool empty() const
+            {
+                return (_size == 0);
+            }
+            inline iterator begin()
+            {
+                return (iterator(*this, 0));
+            }
+            inline iterator end()
+            {
+                return (iterator(*this, _size));
+            }
+            inline const_iterator begin() const
+            {
+                return (const_iterator(*this, 0));
+            }
+            inline const_iterator end() const
+            {
+                return (const_iterator(*this, _size));
+            }
+            inline ELEMENT& back()
+            {
+                ASSERT(_size > 0);
+
+                return (operator[](_size - 1));
+            }
+            ELEMENT& operator[](const uint32_t index)
+            {
+                uint8_t chunk;
+                uint32_t offset;
+
+                ASSERT(index < _size);
+
+                Locate(index, chunk, offset);
+
+                return (_chunks[chunk][offset]);
+            }
+            const ELEMENT& operator[](const uint32_t index) const
+            {
+                uint8_t chunk;
+                uint32_t offset;
+
+                ASSERT(index < _size);
+
+                Locate(index, chunk, offset);
+
+                return (_chunks[chunk][offset]);
+            }
+            inline void push_back(const ELEMENT& element)
+            {
+                new (Slot()) ELEMENT(element);
+                _size++;
+            }
+            template <typename... Args>
+            inline void emplace_back(Args&&... args)
+            {
+                new (Slot()) ELEMENT(std::forward<Args>(args)...);
+                _size++;
+            }
+            void clear()
+            {
+                iterator index(begin());
+
+                while (index != end()) {
+                    index->~ELEMENT();
+                    index++;
+                }
+
+                _size = 0;
+            }
+
+        private:
+            static void Locate(const uint32_t index, uint8_t& chunk, uint32_t& offset)
+            {
+                // Chunk n starts at element ((Base << n) - Base), so the highest bit of
+                // (index + Base) tells the chunk.
+                uint32_t value = (index + Base) >> BaseBits;
+
+                chunk = 0;
+
+                while (value > 1) {
+                    value >>= 1;
+                    chunk++;
+                }
+
+                offset = (index + Base) - (Base << chunk);
+            }
+            void* Slot()
+            {
+                uint8_t chunk;
+                uint32_t offset;
+
+                Locate(_size, chunk, offset);
+
+                if (chunk == _chunks.size()) {
+                    _chunks.push_back(static_cast<ELEMENT*>(::operator new(sizeof(ELEMENT) * (Base << chunk))));
+                }
+
+                return (&(_chunks[chunk][offset]));
+            }
+
+        private:
+            std::vector<ELEMENT*> _chunks;
+            uint32_t _size;
+        };
+
+        template <typename ELEMENT, typename STORAGE = ArenaType<ELEMENT>>
         class ArrayType : public IElement, public IMessagePack {
         private:
             enum modus : uint8_t {
@@ -2465,18 +2867,18 @@ namespace Core {
                 UNDEFINED = 0x40
             };
 
-            static constexpr uint16_t FIND_MARKER = 0;
-            static constexpr uint16_t BEGIN_MARKER = 1;
-            static constexpr uint16_t END_MARKER = 2;
-            static constexpr uint16_t SKIP_BEFORE = 3;
-            static constexpr uint16_t SKIP_AFTER = 4;
-            static constexpr uint16_t PARSE = 5;
+            static constexpr uint32_t FIND_MARKER = 0;
+            static constexpr uint32_t BEGIN_MARKER = 1;
+            static constexpr uint32_t END_MARKER = 2;
+            static constexpr uint32_t SKIP_BEFORE = 3;
+            static constexpr uint32_t SKIP_AFTER = 4;
+            static constexpr uint32_t PARSE = 5;
 
         public:
             template <typename ARRAYELEMENT>
             class ConstIteratorType {
             private:
-                typedef std::list<ARRAYELEMENT> ArrayContainer;
+                typedef STORAGE ArrayContainer;
                 enum State {
                     AT_BEGINNING,
                     AT_ELEMENT,
@@ -2573,7 +2975,7 @@ namespace Core {
             template <typename ARRAYELEMENT>
             class IteratorType {
             private:
-                typedef std::list<ARRAYELEMENT> ArrayContainer;
+                typedef STORAGE ArrayContainer;
                 enum State {
                     AT_BEGINNING,
                     AT_ELEMENT,
@@ -2686,7 +3088,7 @@ namespace Core {
             {
             }
 
-            ArrayType(const ArrayType<ELEMENT>& copy)
+            ArrayType(const ArrayType<ELEMENT, STORAGE>& copy)
                 : _state(copy._state)
                 , _count(copy._count)
                 , _data(copy._data)
@@ -2738,36 +3140,16 @@ namespace Core {
 
             ELEMENT& operator[](const uint32_t index)
             {
-                uint32_t skip = index;
                 ASSERT(index < Length());
 
-                typename std::list<ELEMENT>::iterator locator = _data.begin();
-
-                while (skip != 0) {
-                    locator++;
-                    skip--;
-                }
-
-                ASSERT(locator != _data.end());
-
-                return (*locator);
+                return (At(_data, index));
             }
 
             const ELEMENT& operator[](const uint32_t index) const
             {
-                uint32_t skip = index;
                 ASSERT(index < Length());
 
-                typename std::list<ELEMENT>::const_iterator locator = _data.begin();
-
-                while (skip != 0) {
-                    locator++;
-                    skip--;
-                }
-
-                ASSERT(locator != _data.end());
-
-                return (*locator);
+                return (At(_data, index));
             }
 
             const ELEMENT& Get(const uint32_t index) const
@@ -2785,7 +3167,7 @@ namespace Core {
                 return (ConstIterator(_data));
             }
 
-            ArrayType<ELEMENT>& operator=(const ArrayType<ELEMENT>& RHS)
+            ArrayType<ELEMENT, STORAGE>& operator=(const ArrayType<ELEMENT, STORAGE>& RHS)
             {
                 _state = RHS._state;
                 _data = RHS._data;
@@ -2801,17 +3183,41 @@ namespace Core {
                 return (result);
             }
 
-            inline ArrayType<ELEMENT>& operator=(const string& RHS)
+            inline ArrayType<ELEMENT, STORAGE>& operator=(const string& RHS)
             {
                 FromString(RHS);
                 return (*this);
             }
 
         private:
+            template <typename CONTAINER>
+            static auto At(CONTAINER& container, const uint32_t index) -> decltype(*(container.begin()))
+            {
+                uint32_t skip = index;
+                auto locator = container.begin();
+
+                while (skip != 0) {
+                    locator++;
+                    skip--;
+                }
+
+                ASSERT(locator != container.end());
+
+                return (*locator);
+            }
+            static ELEMENT& At(ArenaType<ELEMENT>& container, const uint32_t index)
+            {
+                return (container[index]);
+            }
+            static const ELEMENT& At(const ArenaType<ELEMENT>& container, const uint32_t index)
+            {
+                return (container[index]);
+            }
+
             // IElement iface:
-            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(char stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
                 if (offset == FIND_MARKER) {
                     _iterator.Reset();
@@ -2820,7 +3226,7 @@ namespace Core {
                 } else if (offset == END_MARKER) {
                     offset = ~0;
                 }
-                while ((loaded < maxLength) && (offset != static_cast<uint16_t>(~0))) {
+                while ((loaded < maxLength) && (offset != static_cast<uint32_t>(~0))) {
                     if (offset >= PARSE) {
                         offset -= PARSE;
                         loaded += static_cast<const IElement&>(_iterator.Current()).Serialize(&(stream[loaded]), maxLength - loaded, offset);
@@ -2830,7 +3236,7 @@ namespace Core {
                         offset = PARSE;
                     }
                 }
-                if (offset == static_cast<uint16_t>(~0)) {
+                if (offset == static_cast<uint32_t>(~0)) {
                     if (loaded < maxLength) {
                         stream[loaded++] = ']';
                         offset = FIND_MARKER;
@@ -2842,9 +3248,9 @@ namespace Core {
                 return (loaded);
             }
 
-            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error) override
+            uint32_t Deserialize(const char stream[], const uint32_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error) override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
                 // Run till we find opening bracket..
                 if (offset == FIND_MARKER) {
                     while ((loaded < maxLength) && ::isspace(stream[loaded])) {
@@ -2926,9 +3332,9 @@ namespace Core {
             }
 
             // IMessagePack iface:
-            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(uint8_t stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
                 if (offset == 0) {
                     _iterator.Reset();
@@ -2964,9 +3370,9 @@ namespace Core {
                 return (loaded);
             }
 
-            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override
+            uint32_t Deserialize(const uint8_t stream[], const uint32_t maxLength, uint32_t& offset) override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
                 if (offset == 0) {
                     if (stream[0] == IMessagePack::NullValue) {
@@ -3013,7 +3419,7 @@ namespace Core {
         private:
             uint8_t _state;
             uint16_t _count;
-            std::list<ELEMENT> _data;
+            STORAGE _data;
             mutable IteratorType<ELEMENT> _iterator;
         };
 
@@ -3024,17 +3430,22 @@ namespace Core {
                 UNDEFINED = 0x40
             };
 
-            static constexpr uint16_t FIND_MARKER = 0;
-            static constexpr uint16_t BEGIN_MARKER = 1;
-            static constexpr uint16_t END_MARKER = 2;
-            static constexpr uint16_t SKIP_BEFORE = 3;
-            static constexpr uint16_t SKIP_BEFORE_VALUE = 4;
-            static constexpr uint16_t SKIP_AFTER = 5;
-            static constexpr uint16_t SKIP_AFTER_KEY = 6;
-            static constexpr uint16_t PARSE = 7;
+            static constexpr uint32_t FIND_MARKER = 0;
+            static constexpr uint32_t BEGIN_MARKER = 1;
+            static constexpr uint32_t END_MARKER = 2;
+            static constexpr uint32_t SKIP_BEFORE = 3;
+            static constexpr uint32_t SKIP_BEFORE_VALUE = 4;
+            static constexpr uint32_t SKIP_AFTER = 5;
+            static constexpr uint32_t SKIP_AFTER_KEY = 6;
+            static constexpr uint32_t PARSE = 7;
+
+            // Up to this number of elements, a plain walk through the elements is the fastest
+            // way to find a label, beyond it, the labels are indexed on first lookup.
+            static constexpr uint16_t IndexThreshold = 8;
 
             typedef std::pair<const TCHAR*, IElement*> JSONLabelValue;
             typedef std::list<JSONLabelValue> JSONElementList;
+            typedef std::vector<JSONLabelValue> JSONLabelIndex;
 
             class Iterator {
             private:
@@ -3110,6 +3521,7 @@ namespace Core {
             Container()
                 : _state(0)
                 , _data()
+                , _index()
                 , _iterator()
                 , _fieldName(true)
             {
@@ -3164,6 +3576,11 @@ namespace Core {
             void Add(const TCHAR label[], IElement* element)
             {
                 _data.push_back(JSONLabelValue(label, element));
+
+                if (_index.empty() == false) {
+                    // Behind all equal labels, the first one added is the one that is found.
+                    _index.insert(std::upper_bound(_index.begin(), _index.end(), _data.back(), Compare), _data.back());
+                }
             }
 
             void Remove(const TCHAR label[])
@@ -3175,15 +3592,18 @@ namespace Core {
                 }
 
                 if (index != _data.end()) {
+                    if (_index.empty() == false) {
+                        _index.erase(std::find(_index.begin(), _index.end(), *index));
+                    }
                     _data.erase(index);
                 }
             }
 
         private:
             // IElement iface:
-            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(char stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
                 if (offset == FIND_MARKER) {
                     _iterator = _data.begin();
@@ -3199,7 +3619,7 @@ namespace Core {
                     offset = ~0;
                 }
 
-                while ((loaded < maxLength) && (offset != static_cast<uint16_t>(~0))) {
+                while ((loaded < maxLength) && (offset != static_cast<uint32_t>(~0))) {
                     if (offset >= PARSE) {
                         offset -= PARSE;
                         loaded += _current.json->Serialize(&(stream[loaded]), maxLength - loaded, offset);
@@ -3221,7 +3641,7 @@ namespace Core {
                         }
                     }
                 }
-                if (offset == static_cast<uint16_t>(~0)) {
+                if (offset == static_cast<uint32_t>(~0)) {
                     if (loaded < maxLength) {
                         stream[loaded++] = '}';
                         offset = FIND_MARKER;
@@ -3234,9 +3654,9 @@ namespace Core {
                 return (loaded);
             }
 
-            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error) override
+            uint32_t Deserialize(const char stream[], const uint32_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error) override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
                 // Run till we find opening bracket..
                 if (offset == FIND_MARKER) {
                     while ((loaded < maxLength) && (::isspace(stream[loaded]))) {
@@ -3357,7 +3777,7 @@ namespace Core {
 
                     if (offset >= PARSE) {
                         offset = (offset - PARSE);
-                        uint16_t skip = SKIP_AFTER;
+                        uint32_t skip = SKIP_AFTER;
                         if (_current.json == nullptr) {
                             loaded += static_cast<IElement&>(_fieldName).Deserialize(&(stream[loaded]), maxLength - loaded, offset, error);
                             if (_fieldName.IsQuoted() == false) {
@@ -3386,11 +3806,11 @@ namespace Core {
             }
 
             // IMessagePack iface:
-            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override
+            uint32_t Serialize(uint8_t stream[], const uint32_t maxLength, uint32_t& offset) const override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
-                uint16_t elementSize = Size();
+                uint32_t elementSize = Size();
                 if (offset == 0) {
                     _iterator = _data.begin();
                     if (elementSize <= 15) {
@@ -3452,9 +3872,9 @@ namespace Core {
                 return (loaded);
             }
 
-            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override
+            uint32_t Deserialize(const uint8_t stream[], const uint32_t maxLength, uint32_t& offset) override
             {
-                uint16_t loaded = 0;
+                uint32_t loaded = 0;
 
                 if (offset == 0) {
                     if (stream[0] == IMessagePack::NullValue) {
@@ -3510,21 +3930,48 @@ namespace Core {
                 return (loaded);
             }
 
-            IElement* Find(const char label[])
+            static bool Compare(const JSONLabelValue& lhs, const JSONLabelValue& rhs)
+            {
+                return (strcmp(lhs.first, rhs.first) < 0);
+            }
+
+            IElement* Lookup(const char label[])
             {
                 IElement* result = nullptr;
 
-                JSONElementList::iterator index = _data.begin();
+                if (_data.size() <= IndexThreshold) {
+                    JSONElementList::iterator index = _data.begin();
 
-                while ((index != _data.end()) && (strcmp(label, index->first) != 0)) {
-                    index++;
-                }
+                    while ((index != _data.end()) && (strcmp(label, index->first) != 0)) {
+                        index++;
+                    }
 
-                if (index != _data.end()) {
-                    result = index->second;
+                    if (index != _data.end()) {
+                        result = index->second;
+                    }
+                } else {
+                    if (_index.empty() == true) {
+                        _index.reserve(_data.size());
+                        _index.assign(_data.begin(), _data.end());
+                        std::stable_sort(_index.begin(), _index.end(), Compare);
+                    }
+
+                    JSONLabelIndex::iterator index = std::lower_bound(_index.begin(), _index.end(), JSONLabelValue(label, nullptr), Compare);
+
+                    if ((index != _index.end()) && (strcmp(label, index->first) == 0)) {
+                        result = index->second;
+                    }
                 }
-                else if (Request(label) == true) {
-                    index = _data.end();
+
+                return (result);
+            }
+
+            IElement* Find(const char label[])
+            {
+                IElement* result = Lookup(label);
+
+                if ((result == nullptr) && (Request(label) == true)) {
+                    JSONElementList::iterator index = _data.end();
 
                     while ((result == nullptr) && (index != _data.begin())) {
                         index--;
@@ -3573,6 +4020,7 @@ namespace Core {
                 mutable IMessagePack* pack;
             } _current;
             JSONElementList _data;
+            JSONLabelIndex _index;
             mutable JSONElementList::const_iterator _iterator;
             mutable String _fieldName;
         };
@@ -3788,17 +4236,17 @@ namespace Core {
 
         private:
             // IElement iface:
-            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error) override;
+            uint32_t Deserialize(const char stream[], const uint32_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error) override;
 
-            static uint16_t FindEndOfScope(const char stream[], uint16_t maxLength)
+            static uint32_t FindEndOfScope(const char stream[], uint32_t maxLength)
             {
                 ASSERT(maxLength > 0 && (stream[0] == '{' || stream[0] == '['));
                 char charOpen = stream[0];
                 char charClose = charOpen == '{' ? '}' : ']';
-                uint16_t stack = 1;
-                uint16_t endIndex = 0;
+                uint32_t stack = 1;
+                uint32_t endIndex = 0;
                 bool insideQuotes = false;
-                for (uint16_t i = 1; i < maxLength; ++i) {
+                for (uint32_t i = 1; i < maxLength; ++i) {
                     if ((stream[i] == '\"') && (stream[i - 1] != '\\')) {
                         insideQuotes = !insideQuotes;
                     }
@@ -4122,11 +4570,11 @@ namespace Core {
             return (result);
         }
 
-        inline uint16_t Variant::Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error)
+        inline uint32_t Variant::Deserialize(const char stream[], const uint32_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error)
         {
-            uint16_t result = 0;
+            uint32_t result = 0;
             if (stream[0] == '{' || stream[0] == '[') {
-                uint16_t endIndex = FindEndOfScope(stream, maxLength);
+                uint32_t endIndex = FindEndOfScope(stream, maxLength);
                 if (endIndex > 0 && endIndex < maxLength) {
                     result = endIndex + 1;
                     SetQuoted(false);
@@ -4161,6 +4609,96 @@ namespace Core {
             return (result);
         }
 
+        // An element of which the JSON text is composed up front, e.g. a notification that
+        // is sent to many channels. Serializing it is a plain copy that keeps no state in
+        // the element itself, so one instance can be serialized by several parties at the
+        // same time. The optional label tells what the text is about, e.g. the event name.
+        class EXTERNAL Serialized : public IElement {
+        public:
+            Serialized(const Serialized&) = delete;
+            Serialized& operator=(const Serialized&) = delete;
+
+            Serialized()
+                : _text()
+                , _label()
+            {
+            }
+            explicit Serialized(const IElement& element)
+                : _text()
+                , _label()
+            {
+                element.ToString(_text);
+            }
+            Serialized(const IElement& element, const string& label)
+                : _text()
+                , _label(label)
+            {
+                element.ToString(_text);
+            }
+            ~Serialized() override
+            {
+            }
+
+        public:
+            inline const string& Text() const
+            {
+                return (_text);
+            }
+            inline const string& Label() const
+            {
+                return (_label);
+            }
+            inline void Text(const IElement& element)
+            {
+                element.ToString(_text);
+            }
+
+            // IElement iface:
+            void Clear() override
+            {
+                _text.clear();
+            }
+            bool IsSet() const override
+            {
+                return (_text.empty() == false);
+            }
+            bool IsNull() const override
+            {
+                return (false);
+            }
+
+        private:
+            uint32_t Serialize(char stream[], const uint32_t maxLength, uint32_t& offset) const override
+            {
+                // The offset is where the previous call left off..
+                uint32_t loaded = static_cast<uint32_t>(std::min(static_cast<size_t>(maxLength), _text.length() - offset));
+
+                ::memcpy(stream, &(_text.c_str()[offset]), loaded);
+
+                offset += loaded;
+
+                if (offset == _text.length()) {
+                    offset = 0;
+                }
+
+                return (loaded);
+            }
+            uint32_t Deserialize(const char[], const uint32_t, uint32_t& offset, Core::OptionalType<Error>& error) override
+            {
+                // This is an outbound only element..
+                ASSERT(false);
+
+                offset = 0;
+                error = Error{ "Serialized elements can not be deserialized" };
+
+                return (0);
+            }
+
+        private:
+            string _text;
+            string _label;
+        };
+
         template <uint16_t SIZE, typename INSTANCEOBJECT>
         class Tester {
         private:
@@ -4181,15 +4719,15 @@ namespace Core {
 
             bool FromString(const string& value, Core::ProxyType<INSTANCEOBJECT>& receptor)
             {
-                uint16_t fillCount = 0;
-                uint16_t offset = 0;
-                uint16_t size, loaded;
+                uint32_t fillCount = 0;
+                uint32_t offset = 0;
+                uint32_t size, loaded;
 
                 receptor->Clear();
                 Core::OptionalType<Error> error;
 
                 do {
-                    size = static_cast<uint16_t>((value.size() - fillCount) < SIZE ? (value.size() - fillCount) : SIZE);
+                    size = static_cast<uint32_t>((value.size() - fillCount) < SIZE ? (value.size() - fillCount) : SIZE);
 
                     // Prepare the deserialize buffer
                     memcpy(_buffer, &(value.data()[fillCount]), size);
@@ -4207,8 +4745,8 @@ namespace Core {
 
             bool ToString(const Core::ProxyType<INSTANCEOBJECT>& receptor, string& value)
             {
-                uint16_t offset = 0;
-                uint16_t loaded;
+                uint32_t offset = 0;
+                uint32_t loaded;
 
                 // Serialize object
                 do {
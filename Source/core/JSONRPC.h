@@ -445,7 +445,9 @@ namespace Core {
             typedef std::list<Observer> ObserverList;
             typedef std::map<string, ObserverList> ObserverMap;
 
-            typedef std::function<void(const uint32_t id, const string& designator, const string& data)> NotificationFunction;
+            // Observers that share a designator receive exactly the same notification, so they are
+            // reported in one go, allowing the notification to be composed once for all of them.
+            typedef std::function<void(const std::vector<uint32_t>& ids, const string& designator, const string& data)> NotificationFunction;
 
         public:
             class EventIterator {
@@ -1065,20 +1067,42 @@ namespace Core {
 
                 if (index != _observers.end()) {
                     ObserverList& clients = index->second;
-                    ObserverList::iterator loop = clients.begin();
+                    ObserverList::const_iterator loop = clients.begin();
+                    std::list<std::pair<const string*, std::vector<uint32_t>>> groups;
 
                     result = Core::ERROR_NONE;
 
                     while (loop != clients.end()) {
                         const string& designator(loop->Designator());
 
-                        if (!sendifmethod || sendifmethod(designator)) {
+                        std::list<std::pair<const string*, std::vector<uint32_t>>>::iterator group(groups.begin());
+
+                        while ((group != groups.end()) && (*(group->first) != designator)) {
+                            group++;
+                        }
+
+                        if (group == groups.end()) {
+                            // First one with this designator, an empty group means it should not be sent..
+                            groups.emplace_back(&designator, std::vector<uint32_t>());
+                            group = std::prev(groups.end());
 
-                            _notificationFunction(loop->Id(), (designator.empty() == false ? designator + '.' + event : event), parameters);
+                            if (!sendifmethod || sendifmethod(designator)) {
+                                group->second.push_back(loop->Id());
+                            }
+                        } else if (group->second.empty() == false) {
+                            group->second.push_back(loop->Id());
                         }
 
                         loop++;
                     }
+
+                    for (const std::pair<const string*, std::vector<uint32_t>>& group : groups) {
+                        if (group.second.empty() == false) {
+                            const string& designator(*(group.first));
+
+                            _notificationFunction(group.second, (designator.empty() == false ? designator + '.' + event : event), parameters);
+                        }
+                    }
                 }
 
                 _adminLock.Unlock();
@@ -132,9 +132,9 @@ namespace Core {
 
                 _current.Release();
             }
-            virtual typename INBOUND::BaseElement* Element(const typename INBOUND::Identifier& id)
+            virtual typename INBOUND::BaseElement* Element(const typename INBOUND::Identifier& id, const uint32_t sequence)
             {
-                _current = _pool.Element(id);
+                _current = _pool.Element(id, sequence);
 
 #ifdef __DEBUG__
                 if (_current.IsValid() == false) {
@@ -279,6 +279,8 @@ int clock_gettime(int, struct timespec*);
 #include <linux/types.h>
 #include <linux/uinput.h>
 #include <sys/signalfd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #endif
 
 #define ONESTOPBIT 0
@@ -33,6 +33,7 @@
 #include "Module.h"
 #include "StateTrigger.h"
 #include "Sync.h"
+#include "Time.h"
 
 namespace WPEFramework {
 namespace Core {
@@ -295,6 +296,431 @@ namespace Core {
         CriticalSection m_Admin;
         uint32_t m_MaxSlots;
     };
+
+    // -------------------------------------------------------------------
+    // Duplicate suppression for the RingQueueType. The FILTER is asked to
+    // Enter an entry before it is queued, if it refuses, the entry is
+    // already in the queue and it is not queued again. Once the entry
+    // leaves the queue, the FILTER is told so.
+    // -------------------------------------------------------------------
+    template <typename CONTEXT>
+    struct NoQueueFilter {
+        static bool Enter(const CONTEXT&)
+        {
+            return (true);
+        }
+        static void Leave(const CONTEXT&)
+        {
+        }
+    };
+
+    // Elements that should only be queued once, can derive from this flag
+    // and be queued through a RingQueueType with an IntrusiveQueueFilter.
+    class QueuedFlag {
+    public:
+        QueuedFlag(const QueuedFlag&) = delete;
+        QueuedFlag& operator=(const QueuedFlag&) = delete;
+
+        QueuedFlag()
+            : _queued(false)
+        {
+        }
+        ~QueuedFlag() = default;
+
+    public:
+        bool IsQueued() const
+        {
+            return (_queued);
+        }
+        bool Enqueue() const
+        {
+            bool expected = false;
+            return (_queued.compare_exchange_strong(expected, true));
+        }
+        void Dequeue() const
+        {
+            _queued = false;
+        }
+
+    private:
+        mutable std::atomic<bool> _queued;
+    };
+
+    // CONTEXT is a pointer like type (pointer, ProxyType) to a QueuedFlag.
+    template <typename CONTEXT>
+    struct IntrusiveQueueFilter {
+        static bool Enter(const CONTEXT& entry)
+        {
+            return (entry->Enqueue());
+        }
+        static void Leave(const CONTEXT& entry)
+        {
+            entry->Dequeue();
+        }
+    };
+
+    // -------------------------------------------------------------------
+    // Bounded multi producer, multi consumer queue, with the same
+    // Insert/Extract/Post/Enable/Disable/Flush semantics as the QueueType.
+    // Entries are kept in a ring of which the number of slots is the
+    // high watermark rounded up to a power of 2, with a minimum of 2. Every slot carries a
+    // sequence number telling whether it is ready to be written or read,
+    // so producers and consumers only contend on an atomic position and
+    // nothing is allocated or locked, unless a caller has to wait for room
+    // or an entry. A waiting caller sleeps until the queue changed or its
+    // wait time, counted from the call, is over.
+    // Entries can not be removed from the middle of the queue, use a
+    // FILTER (e.g. the IntrusiveQueueFilter) to prevent duplicates.
+    // -------------------------------------------------------------------
+    template <typename CONTEXT, typename FILTER = NoQueueFilter<CONTEXT>>
+    class RingQueueType {
+    private:
+        class Cell {
+        public:
+            Cell(const Cell&) = delete;
+            Cell& operator=(const Cell&) = delete;
+
+            Cell()
+                : Sequence(0)
+                , Entry()
+            {
+            }
+            ~Cell() = default;
+
+        public:
+            std::atomic<uint32_t> Sequence;
+            CONTEXT Entry;
+        };
+        class Sleeper {
+        public:
+            Sleeper() = delete;
+            Sleeper(const Sleeper&) = delete;
+            Sleeper& operator=(const Sleeper&) = delete;
+
+            explicit Sleeper(Sleeper* next)
+                : Signal(false, true)
+                , Next(next)
+            {
+            }
+            ~Sleeper() = default;
+
+        public:
+            Event Signal;
+            Sleeper* Next;
+        };
+
+    public:
+        RingQueueType() = delete;
+        RingQueueType(const RingQueueType<CONTEXT, FILTER>&) = delete;
+        RingQueueType<CONTEXT, FILTER>& operator=(const RingQueueType<CONTEXT, FILTER>&) = delete;
+
+        explicit RingQueueType(const uint32_t highWaterMark)
+            : _mask(Size(highWaterMark) - 1)
+            , _cells(new Cell[_mask + 1])
+            , _head(0)
+            , _tail(0)
+            , _enabled(true)
+            , _waiters(0)
+            , _sleepers(nullptr)
+            , _adminLock()
+        {
+            // A highwatermark of 0 is bullshit.
+            ASSERT(highWaterMark != 0);
+
+            for (uint32_t index = 0; index <= _mask; index++) {
+                _cells[index].Sequence.store(index, std::memory_order_relaxed);
+            }
+
+            TRACE_L5("Constructor RingQueueType <%p>", (this));
+        }
+        ~RingQueueType()
+        {
+            TRACE_L5("Destructor RingQueueType <%p>", (this));
+
+            // Disable the queue and flush all entries.
+            Disable();
+            Flush();
+
+            delete[] _cells;
+        }
+
+    public:
+        // Queue the entry if there is room, does not wait.
+        bool Post(const CONTEXT& entry)
+        {
+            bool result = false;
+
+            if (_enabled == true) {
+                if (FILTER::Enter(entry) == false) {
+                    // It is already waiting in the queue..
+                    result = true;
+                } else if (Push(entry) == true) {
+                    result = true;
+                    Changed();
+                } else {
+                    FILTER::Leave(entry);
+                }
+            }
+
+            return (result);
+        }
+        // Queue the entry, if the queue is full wait till there is room.
+        bool Insert(const CONTEXT& entry, const uint32_t waitTime)
+        {
+            bool result = false;
+
+            if (_enabled == true) {
+                if (FILTER::Enter(entry) == false) {
+                    // It is already waiting in the queue..
+                    result = true;
+                } else {
+                    const uint64_t deadline = Deadline(waitTime);
+
+                    while (((result = Push(entry)) == false) && (Wait([this]() { return (IsFull() == false); }, deadline) == true)) {
+                        // Room was made, try again..
+                    }
+
+                    if (result == true) {
+                        Changed();
+                    } else {
+                        FILTER::Leave(entry);
+                    }
+                }
+            }
+
+            return (result);
+        }
+        // Take the oldest entry, if the queue is empty wait till there is one.
+        bool Extract(CONTEXT& result, const uint32_t waitTime)
+        {
+            bool received = false;
+
+            if (_enabled == true) {
+                const uint64_t deadline = Deadline(waitTime);
+
+                while (((received = Pop(result)) == false) && (Wait([this]() { return (IsEmpty() == false); }, deadline) == true)) {
+                    // Something was queued, try again..
+                }
+            }
+
+            if (received == true) {
+                FILTER::Leave(result);
+                Changed();
+            }
+
+            return (received);
+        }
+        void Enable()
+        {
+            _enabled = true;
+        }
+        void Disable()
+        {
+            _enabled = false;
+
+            // Release everyone that is waiting.
+            _adminLock.Lock();
+            Wakeup();
+            _adminLock.Unlock();
+        }
+        void Flush()
+        {
+            // Clear is only possible in a "DISABLED" state !!
+            ASSERT(_enabled == false);
+
+            CONTEXT entry;
+
+            while (Pop(entry) == true) {
+                FILTER::Leave(entry);
+                entry = CONTEXT();
+            }
+        }
+        inline bool IsEmpty() const
+        {
+            return (Length() == 0);
+        }
+        inline bool IsFull() const
+        {
+            return (Length() > _mask);
+        }
+        inline uint32_t Length() const
+        {
+            // Only a snapshot, it might be outdated the moment it is returned.
+            uint32_t tail = _tail.load(std::memory_order_acquire);
+            uint32_t head = _head.load(std::memory_order_acquire);
+
+            return (tail - head > _mask + 1 ? 0 : tail - head);
+        }
+
+    private:
+        static uint32_t Size(const uint32_t highWaterMark)
+        {
+            // With a single slot, a sequence of a slot just read equals that of a slot just
+            // written, so full could not be told from empty.
+            uint32_t size = 2;
+
+            while ((size < highWaterMark) && (size < 0x80000000)) {
+                size <<= 1;
+            }
+
+            return (size);
+        }
+        static uint64_t Deadline(const uint32_t waitTime)
+        {
+            return (waitTime == Core::infinite ? 0 : Core::Time::Now().Add(waitTime).Ticks());
+        }
+        static uint32_t Remaining(const uint64_t deadline)
+        {
+            uint32_t result = Core::infinite;
+
+            if (deadline != 0) {
+                const uint64_t now = Core::Time::Now().Ticks();
+
+                // Ticks are in microseconds, round up so we do not wake just before the deadline.
+                result = (now >= deadline ? 0 : static_cast<uint32_t>((deadline - now + 999) / 1000));
+            }
+
+            return (result);
+        }
+        bool Push(const CONTEXT& entry)
+        {
+            bool pushed = false;
+            uint32_t position = _tail.load(std::memory_order_relaxed);
+
+            while (pushed == false) {
+                Cell& cell(_cells[position & _mask]);
+                uint32_t sequence = cell.Sequence.load(std::memory_order_acquire);
+                int32_t difference = static_cast<int32_t>(sequence - position);
+
+                if (difference == 0) {
+                    // The slot is free, claim it..
+                    if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed) == true) {
+                        cell.Entry = entry;
+                        cell.Sequence.store(position + 1, std::memory_order_release);
+                        pushed = true;
+                    }
+                } else if (difference < 0) {
+                    // The slot still holds an entry that is not read, we are full
+                    break;
+                } else {
+                    position = _tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            return (pushed);
+        }
+        bool Pop(CONTEXT& entry)
+        {
+            bool popped = false;
+            uint32_t position = _head.load(std::memory_order_relaxed);
+
+            while (popped == false) {
+                Cell& cell(_cells[position & _mask]);
+                uint32_t sequence = cell.Sequence.load(std::memory_order_acquire);
+                int32_t difference = static_cast<int32_t>(sequence - (position + 1));
+
+                if (difference == 0) {
+                    // The slot holds an entry, claim it..
+                    if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed) == true) {
+                        entry = cell.Entry;
+                        cell.Entry = CONTEXT();
+                        cell.Sequence.store(position + _mask + 1, std::memory_order_release);
+                        popped = true;
+                    }
+                } else if (difference < 0) {
+                    // Nothing written in this slot yet, we are empty
+                    break;
+                } else {
+                    position = _head.load(std::memory_order_relaxed);
+                }
+            }
+
+            return (popped);
+        }
+        template <typename CONDITION>
+        bool Wait(CONDITION condition, const uint64_t deadline)
+        {
+            bool triggered = false;
+
+            _waiters++;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            _adminLock.Lock();
+
+            const uint32_t waitTime = Remaining(deadline);
+
+            if ((_enabled == true) && (waitTime != 0)) {
+                if (condition() == true) {
+                    triggered = true;
+                } else {
+                    // Every sleeper has its own event, only set by a change after it started to
+                    // sleep. So nobody returns over and over on a change it has already seen, nor
+                    // does a newcomer take the wakeup of someone else.
+                    Sleeper sleeper(_sleepers);
+
+                    _sleepers = &sleeper;
+
+                    _adminLock.Unlock();
+
+                    triggered = (sleeper.Signal.Lock(waitTime) == Core::ERROR_NONE);
+
+                    _adminLock.Lock();
+
+                    if (triggered == false) {
+                        Sleeper** index = &_sleepers;
+
+                        while ((*index != nullptr) && (*index != &sleeper)) {
+                            index = &((*index)->Next);
+                        }
+
+                        if (*index == &sleeper) {
+                            *index = sleeper.Next;
+                        } else {
+                            // Woken while timing out.
+                            triggered = true;
+                        }
+                    }
+                }
+            }
+
+            _adminLock.Unlock();
+
+            _waiters--;
+
+            // If we were disabled, that is assumed to be also a timeout
+            return (triggered && (_enabled == true));
+        }
+        void Changed()
+        {
+            // Pairs with the fence in Wait(), either the waiter sees our change or we see the waiter.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (_waiters > 0) {
+                _adminLock.Lock();
+                Wakeup();
+                _adminLock.Unlock();
+            }
+        }
+        void Wakeup()
+        {
+            // The sleepers are gone once they got the _adminLock back, not before.
+            while (_sleepers != nullptr) {
+                Sleeper* sleeper = _sleepers;
+                _sleepers = sleeper->Next;
+                sleeper->Signal.SetEvent();
+            }
+        }
+
+    private:
+        const uint32_t _mask;
+        Cell* _cells;
+        std::atomic<uint32_t> _head;
+        std::atomic<uint32_t> _tail;
+        std::atomic<bool> _enabled;
+        std::atomic<uint32_t> _waiters;
+        Sleeper* _sleepers;
+        CriticalSection _adminLock;
+    };
 }
 } // namespace Core
 
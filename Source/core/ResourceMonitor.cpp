@@ -17,6 +17,7 @@
  * limitations under the License.
  */
  
+#include "Number.h"
 #include "ResourceMonitor.h"
 #include "Singleton.h"
 
@@ -24,6 +25,29 @@ namespace WPEFramework {
 
 namespace Core {
 
+    /* static */ uint8_t ResourceMonitor::_reactorCount = 1;
+
+    ResourceMonitor::ResourceMonitor()
+        : _reactors()
+    {
+        _reactors.reserve(_reactorCount);
+
+        // The first reactor keeps the name of the single monitor that used to be there.
+        _reactors.push_back(new ResourceMonitorBase());
+
+        for (uint8_t index = 1; index < _reactorCount; index++) {
+            _reactors.push_back(new ResourceMonitorBase(string(_reactors[0]->Name()) + _T("::") + Core::NumberType<uint8_t>(index).Text()));
+        }
+    }
+
+    ResourceMonitor::~ResourceMonitor()
+    {
+        for (ResourceMonitorBase* reactor : _reactors) {
+            delete reactor;
+        }
+        _reactors.clear();
+    }
+
     /* static */ ResourceMonitor& ResourceMonitor::Instance()
     {
         // Tests build/destroy the ResourceMonitor for each test. In production the
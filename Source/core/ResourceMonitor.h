@@ -27,6 +27,10 @@
 #include "Trace.h"
 #include "Timer.h"
 
+#if defined(__LINUX__) && !defined(__APPLE__) && defined(CORE_RESOURCEMONITOR_EPOLL)
+#define __RESOURCEMONITOR_EPOLL__
+#endif
+
 namespace WPEFramework {
 
 namespace Core {
@@ -91,19 +95,85 @@ namespace Core {
             signed int descriptor;
             uint16_t monitor;
             uint16_t events;
+            uint32_t ready;
             const char* classname;
         };
 
+#ifdef __RESOURCEMONITOR_EPOLL__
+    private:
+        // Every registered resource gets an entry with a unique id. The id (and not the address
+        // of the entry) is handed to epoll, so events that are still reported for a descriptor
+        // that has been closed or unregistered in the mean time, can be recognized and dropped.
+        class Entry {
+        public:
+            Entry& operator=(const Entry&) = delete;
+
+            Entry(RESOURCE* resource)
+                : Resource(resource)
+                , Descriptor(-1)
+                , Monitor(0)
+                , Events(0)
+                , Ready(0)
+                , Armed(false)
+                , Dirty(true)
+            {
+            }
+            Entry(const Entry& copy)
+                : Resource(copy.Resource)
+                , Descriptor(copy.Descriptor)
+                , Monitor(copy.Monitor)
+                , Events(copy.Events)
+                , Ready(copy.Ready)
+                , Armed(copy.Armed)
+                , Dirty(copy.Dirty)
+            {
+            }
+            ~Entry()
+            {
+            }
+
+        public:
+            RESOURCE* Resource;
+            int Descriptor;
+            uint16_t Monitor;
+            uint16_t Events;
+            uint32_t Ready;
+            bool Armed;
+            bool Dirty;
+        };
+
+        typedef std::unordered_map<uint32_t, Entry> EntryMap;
+        typedef std::unordered_map<RESOURCE*, uint32_t> ResourceMap;
+#endif
+
     public:
         ResourceMonitorType()
+            : ResourceMonitorType(_T("Monitor::") + ClassNameOnly(typeid(RESOURCE).name()).Text())
+        {
+        }
+        ResourceMonitorType(const string& name)
             : _monitor(nullptr)
             , _adminLock()
+#ifdef __RESOURCEMONITOR_EPOLL__
+            , _entries()
+            , _resources()
+            , _dirty()
+            , _signalLock()
+            , _signalled()
+            , _evaluateAll(false)
+            , _entryId(0)
+#else
             , _resourceList()
+#endif
+            , _handling(nullptr)
             , _monitorRuns(0)
-            , _name(_T("Monitor::") + ClassNameOnly(typeid(RESOURCE).name()).Text())
+            , _name(name)
             , _watchDog(1024 * 512, _name.c_str())
 #ifdef __WINDOWS__
             , _action(WSACreateEvent())
+#elif defined(__RESOURCEMONITOR_EPOLL__)
+            , _epollDescriptor(-1)
+            , _signalDescriptor(-1)
 #else
             , _descriptorArrayLength(FileDescriptorAllocation)
             , _descriptorArray(static_cast<struct pollfd*>(::malloc(sizeof(::pollfd) * (_descriptorArrayLength + 1))))
@@ -116,7 +186,11 @@ namespace Core {
         {
 
             // All resources should be gone !!!
+#ifdef __RESOURCEMONITOR_EPOLL__
+            ASSERT(_resources.size() == 0);
+#else
             ASSERT(_resourceList.size() == 0);
+#endif
 
             if (_monitor != nullptr) {
 
@@ -126,14 +200,27 @@ namespace Core {
 
                 _adminLock.Lock();
 
+#ifdef __RESOURCEMONITOR_EPOLL__
+                _entries.clear();
+                _resources.clear();
+                _dirty.clear();
+#else
                 _resourceList.clear();
+#endif
 
                 _adminLock.Unlock();
 
                 delete _monitor;
             }
 
-#ifdef __LINUX__
+#ifdef __RESOURCEMONITOR_EPOLL__
+            if (_epollDescriptor != -1) {
+                ::close(_epollDescriptor);
+            }
+            if (_signalDescriptor != -1) {
+                ::close(_signalDescriptor);
+            }
+#elif defined(__LINUX__)
             ::free(_descriptorArray);
             if (_signalDescriptor != -1) {
                 ::close(_signalDescriptor);
@@ -159,8 +246,119 @@ namespace Core {
         }
         uint32_t Count() const 
         {
+#ifdef __RESOURCEMONITOR_EPOLL__
+            return (static_cast<uint32_t>(_resources.size()));
+#else
             return (static_cast<uint32_t>(_resourceList.size()));
+#endif
         }
+#ifdef __RESOURCEMONITOR_EPOLL__
+        bool Info (const uint32_t position, Metadata& info) const
+        {
+            uint32_t count = position;
+
+            _adminLock.Lock();
+
+            // Entries pending removal are not reported, in line with Count().
+            typename EntryMap::const_iterator index(_entries.cbegin());
+            while ( (index != _entries.cend()) && ((index->second.Resource == nullptr) || (count != 0)) ) {
+                if (index->second.Resource != nullptr) {
+                    count--;
+                }
+                index++;
+            }
+
+            bool found = (index != _entries.cend());
+
+            if (found == true) {
+                const Entry& entry(index->second);
+
+                info.descriptor = entry.Descriptor;
+                info.classname  = (entry.Resource != nullptr ? typeid(*(entry.Resource)).name() : _T(""));
+                info.monitor    = entry.Monitor;
+                info.events     = entry.Events;
+                info.ready      = entry.Ready;
+            }
+
+            _adminLock.Unlock();
+
+            return (found);
+        }
+        void Register(RESOURCE& resource)
+        {
+            _adminLock.Lock();
+
+            // Make sure this entry does not exist, only register resources once !!!
+            ASSERT(_resources.find(&resource) == _resources.end());
+
+            // Id 0 is reserved for the signal descriptor.
+            do {
+                _entryId++;
+            } while ((_entryId == 0) || (_entries.find(_entryId) != _entries.end()));
+
+            _entries.insert(std::pair<uint32_t, Entry>(_entryId, Entry(&resource)));
+            _resources.insert(std::pair<RESOURCE*, uint32_t>(&resource, _entryId));
+            _dirty.push_back(_entryId);
+
+            if (_entries.size() == 1) {
+                if (_monitor == nullptr) {
+                    _monitor = new MonitorWorker(*this);
+
+                    // Wait till we are at least initialized
+                    _monitor->Wait(Thread::BLOCKED | Thread::STOPPED);
+                }
+
+                _monitor->Run();
+            } else {
+                Signal();
+            }
+
+            _adminLock.Unlock();
+        }
+        void Unregister(RESOURCE& resource)
+        {
+            _adminLock.Lock();
+
+            typename ResourceMap::iterator index(_resources.find(&resource));
+
+            if (index != _resources.end()) {
+                typename EntryMap::iterator entry(_entries.find(index->second));
+
+                ASSERT(entry != _entries.end());
+
+                // The actual removal is done by the monitor thread.
+                entry->second.Resource = nullptr;
+                MarkDirty(index->second, entry->second);
+
+                _resources.erase(index);
+
+                Signal();
+            }
+
+            _adminLock.Unlock();
+
+            WaitForHandled(resource);
+        }
+        // Have all resources reevaluated, on the next run..
+        inline void Break()
+        {
+            ASSERT(_monitor != nullptr);
+
+            _evaluateAll = true;
+            Signal();
+        }
+        // Have only this resource reevaluated, on the next run..
+        inline void Break(RESOURCE& resource)
+        {
+            ASSERT(_monitor != nullptr);
+
+            _signalLock.Lock();
+            _signalled.push_back(&resource);
+            _signalLock.Unlock();
+
+            Signal();
+        }
+#else
         bool Info (const uint32_t position, Metadata& info) const
         {
             uint32_t count = position;
@@ -175,6 +373,7 @@ namespace Core {
             if (found == true) {
                 info.descriptor = (*index)->Descriptor();
                 info.classname  = typeid(*(*index)).name();
+                info.ready      = 0;
 
 #ifdef __LINUX__
                 info.monitor = _descriptorArray[position + 1].events;
@@ -222,15 +421,14 @@ namespace Core {
             typename std::list<RESOURCE*>::iterator index(std::find(_resourceList.begin(), _resourceList.end(), &resource));
 
             if (index != _resourceList.end()) {
-#ifdef __WINDOWS__
-                _resourceList.erase(index);
-#else
+                // The actual removal is done by the monitor thread.
                 *index = nullptr;
                 Break();
-#endif
             }
 
             _adminLock.Unlock();
+
+            WaitForHandled(resource);
         }
         inline void Break()
         {
@@ -250,8 +448,41 @@ namespace Core {
             ::WSASetEvent(_action);
 #endif
         };
+        inline void Break(RESOURCE& /* resource */)
+        {
+            Break();
+        }
+#endif
 
     private:
+        // Resources are handled without holding the _adminLock, so a Handle() can (un)register
+        // resources of other reactors without these waiting on each other. After an Unregister
+        // the resource is not handled anymore, but it might still be in the middle of it.
+        inline void WaitForHandled(const RESOURCE& resource) const
+        {
+            if ((_monitor != nullptr) && (_monitor->Id() != Thread::ThreadId())) {
+                while (_handling.load() == &resource) {
+                    ::SleepMs(1);
+                }
+            }
+        }
+        inline void Handle(RESOURCE* resource, const uint16_t flagsSet)
+        {
+            _handling = resource;
+
+            _adminLock.Unlock();
+
+            Arm<WATCHDOG>();
+
+            resource->Handle(flagsSet);
+
+            Reset<WATCHDOG>();
+
+            _adminLock.Lock();
+
+            _handling = nullptr;
+        }
+
         HAS_MEMBER(Arm, hasArm);
 
         template <typename TYPE>
@@ -283,7 +514,241 @@ namespace Core {
         }
 
     public:
-#ifdef __LINUX__
+#ifdef __RESOURCEMONITOR_EPOLL__
+        bool Initialize()
+        {
+            if (_epollDescriptor == -1) {
+                _epollDescriptor = ::epoll_create1(EPOLL_CLOEXEC);
+                _signalDescriptor = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+                ASSERT((_epollDescriptor != -1) && (_signalDescriptor != -1));
+
+                if ((_epollDescriptor != -1) && (_signalDescriptor != -1)) {
+                    struct epoll_event info;
+
+                    // The signal descriptor is always identified by id 0
+                    info.events = EPOLLIN;
+                    info.data.u64 = 0;
+
+                    if (::epoll_ctl(_epollDescriptor, EPOLL_CTL_ADD, _signalDescriptor, &info) != 0) {
+                        TRACE_L1("Could not add the signal descriptor to the epoll set. Error %d", errno);
+                    }
+                }
+            }
+
+            return ((_epollDescriptor != -1) && (_signalDescriptor != -1));
+        }
+
+        uint32_t Worker()
+        {
+            uint32_t delay = 0;
+
+            _monitorRuns++;
+
+            _adminLock.Lock();
+
+            // Only the resources that were handled, signalled or (un)registered since the
+            // previous run are asked for the events they are interested in.
+            Evaluate();
+
+            if (_entries.empty() == false) {
+                _adminLock.Unlock();
+
+                int result = ::epoll_wait(_epollDescriptor, _eventArray, FileDescriptorAllocation, -1);
+
+                _adminLock.Lock();
+
+                if (result == -1) {
+                    if (errno != EINTR) {
+                        TRACE_L1("epoll_wait failed with error <%d>", errno);
+                    }
+                    result = 0;
+                }
+
+                for (int index = 0; index < result; index++) {
+                    uint32_t id = static_cast<uint32_t>(_eventArray[index].data.u64);
+
+                    if (id == 0) {
+                        uint64_t VARIABLE_IS_NOT_USED value;
+                        ssize_t VARIABLE_IS_NOT_USED bytes = ::read(_signalDescriptor, &value, sizeof(value));
+                    } else {
+                        Dispatch(id, static_cast<uint16_t>(_eventArray[index].events & 0xFFFF));
+                    }
+                }
+
+                // Event if there is no event on them, resources that issued a break want to be handled,
+                // a break might be issued by this RESOURCE..
+                std::vector<RESOURCE*> signalled;
+
+                _signalLock.Lock();
+                signalled.swap(_signalled);
+                _signalLock.Unlock();
+
+                for (RESOURCE* resource : signalled) {
+                    typename ResourceMap::const_iterator index(_resources.find(resource));
+
+                    if (index != _resources.end()) {
+                        Dispatch(index->second, 0);
+                    }
+                }
+
+                if (_evaluateAll.exchange(false) == true) {
+                    std::vector<uint32_t> ids;
+
+                    ids.reserve(_entries.size());
+
+                    for (const std::pair<const uint32_t, Entry>& entry : _entries) {
+                        ids.push_back(entry.first);
+                    }
+                    for (const uint32_t id : ids) {
+                        Dispatch(id, 0);
+                    }
+                }
+            } else {
+                _monitor->Block();
+                delay = Core::infinite;
+            }
+
+            _adminLock.Unlock();
+
+            return (delay);
+        }
+
+    private:
+        inline void Signal()
+        {
+            uint64_t value = 1;
+            ssize_t VARIABLE_IS_NOT_USED bytes = ::write(_signalDescriptor, &value, sizeof(value));
+        }
+        inline void MarkDirty(const uint32_t id, Entry& entry)
+        {
+            if (entry.Dirty == false) {
+                entry.Dirty = true;
+                _dirty.push_back(id);
+            }
+        }
+        inline void Unsubscribe(Entry& entry)
+        {
+            if (entry.Descriptor != -1) {
+                // If the descriptor is already closed, it is already gone from the set..
+                ::epoll_ctl(_epollDescriptor, EPOLL_CTL_DEL, entry.Descriptor, nullptr);
+                entry.Descriptor = -1;
+            }
+            entry.Armed = false;
+        }
+        inline void Subscribe(const uint32_t id, Entry& entry, const uint16_t events, const int descriptor)
+        {
+            if ((entry.Descriptor != -1) && (entry.Descriptor != descriptor)) {
+                Unsubscribe(entry);
+            }
+
+            if ((entry.Armed == false) || (entry.Monitor != events)) {
+                struct epoll_event info;
+                int result;
+
+                // Resources are reported once, and rearmed after they have been
+                // handled and reevaluated, see Evaluate().
+                info.events = events | EPOLLONESHOT;
+                info.data.u64 = id;
+
+                if (entry.Descriptor == -1) {
+                    result = ::epoll_ctl(_epollDescriptor, EPOLL_CTL_ADD, descriptor, &info);
+
+                    if ((result != 0) && (errno == EEXIST)) {
+                        // A closed resource, sharing the same file, has not been removed yet.
+                        result = ::epoll_ctl(_epollDescriptor, EPOLL_CTL_MOD, descriptor, &info);
+                    }
+                } else {
+                    result = ::epoll_ctl(_epollDescriptor, EPOLL_CTL_MOD, descriptor, &info);
+                }
+
+                if (result == 0) {
+                    entry.Descriptor = descriptor;
+                    entry.Armed = true;
+                } else {
+                    TRACE_L1("Could not monitor descriptor %d. Error %d", descriptor, errno);
+                    entry.Descriptor = -1;
+                    entry.Armed = false;
+                }
+            }
+
+            entry.Monitor = events;
+        }
+        void Evaluate()
+        {
+            // First get rid of the resources that are unregistered, their descriptors
+            // might already be reused by newly registered resources.
+            for (uint32_t index = 0; index < _dirty.size(); index++) {
+                typename EntryMap::iterator entry(_entries.find(_dirty[index]));
+
+                if ((entry != _entries.end()) && (entry->second.Resource == nullptr)) {
+                    Unsubscribe(entry->second);
+                    _entries.erase(entry);
+                }
+            }
+
+            // Note that calling into the resources might (un)register resources, so
+            // the _dirty list can grow while we are iterating over it.
+            for (uint32_t index = 0; index < _dirty.size(); index++) {
+                const uint32_t id = _dirty[index];
+                typename EntryMap::iterator position(_entries.find(id));
+
+                if (position != _entries.end()) {
+                    Entry& entry(position->second);
+
+                    entry.Dirty = false;
+
+                    RESOURCE* resource = entry.Resource;
+                    uint16_t events = (resource != nullptr ? resource->Events() : 0);
+
+                    if (entry.Resource == nullptr) {
+                        // It got unregistered in the mean time..
+                        Unsubscribe(entry);
+                        _entries.erase(id);
+                    } else if (events == 0) {
+                        Unsubscribe(entry);
+
+                        typename ResourceMap::iterator index(_resources.find(resource));
+
+                        if ((index != _resources.end()) && (index->second == id)) {
+                            _resources.erase(index);
+                        }
+
+                        _entries.erase(id);
+                    } else {
+                        Subscribe(id, entry, events, resource->Descriptor());
+                    }
+                }
+            }
+
+            _dirty.clear();
+        }
+        void Dispatch(const uint32_t id, const uint16_t flagsSet)
+        {
+            typename EntryMap::iterator position(_entries.find(id));
+
+            // Events for ids that are not found belong to resources that are already removed.
+            if ((position != _entries.end()) && (position->second.Resource != nullptr)) {
+                Entry& entry(position->second);
+
+                if (flagsSet != 0) {
+                    entry.Armed = false;
+                    entry.Events = flagsSet;
+                    entry.Ready++;
+                }
+
+                // A dirty entry is already handled during this run, or is not evaluated yet.
+                if ((flagsSet != 0) || (entry.Dirty == false)) {
+                    MarkDirty(id, entry);
+
+                    // Entries may be added or removed while it is handled, entry is not valid after this.
+                    Handle(entry.Resource, flagsSet);
+                }
+            }
+        }
+
+    public:
+#elif defined(__LINUX__)
         bool Initialize()
         {
 #ifdef __APPLE__
@@ -332,7 +797,7 @@ namespace Core {
         }
 #endif
 
-#ifdef __LINUX__
+#if defined(__LINUX__) && !defined(__RESOURCEMONITOR_EPOLL__)
         uint32_t Worker()
         {
             uint32_t delay = 0;
@@ -416,12 +881,8 @@ namespace Core {
 
                         uint16_t flagsSet = _descriptorArray[fd_index].revents;
 
-                        Arm<WATCHDOG>();
-
                         // Event if the flagsSet == 0, call handle, maybe a break was issued by this RESOURCE..
-                        entry->Handle(flagsSet);
-
-                        Reset<WATCHDOG>();
+                        Handle(entry, flagsSet);
                     }
 
                     index++;
@@ -455,11 +916,9 @@ namespace Core {
 
                 RESOURCE* entry = (*index);
 
-                ASSERT(entry != nullptr);
-
-                uint16_t events = entry->Events();
+                uint16_t events;
 
-                if (events == 0) {
+                if ((entry == nullptr) || ((events = entry->Events()) == 0)) {
                     index = _resourceList.erase(index);
                 } else {
                     if ((events & 0x8000) != 0) {
@@ -485,22 +944,18 @@ namespace Core {
                 while (index != _resourceList.end()) {
                     RESOURCE* entry = (*index);
 
-                    ASSERT(index != _resourceList.end());
-                    ASSERT(entry != nullptr);
-
-                    WSANETWORKEVENTS networkEvents;
-
-                    // Re-enable monitoring for the next round..
-                    ::WSAEnumNetworkEvents(entry->Descriptor(), nullptr, &networkEvents);
-
-                    uint16_t flagsSet = static_cast<uint16_t>(networkEvents.lNetworkEvents);
+                    // The entry might have been removed from observing in the mean time...
+                    if (entry != nullptr) {
+                        WSANETWORKEVENTS networkEvents;
 
-                    Arm<WATCHDOG>();
+                        // Re-enable monitoring for the next round..
+                        ::WSAEnumNetworkEvents(entry->Descriptor(), nullptr, &networkEvents);
 
-                    // Event if the flagsSet == 0, call handle, maybe a break was issued by this RESOURCE..
-                    entry->Handle(flagsSet);
+                        uint16_t flagsSet = static_cast<uint16_t>(networkEvents.lNetworkEvents);
 
-                    Reset<WATCHDOG>();
+                        // Event if the flagsSet == 0, call handle, maybe a break was issued by this RESOURCE..
+                        Handle(entry, flagsSet);
+                    }
 
                     index++;
                 }
@@ -518,12 +973,27 @@ namespace Core {
     private:
         MonitorWorker* _monitor;
         mutable Core::CriticalSection _adminLock;
+#ifdef __RESOURCEMONITOR_EPOLL__
+        EntryMap _entries;
+        ResourceMap _resources;
+        std::vector<uint32_t> _dirty;
+        Core::CriticalSection _signalLock;
+        std::vector<RESOURCE*> _signalled;
+        std::atomic<bool> _evaluateAll;
+        uint32_t _entryId;
+#else
         std::list<RESOURCE*> _resourceList;
+#endif
+        std::atomic<RESOURCE*> _handling;
         uint32_t _monitorRuns;
         string _name;
         WATCHDOG _watchDog;
 
-#ifdef __LINUX__
+#ifdef __RESOURCEMONITOR_EPOLL__
+        int _epollDescriptor;
+        int _signalDescriptor;
+        struct epoll_event _eventArray[FileDescriptorAllocation];
+#elif defined(__LINUX__)
         uint32_t _descriptorArrayLength;
         struct ::pollfd* _descriptorArray;
         int _signalDescriptor;
@@ -564,12 +1034,17 @@ namespace Core {
     typedef ResourceMonitorType<IResource, Void> ResourceMonitorBase;
 #endif
 
-    class EXTERNAL ResourceMonitor : public ResourceMonitorBase {
+    // The ResourceMonitor distributes the resources over a number of reactors, each a
+    // ResourceMonitorBase with its own thread, so a resource that takes long to be handled
+    // only stalls the resources that share its reactor. A resource is assigned to a reactor
+    // based on its address, so no administration is needed to find it back on Unregister
+    // or Break. The number of reactors is fixed once the ResourceMonitor is created.
+    class EXTERNAL ResourceMonitor {
+    public:
+        typedef ResourceMonitorBase::Metadata Metadata;
+
     private:
-        ResourceMonitor()
-            : ResourceMonitorBase()
-        {
-        }
+        ResourceMonitor();
         ResourceMonitor(const ResourceMonitor&) = delete;
         ResourceMonitor& operator=(const ResourceMonitor&) = delete;
 
@@ -577,7 +1052,107 @@ namespace Core {
 
     public:
         static ResourceMonitor& Instance();
-        ~ResourceMonitor() {}
+
+        // Only effective if set before the first use of the ResourceMonitor.
+        static void Reactors(const uint8_t reactors)
+        {
+            _reactorCount = (reactors == 0 ? 1 : reactors);
+        }
+        ~ResourceMonitor();
+
+    public:
+        uint8_t Reactors() const
+        {
+            return (static_cast<uint8_t>(_reactors.size()));
+        }
+        const TCHAR* Name() const
+        {
+            return (_reactors[0]->Name());
+        }
+        uint32_t Runs() const
+        {
+            uint32_t result = 0;
+
+            for (const ResourceMonitorBase* reactor : _reactors) {
+                result += reactor->Runs();
+            }
+
+            return (result);
+        }
+        ::ThreadId Id(const uint8_t reactor = 0) const
+        {
+            return (reactor < _reactors.size() ? _reactors[reactor]->Id() : 0);
+        }
+        // Is the given thread one of the threads handling the resources.
+        bool IsReactor(const ::ThreadId id) const
+        {
+            uint8_t index = 0;
+
+            while ((index < _reactors.size()) && (_reactors[index]->Id() != id)) {
+                index++;
+            }
+
+            return (index < _reactors.size());
+        }
+        uint32_t Count() const
+        {
+            uint32_t result = 0;
+
+            for (const ResourceMonitorBase* reactor : _reactors) {
+                result += reactor->Count();
+            }
+
+            return (result);
+        }
+        bool Info(const uint32_t position, Metadata& info) const
+        {
+            uint32_t index = position;
+            uint8_t reactor = 0;
+
+            while ((reactor < _reactors.size()) && (_reactors[reactor]->Info(index, info) == false)) {
+                uint32_t count = _reactors[reactor]->Count();
+                index = (index > count ? index - count : 0);
+                reactor++;
+            }
+
+            return (reactor < _reactors.size());
+        }
+        void Register(IResource& resource)
+        {
+            Reactor(resource).Register(resource);
+        }
+        void Unregister(IResource& resource)
+        {
+            Reactor(resource).Unregister(resource);
+        }
+        void Break()
+        {
+            for (ResourceMonitorBase* reactor : _reactors) {
+                // Reactors that never had a resource assigned, have nothing to evaluate.
+                if (reactor->Id() != 0) {
+                    reactor->Break();
+                }
+            }
+        }
+        void Break(IResource& resource)
+        {
+            Reactor(resource).Break(resource);
+        }
+
+    private:
+        inline ResourceMonitorBase& Reactor(const IResource& resource)
+        {
+            // Objects are at least 8 bytes aligned, drop the bits that never change and
+            // spread the rest over the reactors.
+            const uint32_t hash = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&resource) >> 3) * 2654435761u;
+
+            return (*_reactors[(hash >> 16) % _reactors.size()]);
+        }
+
+    private:
+        std::vector<ResourceMonitorBase*> _reactors;
+
+        static uint8_t _reactorCount;
     };
 }
 } // namespace WPEFramework::Core
@@ -29,6 +29,9 @@
 #include <arpa/inet.h>
 #include <fcntl.h>
 #include <net/if.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
 #define __ERRORRESULT__ errno
 #define __ERROR_AGAIN__ EAGAIN
 #define __ERROR_WOULDBLOCK__ EWOULDBLOCK
@@ -44,6 +47,7 @@
 #include <execinfo.h>
 #include <signal.h>
 #include <sys/ioctl.h>
+#include <sys/sendfile.h>
 #include <sys/signalfd.h>
 #endif
 
@@ -195,6 +199,11 @@ namespace Core {
         , m_ReceivedNode()
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
+        , m_ReadBytes(0)
+        , m_SendBytes(0)
+        , m_SendOffset(0)
+        , m_Reference()
+        , m_ReferenceOffset(0)
     {
         TRACE_L5("Constructor SocketPort (NodeId&) <%p>", (this));
     }
@@ -216,6 +225,11 @@ namespace Core {
         , m_ReceivedNode()
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
+        , m_ReadBytes(0)
+        , m_SendBytes(0)
+        , m_SendOffset(0)
+        , m_Reference()
+        , m_ReferenceOffset(0)
     {
         NodeId::SocketInfo localAddress;
         socklen_t localSize = sizeof(localAddress);
@@ -306,6 +320,8 @@ namespace Core {
         m_ReadBytes = 0;
         m_SendBytes = 0;
         m_SendOffset = 0;
+        m_Reference.Length = 0;
+        m_ReferenceOffset = 0;
 
         if ((m_State & (SocketPort::LINK | SocketPort::OPEN | SocketPort::MONITOR)) == (SocketPort::LINK | SocketPort::OPEN)) {
             // Open up an accepted socket, but not yet added to the monitor.
@@ -414,7 +430,7 @@ namespace Core {
 #endif
                 }
 
-                ResourceMonitor::Instance().Break();
+                ResourceMonitor::Instance().Break(*this);
             }
 
             if (waitTime > 0) {
@@ -426,7 +442,7 @@ namespace Core {
 
                     // We probably did not get a response from the otherside on the close
                     // sloppy but let's forcefully close it
-                    ResourceMonitor::Instance().Break();
+                    ResourceMonitor::Instance().Break(*this);
 
                     closed = (WaitForClosure(Core::infinite) == Core::ERROR_NONE);
 
@@ -447,7 +463,7 @@ namespace Core {
         if ((m_State & (SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) {
 
             m_State |= SocketPort::WRITESLOT;
-            ResourceMonitor::Instance().Break();
+            ResourceMonitor::Instance().Break(*this);
         }
         m_syncAdmin.Unlock();
     }
@@ -618,7 +634,7 @@ namespace Core {
         // Right, a wait till connection is closed is requested..
         while ((waiting > 0) && (IsOpen() == false)) {
             // Make sure we aren't in the monitor thread waiting for close completion.
-            ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+            ASSERT(ResourceMonitor::Instance().IsReactor(Core::Thread::ThreadId()) == false);
 
             uint32_t sleepSlot = (waiting > SLEEPSLOT_TIME ? SLEEPSLOT_TIME : waiting);
 
@@ -653,7 +669,7 @@ namespace Core {
                 break;
             }
             // Make sure we aren't in the monitor thread waiting for close completion.
-            ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+            ASSERT(ResourceMonitor::Instance().IsReactor(Core::Thread::ThreadId()) == false);
 
             uint32_t sleepSlot = (waiting > SLEEPSLOT_TIME ? SLEEPSLOT_TIME : waiting);
 
@@ -682,7 +698,7 @@ namespace Core {
         // Right, a wait till connection is closed is requested..
         while ((waiting > 0) && (IsClosed() == false)) {
             // Make sure we aren't in the monitor thread waiting for close completion.
-            ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+            ASSERT(ResourceMonitor::Instance().IsReactor(Core::Thread::ThreadId()) == false);
 
             uint32_t sleepSlot = (waiting > SLEEPSLOT_TIME ? SLEEPSLOT_TIME : waiting);
 
@@ -807,21 +823,157 @@ namespace Core {
         return (::send(m_Socket, reinterpret_cast<const char*>(buffer), length, 0));
     }
 
+    /* virtual */ int32_t SocketPort::Write(const uint8_t buffer[], const uint16_t length, const uint8_t reference[], const uint32_t referenceLength) {
+        // Keep the total within what a single call can report..
+        const uint32_t referenced = std::min(referenceLength, static_cast<uint32_t>(0x40000000));
+
+#ifdef __WINDOWS__
+        WSABUF vector[2];
+        DWORD count = 0;
+        DWORD sent = 0;
+
+        if (length > 0) {
+            vector[count].buf = reinterpret_cast<CHAR*>(const_cast<uint8_t*>(buffer));
+            vector[count].len = length;
+            count++;
+        }
+        vector[count].buf = reinterpret_cast<CHAR*>(const_cast<uint8_t*>(reference));
+        vector[count].len = referenced;
+        count++;
+
+        return (::WSASend(m_Socket, vector, count, &sent, 0, nullptr, nullptr) == 0 ? static_cast<int32_t>(sent) : SOCKET_ERROR);
+#else
+        struct iovec vector[2];
+        struct msghdr message;
+        uint8_t count = 0;
+
+        if (length > 0) {
+            vector[count].iov_base = const_cast<uint8_t*>(buffer);
+            vector[count].iov_len = length;
+            count++;
+        }
+        vector[count].iov_base = const_cast<uint8_t*>(reference);
+        vector[count].iov_len = referenced;
+        count++;
+
+        ::memset(&message, 0, sizeof(message));
+        message.msg_iov = vector;
+        message.msg_iovlen = count;
+
+        return (static_cast<int32_t>(::sendmsg(m_Socket, &message, 0)));
+#endif
+    }
+
+    /* virtual */ int32_t SocketPort::Write(const uint8_t buffer[], const uint16_t length, const File::Handle source, const uint64_t offset, const uint32_t sourceLength) {
+#ifdef __LINUX__
+        int32_t result;
+
+        if (length > 0) {
+            // The buffer goes first, the file follows in the same segment(s).
+            result = static_cast<int32_t>(::send(m_Socket, reinterpret_cast<const char*>(buffer), length, MSG_MORE));
+        } else {
+            off_t position = static_cast<off_t>(offset);
+
+            result = static_cast<int32_t>(::sendfile(m_Socket, source, &position, std::min(sourceLength, static_cast<uint32_t>(0x40000000))));
+
+            if ((result < 0) && ((errno == EINVAL) || (errno == ENOSYS))) {
+                // Not all files can be spliced to a socket, those we map.
+                result = Mapped(buffer, length, source, offset, sourceLength);
+            }
+        }
+
+        return (result);
+#else
+        return (Mapped(buffer, length, source, offset, sourceLength));
+#endif
+    }
+
+    int32_t SocketPort::Mapped(const uint8_t buffer[], const uint16_t length, const File::Handle source, const uint64_t offset, const uint32_t sourceLength) {
+        // Do not map more than we can send in one go..
+        const uint32_t size = std::min(sourceLength, static_cast<uint32_t>(0x100000));
+        int32_t result = SOCKET_ERROR;
+
+#ifdef __WINDOWS__
+        SYSTEM_INFO info;
+        ::GetSystemInfo(&info);
+        const uint64_t base = offset - (offset % info.dwAllocationGranularity);
+        HANDLE mapping = ::CreateFileMapping(source, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (mapping != nullptr) {
+            const uint8_t* memory = static_cast<const uint8_t*>(::MapViewOfFile(mapping, FILE_MAP_READ, static_cast<DWORD>(base >> 32), static_cast<DWORD>(base & 0xFFFFFFFF), static_cast<SIZE_T>(offset - base) + size));
+
+            if (memory != nullptr) {
+                result = Write(buffer, length, &(memory[offset - base]), size);
+                ::UnmapViewOfFile(memory);
+            }
+            ::CloseHandle(mapping);
+        }
+#else
+        struct stat info;
+        uint32_t available = size;
+
+        if ((::fstat(source, &info) == 0) && (static_cast<uint64_t>(info.st_size) < (offset + size))) {
+            // The file shrunk, never map beyond its end, touching those pages raises a SIGBUS.
+            available = (static_cast<uint64_t>(info.st_size) > offset ? static_cast<uint32_t>(info.st_size - offset) : 0);
+        }
+
+        if (available == 0) {
+            result = (length > 0 ? Write(buffer, length) : 0);
+        } else {
+            const uint64_t base = offset - (offset % static_cast<uint64_t>(::sysconf(_SC_PAGESIZE)));
+            const size_t mapSize = static_cast<size_t>(offset - base) + available;
+            void* memory = ::mmap(nullptr, mapSize, PROT_READ, MAP_SHARED, source, static_cast<off_t>(base));
+
+            if (memory != MAP_FAILED) {
+                result = Write(buffer, length, &(static_cast<const uint8_t*>(memory)[offset - base]), available);
+                ::munmap(memory, mapSize);
+            }
+        }
+#endif
+
+        return (result);
+    }
+
+    void SocketPort::Cork(const bool enabled)
+    {
+#ifdef __LINUX__
+        int value = (enabled ? 1 : 0);
+        ::setsockopt(m_Socket, IPPROTO_TCP, TCP_CORK, &value, sizeof(value));
+#else
+        DEBUG_VARIABLE(enabled);
+#endif
+    }
+
     void SocketPort::Write()
     {
         bool dataLeftToSend = true;
+        bool corked = false;
 
         m_syncAdmin.Lock();
 
         m_State &= (~(SocketPort::WRITE | SocketPort::WRITESLOT));
 
         while (((m_State & (SocketPort::WRITE | SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) && (dataLeftToSend == true)) {
-            if (m_SendOffset == m_SendBytes) {
-                m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize);
+            if ((m_SendOffset == m_SendBytes) && (m_ReferenceOffset == m_Reference.Length)) {
+                m_Reference.Length = 0;
+                m_ReferenceOffset = 0;
+
+                if ((m_State & SocketPort::LINK) != 0) {
+                    m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize, m_Reference);
+                } else {
+                    m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize);
+                }
                 m_SendOffset = 0;
-                dataLeftToSend = (m_SendOffset != m_SendBytes);
+                dataLeftToSend = ((m_SendOffset != m_SendBytes) || (m_Reference.Length != 0));
 
                 ASSERT(m_SendBytes <= m_SendBufferSize);
+
+                // A full buffer is likely to be followed by more, hold back the partial TCP segments
+                // till we are done. Gathered writes do not need this, they hand it all over at once.
+                if ((corked == false) && (m_SendBytes == m_SendBufferSize) && ((m_State & SocketPort::LINK) != 0) && (m_Reference.Length == 0) && ((m_LocalNode.Type() == NodeId::TYPE_IPV4) || (m_LocalNode.Type() == NodeId::TYPE_IPV6))) {
+                    Cork(true);
+                    corked = true;
+                }
             }
 
             if (dataLeftToSend == true) {
@@ -838,12 +990,34 @@ namespace Core {
                         static_cast<const NodeId&>(m_RemoteNode),
                         m_RemoteNode.Size());
 
+                } else if ((m_ReferenceOffset != m_Reference.Length) && (m_Reference.Data != nullptr)) {
+                    sendSize = Write(&(m_SendBuffer[m_SendOffset]), m_SendBytes - m_SendOffset, &(m_Reference.Data[m_ReferenceOffset]), m_Reference.Length - m_ReferenceOffset);
+                } else if (m_ReferenceOffset != m_Reference.Length) {
+                    sendSize = Write(&(m_SendBuffer[m_SendOffset]), m_SendBytes - m_SendOffset, m_Reference.Source, m_Reference.Offset + m_ReferenceOffset, m_Reference.Length - m_ReferenceOffset);
+
+                    if ((sendSize == 0) && (m_SendOffset == m_SendBytes)) {
+                        // Nothing left to read, the file ends before the announced length. Waiting will not
+                        // change that, so give up on this connection in stead of retrying forever.
+                        printf("Write exception: file ends %d bytes short\n", m_Reference.Length - m_ReferenceOffset);
+                        m_State |= SocketPort::EXCEPTION;
+                        StateChange();
+                    }
                 } else {
                     sendSize = Write(&(m_SendBuffer[m_SendOffset]), m_SendBytes - m_SendOffset);
                 }
 
                 if (sendSize >= 0) {
-                    m_SendOffset = ((m_State & SocketPort::LINK) != 0 ? m_SendOffset + sendSize : m_SendBytes);
+                    if ((m_State & SocketPort::LINK) == 0) {
+                        m_SendOffset = m_SendBytes;
+                    } else {
+                        // First the buffer is sent, what remains comes from the reference.
+                        uint32_t buffered = std::min(static_cast<uint32_t>(sendSize), static_cast<uint32_t>(m_SendBytes - m_SendOffset));
+
+                        m_SendOffset += static_cast<uint16_t>(buffered);
+                        m_ReferenceOffset += (static_cast<uint32_t>(sendSize) - buffered);
+
+                        ASSERT(m_ReferenceOffset <= m_Reference.Length);
+                    }
                 } else {
                     uint32_t l_Result = __ERRORRESULT__;
 
@@ -858,6 +1032,10 @@ namespace Core {
             }
         }
 
+        if (corked == true) {
+            Cork(false);
+        }
+
         m_syncAdmin.Unlock();
     }
 
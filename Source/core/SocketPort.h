@@ -24,6 +24,7 @@
 #ifndef __SOCKETPORT_H
 #define __SOCKETPORT_H
 
+#include "FileSystem.h"
 #include "Module.h"
 #include "NodeId.h"
 #include "Portability.h"
@@ -81,6 +82,16 @@ namespace Core {
 
         } enumType;
 
+        // Data a link keeps alive itself, until the next SendData call, and that is sent right
+        // after the data copied into the send buffer, without being copied itself. If there is
+        // no Data, the Length bytes are taken from the file Source, starting at Offset.
+        struct Reference {
+            const uint8_t* Data;
+            uint32_t Length;
+            File::Handle Source;
+            uint64_t Offset;
+        };
+
     public:
         SocketPort(const enumType socketType,
             const NodeId& localNode,
@@ -187,6 +198,8 @@ namespace Core {
             m_ReadBytes = 0;
             m_SendBytes = 0;
             m_SendOffset = 0;
+            m_Reference.Length = 0;
+            m_ReferenceOffset = 0;
             m_syncAdmin.Unlock();
         }
 
@@ -211,6 +224,14 @@ namespace Core {
         virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
         virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
 
+        // Connected sockets offer the link to hand over a reference to (large) data, e.g. a body,
+        // next to what is copied in the dataFrame. Both go out in one gathered write. The
+        // referenced data must remain valid until the next call to SendData.
+        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize, Reference& /* reference */)
+        {
+            return (SendData(dataFrame, maxSendSize));
+        }
+
         // Signal a state change, Opened, Closed or Accepted
         virtual void StateChange() = 0;
 
@@ -227,6 +248,14 @@ namespace Core {
         virtual bool Initialize();
         virtual int32_t Read(uint8_t buffer[], const uint16_t length) const;
         virtual int32_t Write(const uint8_t buffer[], const uint16_t length);
+        // Gathered write of the buffer followed by the referenced data. Links that override the
+        // plain Write (e.g. TLS), should not hand out references or override this one as well.
+        virtual int32_t Write(const uint8_t buffer[], const uint16_t length, const uint8_t reference[], const uint32_t referenceLength);
+        // Same as above, with the referenced data coming from a file. Where possible (Linux) the
+        // file is handed to the kernel (sendfile), otherwise it is sent through Mapped.
+        virtual int32_t Write(const uint8_t buffer[], const uint16_t length, const File::Handle source, const uint64_t offset, const uint32_t sourceLength);
+        // Maps the requested part of the file and sends it using the gathered Write above.
+        int32_t Mapped(const uint8_t buffer[], const uint16_t length, const File::Handle source, const uint64_t offset, const uint32_t sourceLength);
 
     private:
         virtual IResource::handle Descriptor() const override
@@ -244,6 +273,7 @@ namespace Core {
         void Accepted();
         void Read();
         void Write();
+        void Cork(const bool enabled);
         void BufferAlignment(SOCKET socket);
         SOCKET ConstructSocket(NodeId& localNode, const string& interfaceName);
         uint32_t WaitForOpen(const uint32_t time) const;
@@ -265,6 +295,8 @@ namespace Core {
         uint16_t m_ReadBytes;
         uint16_t m_SendBytes;
         uint16_t m_SendOffset;
+        Reference m_Reference;
+        uint32_t m_ReferenceOffset;
     };
 
     class EXTERNAL SocketStream : public SocketPort {
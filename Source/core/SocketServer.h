@@ -123,12 +123,21 @@ namespace Core {
             SocketHandler(const SocketHandler<HANDLECLIENT>&) = delete;
             SocketHandler<HANDLECLIENT>& operator=(const SocketHandler<HANDLECLIENT>&) = delete;
 
+            // Clients are spread over shards on their ID, each with its own lock. Sending to a client
+            // only takes the lock of its shard, and only for the lookup, so senders hardly ever meet
+            // each other, nor the accept or a cleanup that is busy with another shard.
+            enum { Shards = 16 };
+
+            struct Shard {
+                mutable Core::CriticalSection Lock;
+                std::map<uint32_t, ProxyType<HANDLECLIENT>> Clients;
+            };
+
         public:
             SocketHandler(SocketServerType<CLIENT>* parent)
                 : SocketListner()
                 , _nextClient(1)
-                , _lock()
-                , _clients()
+                , _count(0)
                 , _parent(*parent)
             {
 
@@ -137,8 +146,7 @@ namespace Core {
             SocketHandler(const NodeId& listenNode, SocketServerType<CLIENT>* parent)
                 : SocketListner(listenNode)
                 , _nextClient(1)
-                , _lock()
-                , _clients()
+                , _count(0)
                 , _parent(*parent)
             {
 
@@ -149,44 +157,48 @@ namespace Core {
                 Close(Core::infinite);
                 CloseClients();
 
-                _lock.Lock();
+                for (Shard& shard : _shards) {
+                    shard.Lock.Lock();
 
-                while (_clients.size() > 0) {
-                    ProxyType<HANDLECLIENT> client = _clients.begin()->second;
+                    while (shard.Clients.size() > 0) {
+                        ProxyType<HANDLECLIENT> client = shard.Clients.begin()->second;
 
-                    while (client->IsClosed() == false) {
-                        SleepMs(10);
-                    }
+                        while (client->IsClosed() == false) {
+                            SleepMs(10);
+                        }
 
-                    _clients.erase(_clients.begin());
+                        shard.Clients.erase(shard.Clients.begin());
+                        _count--;
 
-                    client.Release();
-                }
+                        client.Release();
+                    }
 
-                _lock.Unlock();
+                    shard.Lock.Unlock();
+                }
             }
 
         public:
             inline uint32_t Count() const
             {
-                return (static_cast<uint32_t>(_clients.size()));
+                return (_count.load(std::memory_order_relaxed));
             }
             template <typename PACKAGE>
             uint32_t Submit(const uint32_t ID, PACKAGE package)
             {
                 uint32_t result = Core::ERROR_UNAVAILABLE;
+                Shard& shard(Find(ID));
 
-                _lock.Lock();
+                shard.Lock.Lock();
 
-                typename ClientMap::iterator index = _clients.find(ID);
+                typename ClientMap::iterator index = shard.Clients.find(ID);
 
-                if (index == _clients.end()) {
-                    _lock.Unlock();
+                if (index == shard.Clients.end()) {
+                    shard.Lock.Unlock();
                 }
                 else {
                     // Oke connection still exists, send the message..
                     Core::ProxyType<HANDLECLIENT> client (index->second);
-                    _lock.Unlock();
+                    shard.Lock.Unlock();
 
                     client->Submit(package);
                     client.Release();
@@ -198,11 +210,15 @@ namespace Core {
             }
             inline Iterator Clients() const
             {
-                _lock.Lock();
-                Iterator result(_clients);
-                _lock.Unlock();
+                ClientMap clients;
 
-                return (result);
+                for (const Shard& shard : _shards) {
+                    shard.Lock.Lock();
+                    clients.insert(shard.Clients.begin(), shard.Clients.end());
+                    shard.Lock.Unlock();
+                }
+
+                return (Iterator(clients));
             }
             inline void LocalNode(const Core::NodeId& localNode)
             {
@@ -210,48 +226,82 @@ namespace Core {
             }
             inline void Suspend(const uint32_t ID)
             {
-                _lock.Lock();
+                Shard& shard(Find(ID));
 
-                typename ClientMap::iterator index = _clients.find(ID);
+                shard.Lock.Lock();
 
-                if (index != _clients.end()) {
+                typename ClientMap::iterator index = shard.Clients.find(ID);
+
+                if (index != shard.Clients.end()) {
                     // Oke connection still exists, send the message..
                     index->second->Close(0);
                 }
 
-                _lock.Unlock();
+                shard.Lock.Unlock();
             }
             inline void CloseClients()
             {
-                _lock.Lock();
+                for (Shard& shard : _shards) {
+                    shard.Lock.Lock();
 
-                typename ClientMap::iterator index = _clients.begin();
+                    typename ClientMap::iterator index = shard.Clients.begin();
 
-                while (index != _clients.end()) {
-                    // Oke connection still exists, send the message..
-                    index->second->Close(0);
-                    ++index;
-                }
+                    while (index != shard.Clients.end()) {
+                        // Oke connection still exists, send the message..
+                        index->second->Close(0);
+                        ++index;
+                    }
 
-                _lock.Unlock();
+                    shard.Lock.Unlock();
+                }
             }
             void Cleanup()
             {
-                _lock.Lock();
+                for (Shard& shard : _shards) {
+                    std::list<ProxyType<HANDLECLIENT>> closed;
+                    std::list<std::pair<uint32_t, ProxyType<HANDLECLIENT>>> suspended;
+
+                    shard.Lock.Lock();
+
+                    // Check if we can remove closed clients.
+                    typename ClientMap::iterator index = shard.Clients.begin();
+
+                    while (index != shard.Clients.end()) {
+                        if (index->second->IsClosed() == true) {
+                            // Step forward but remember where we were and delete that one....
+                            closed.push_back(index->second);
+                            index = shard.Clients.erase(index);
+                            _count--;
+                        } else {
+                            if (index->second->IsSuspended() == true) {
+                                suspended.push_back(*index);
+                            }
+                            index++;
+                        }
+                    }
+
+                    shard.Lock.Unlock();
 
-                // Check if we can remove closed clients.
-                typename ClientMap::iterator index = _clients.begin();
+                    // Closing a suspended client may take a while, do not keep the senders waiting for it.
+                    for (std::pair<uint32_t, ProxyType<HANDLECLIENT>>& entry : suspended) {
+                        if (entry.second->Close(100) == Core::ERROR_NONE) {
+                            shard.Lock.Lock();
 
-                while (index != _clients.end()) {
-                    if ((index->second->IsClosed() == true) || ((index->second->IsSuspended() == true) && (index->second->Close(100) == Core::ERROR_NONE))) {
-                        // Step forward but remember where we were and delete that one....
-                        index = _clients.erase(index);
-                    } else {
-                        index++;
+                            index = shard.Clients.find(entry.first);
+
+                            if (index != shard.Clients.end()) {
+                                closed.push_back(index->second);
+                                shard.Clients.erase(index);
+                                _count--;
+                            }
+
+                            shard.Lock.Unlock();
+                        }
                     }
-                }
 
-                _lock.Unlock();
+                    // The last reference might be in here, so destruct outside the lock.
+                    closed.clear();
+                }
             }
             virtual void Accept(SOCKET& newClient, const NodeId& remoteId)
             {
@@ -263,27 +313,41 @@ namespace Core {
                 // What is left, is opening up the socket, make sure the administration is coorect :-)
                 if (client->Open(0) == ERROR_NONE) {
 
-                    _lock.Lock();
+                    const uint32_t id = _nextClient++;
+                    Shard& shard(Find(id));
+
+                    shard.Lock.Lock();
 
                     // If the CLient has a method to receive it's Id pass it on..
-                    __Id<HANDLECLIENT>(*client, _nextClient);
+                    __Id<HANDLECLIENT>(*client, id);
 
                     // A new connection is available, open up a new client
-                    _clients.insert(std::pair<uint32_t, ProxyType<HANDLECLIENT>>(_nextClient++, client));
+                    shard.Clients.insert(std::pair<uint32_t, ProxyType<HANDLECLIENT>>(id, client));
+                    _count++;
 
-                    _lock.Unlock();
+                    shard.Lock.Unlock();
+                }
+            }
+            // Blocks all changes to the client administration, use sparingly as it also blocks all senders.
+            void Lock() 
+            {
+                for (Shard& shard : _shards) {
+                    shard.Lock.Lock();
                 }
             }
-			void Lock() 
-			{
-                _lock.Lock();
-			}
             void Unlock()
             {
-                _lock.Unlock();
+                for (uint8_t index = Shards; index > 0; index--) {
+                    _shards[index - 1].Lock.Unlock();
+                }
             }
 
         private:
+            inline Shard& Find(const uint32_t ID)
+            {
+                return (_shards[ID % Shards]);
+            }
+
             // -----------------------------------------------------
             // Check for Id  method on Object
             // -----------------------------------------------------
@@ -306,8 +370,8 @@ namespace Core {
 
         private:
             uint32_t _nextClient;
-            mutable Core::CriticalSection _lock;
-            std::map<uint32_t, ProxyType<HANDLECLIENT>> _clients;
+            std::atomic<uint32_t> _count;
+            Shard _shards[Shards];
             SocketServerType<CLIENT>& _parent;
         };
 
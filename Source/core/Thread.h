@@ -40,7 +40,7 @@ namespace Core {
 #ifdef __POSIX__
         static void destruct(void* value)
         {
-            printf("Destructor ThreadControlBlockInfo <0x%p>\n", value);
+            TRACE_L5("Destructor ThreadControlBlockInfo <0x%p>", value);
             if (value != nullptr) {
                 delete reinterpret_cast<THREADLOCALSTORAGE*>(value);
             }
@@ -251,7 +251,396 @@ namespace Core {
 
     class EXTERNAL ThreadPool {
     public:
-        typedef Core::QueueType< Core::ProxyType<IDispatch> > MessageQueue;
+        // Jobs submitted by one of the threads of the pool, are queued on the queue owned by that
+        // thread, all other jobs go into the shared (injection) queue. A thread that runs out of
+        // work looks in the shared queue and steals from the other threads before it goes to
+        // sleep. A submission only wakes one sleeping thread.
+        class EXTERNAL Scheduler {
+        private:
+            static constexpr uint32_t LocalSlots = 64;
+
+            class Ring {
+            public:
+                Ring() = delete;
+                Ring(const Ring&) = delete;
+                Ring& operator=(const Ring&) = delete;
+
+                Ring(const uint32_t size)
+                    : _slots(size)
+                    , _head(0)
+                    , _count(0)
+                {
+                }
+                ~Ring() = default;
+
+            public:
+                // Can be read without holding the lock, as a hint.
+                uint32_t Length() const
+                {
+                    return (_count);
+                }
+                bool Push(const Core::ProxyType<IDispatch>& job)
+                {
+                    bool result = (_count < _slots.size());
+
+                    if (result == true) {
+                        _slots[(_head + _count) % _slots.size()] = job;
+                        _count++;
+                    }
+
+                    return (result);
+                }
+                bool Pop(Core::ProxyType<IDispatch>& job)
+                {
+                    bool result = (_count > 0);
+
+                    if (result == true) {
+                        job = _slots[_head];
+                        _slots[_head].Release();
+                        _head = (_head + 1) % _slots.size();
+                        _count--;
+                    }
+
+                    return (result);
+                }
+                bool Remove(const Core::ProxyType<IDispatch>& job)
+                {
+                    const uint32_t size = static_cast<uint32_t>(_slots.size());
+                    const uint32_t count = _count;
+                    uint32_t index = 0;
+
+                    while ((index < count) && (_slots[(_head + index) % size] != job)) {
+                        index++;
+                    }
+
+                    bool result = (index < count);
+
+                    if (result == true) {
+                        // Close the gap, to keep the order of the remaining jobs.
+                        for (; index < (count - 1); index++) {
+                            _slots[(_head + index) % size] = _slots[(_head + index + 1) % size];
+                        }
+                        _slots[(_head + count - 1) % size].Release();
+                        _count--;
+                    }
+
+                    return (result);
+                }
+                void Clear()
+                {
+                    for (Core::ProxyType<IDispatch>& entry : _slots) {
+                        if (entry.IsValid() == true) {
+                            entry.Release();
+                        }
+                    }
+                    _head = 0;
+                    _count = 0;
+                }
+
+            private:
+                std::vector<Core::ProxyType<IDispatch>> _slots;
+                uint32_t _head;
+                std::atomic<uint32_t> _count;
+            };
+
+            class Slot {
+            public:
+                Slot(const Slot&) = delete;
+                Slot& operator=(const Slot&) = delete;
+
+                Slot()
+                    : Lock()
+                    , Queue(LocalSlots)
+                    , Signal(false, true)
+                    , Owner(0)
+                    , Parked(false)
+                {
+                }
+                ~Slot() = default;
+
+            public:
+                Core::CriticalSection Lock;
+                Ring Queue;
+                Core::Event Signal;
+                std::atomic<::ThreadId> Owner;
+                bool Parked;
+            };
+
+        public:
+            Scheduler() = delete;
+            Scheduler(const Scheduler&) = delete;
+            Scheduler& operator=(const Scheduler&) = delete;
+
+            Scheduler(const uint8_t slots, const uint32_t queueSize)
+                : _slotCount(slots)
+                , _slots(new Slot[slots])
+                , _attached(0)
+                , _injectionLock()
+                , _injection(queueSize)
+                , _pending(0)
+                , _maxPending(queueSize)
+                , _idleLock()
+                , _idle()
+                , _idleCount(0)
+                , _spaceLock()
+                , _space(false, true)
+                , _enabled(true)
+            {
+                // A highwatermark of 0 is bullshit.
+                ASSERT(_maxPending != 0);
+
+                _idle.reserve(slots);
+            }
+            ~Scheduler()
+            {
+                Disable();
+
+                _injection.Clear();
+                for (uint8_t index = 0; index < _slotCount; index++) {
+                    _slots[index].Queue.Clear();
+                }
+
+                delete[] _slots;
+            }
+
+        public:
+            // Every thread processing jobs from this scheduler needs a slot of its own.
+            uint8_t Attach()
+            {
+                uint8_t index = _attached++;
+
+                ASSERT(index < _slotCount);
+
+                return (index);
+            }
+            void Owner(const uint8_t index, const ::ThreadId id)
+            {
+                ASSERT(index < _slotCount);
+
+                _slots[index].Owner = id;
+            }
+            uint32_t Length() const
+            {
+                return (_pending);
+            }
+            bool Insert(const Core::ProxyType<IDispatch>& job, const uint32_t waitTime)
+            {
+                bool posted = Reserve(waitTime);
+
+                if (posted == true) {
+                    const uint8_t index = Current();
+                    bool queued = false;
+
+                    if (index < _slotCount) {
+                        Slot& slot(_slots[index]);
+
+                        slot.Lock.Lock();
+                        queued = slot.Queue.Push(job);
+                        slot.Lock.Unlock();
+                    }
+
+                    if (queued == false) {
+                        _injectionLock.Lock();
+                        // There is always room, the injection queue can hold all pending jobs.
+                        VARIABLE_IS_NOT_USED bool pushed = _injection.Push(job);
+                        ASSERT(pushed == true);
+                        _injectionLock.Unlock();
+                    }
+
+                    Wake();
+                }
+
+                return (posted);
+            }
+            bool Extract(const uint8_t index, Core::ProxyType<IDispatch>& job)
+            {
+                ASSERT(index < _slotCount);
+
+                bool found = false;
+                Slot& slot(_slots[index]);
+
+                while ((found == false) && (_enabled == true)) {
+
+                    found = Take(index, job);
+
+                    if (found == false) {
+                        // Nothing to do, go to sleep. Make sure we are on the idle list before the
+                        // last check, so a job that is submitted in the mean time wakes us.
+                        slot.Signal.ResetEvent();
+
+                        _idleLock.Lock();
+                        slot.Parked = true;
+                        _idle.push_back(index);
+                        _idleCount++;
+                        _idleLock.Unlock();
+
+                        if ((_pending == 0) && (_enabled == true)) {
+                            slot.Signal.Lock(Core::infinite);
+                        }
+
+                        Unpark(index);
+                    }
+                }
+
+                return (found);
+            }
+            bool Remove(const Core::ProxyType<IDispatch>& job)
+            {
+                _injectionLock.Lock();
+                bool removed = _injection.Remove(job);
+                _injectionLock.Unlock();
+
+                uint8_t index = 0;
+                while ((removed == false) && (index < _slotCount)) {
+                    Slot& slot(_slots[index]);
+
+                    slot.Lock.Lock();
+                    removed = slot.Queue.Remove(job);
+                    slot.Lock.Unlock();
+
+                    index++;
+                }
+
+                if (removed == true) {
+                    Released();
+                }
+
+                return (removed);
+            }
+            void Enable()
+            {
+                _enabled = true;
+            }
+            void Disable()
+            {
+                _enabled = false;
+
+                for (uint8_t index = 0; index < _slotCount; index++) {
+                    _slots[index].Signal.SetEvent();
+                }
+
+                _spaceLock.Lock();
+                _space.SetEvent();
+                _spaceLock.Unlock();
+            }
+
+        private:
+            uint8_t Current() const
+            {
+                const ::ThreadId id = Thread::ThreadId();
+                uint8_t index = 0;
+
+                while ((index < _slotCount) && (_slots[index].Owner != id)) {
+                    index++;
+                }
+
+                return (index);
+            }
+            bool Reserve(const uint32_t waitTime)
+            {
+                bool reserved = false;
+
+                while ((reserved == false) && (_enabled == true)) {
+                    uint32_t current = _pending;
+
+                    if (current < _maxPending) {
+                        reserved = _pending.compare_exchange_weak(current, current + 1);
+                    } else {
+                        _spaceLock.Lock();
+                        _space.ResetEvent();
+                        bool full = (_pending >= _maxPending);
+                        _spaceLock.Unlock();
+
+                        if ((full == true) && (_space.Lock(waitTime) != Core::ERROR_NONE)) {
+                            break;
+                        }
+                    }
+                }
+
+                return (reserved);
+            }
+            void Released()
+            {
+                if (_pending.fetch_sub(1) == _maxPending) {
+                    _spaceLock.Lock();
+                    _space.SetEvent();
+                    _spaceLock.Unlock();
+                }
+            }
+            bool Take(const uint8_t index, Core::ProxyType<IDispatch>& job)
+            {
+                bool found = false;
+
+                // First our own work, than the shared queue and as a last resort the work of others.
+                for (uint8_t offset = 0; (found == false) && (offset <= _slotCount); offset++) {
+                    if (offset == 1) {
+                        if (_injection.Length() > 0) {
+                            _injectionLock.Lock();
+                            found = _injection.Pop(job);
+                            _injectionLock.Unlock();
+                        }
+                    } else {
+                        Slot& slot(_slots[(index + (offset == 0 ? 0 : offset - 1)) % _slotCount]);
+
+                        if (slot.Queue.Length() > 0) {
+                            slot.Lock.Lock();
+                            found = slot.Queue.Pop(job);
+                            slot.Lock.Unlock();
+                        }
+                    }
+                }
+
+                if (found == true) {
+                    Released();
+                }
+
+                return (found);
+            }
+            void Wake()
+            {
+                if (_idleCount > 0) {
+                    Slot* slot = nullptr;
+
+                    _idleLock.Lock();
+                    if (_idle.empty() == false) {
+                        slot = &(_slots[_idle.back()]);
+                        slot->Parked = false;
+                        _idle.pop_back();
+                        _idleCount--;
+                    }
+                    _idleLock.Unlock();
+
+                    if (slot != nullptr) {
+                        slot->Signal.SetEvent();
+                    }
+                }
+            }
+            void Unpark(const uint8_t index)
+            {
+                _idleLock.Lock();
+                if (_slots[index].Parked == true) {
+                    _slots[index].Parked = false;
+                    _idle.erase(std::find(_idle.begin(), _idle.end(), index));
+                    _idleCount--;
+                }
+                _idleLock.Unlock();
+            }
+
+        private:
+            const uint8_t _slotCount;
+            Slot* _slots;
+            std::atomic<uint8_t> _attached;
+            Core::CriticalSection _injectionLock;
+            Ring _injection;
+            std::atomic<uint32_t> _pending;
+            const uint32_t _maxPending;
+            Core::CriticalSection _idleLock;
+            std::vector<uint8_t> _idle;
+            std::atomic<uint8_t> _idleCount;
+            Core::CriticalSection _spaceLock;
+            Core::Event _space;
+            std::atomic<bool> _enabled;
+        };
 
         template<typename IMPLEMENTATION>
         class JobType {
@@ -355,8 +744,9 @@ namespace Core {
             Minion(const Minion&) = delete;
             Minion& operator=(const Minion&) = delete;
 
-            Minion(MessageQueue& queue)
-                : _queue(queue)
+            Minion(Scheduler& scheduler)
+                : _scheduler(scheduler)
+                , _index(scheduler.Attach())
                 , _adminLock()
                 , _signal(false, false)
                 , _interestCount(0)
@@ -394,7 +784,9 @@ namespace Core {
             }
             void Process()
             {
-                while (_queue.Extract(_currentRequest, Core::infinite) == true) {
+                _scheduler.Owner(_index, Thread::ThreadId());
+
+                while (_scheduler.Extract(_index, _currentRequest) == true) {
 
                     ASSERT(_currentRequest.IsValid() == true);
 
@@ -418,10 +810,13 @@ namespace Core {
                     }
                     _adminLock.Unlock();
                 }
+
+                _scheduler.Owner(_index, 0);
             }
 
         private:
-            MessageQueue& _queue;
+            Scheduler& _scheduler;
+            const uint8_t _index;
             Core::CriticalSection _adminLock;
             Core::Event _signal;
             uint32_t _interestCount;
@@ -435,9 +830,9 @@ namespace Core {
             Executor(const Executor&) = delete;
             Executor& operator=(const Executor&) = delete;
 
-            Executor(MessageQueue* queue, const uint32_t stackSize, const TCHAR* name)
+            Executor(Scheduler* scheduler, const uint32_t stackSize, const TCHAR* name)
                 : Core::Thread(stackSize == 0 ? Core::Thread::DefaultStackSize() : stackSize, name)
-                , _minion(*queue)
+                , _minion(*scheduler)
             {
             }
             ~Executor() override
@@ -479,8 +874,9 @@ namespace Core {
         ThreadPool(const ThreadPool& a_Copy) = delete;
         ThreadPool& operator=(const ThreadPool& a_RHS) = delete;
 
+        // One slot more than there are threads, a thread can join the pool, see Minion.
         ThreadPool(const uint8_t count, const uint32_t stackSize, const uint32_t queueSize) 
-            : _queue(queueSize)
+            : _queue(count + 1, queueSize)
         {
             const TCHAR* name = _T("WorkerPool::Thread");
             for (uint8_t index = 0; index < count; index++) {
@@ -558,7 +954,7 @@ namespace Core {
 
             return (result);
         }
-        MessageQueue& Queue() {
+        Scheduler& Queue() {
             return (_queue);
         }
         void Run()
@@ -581,7 +977,7 @@ namespace Core {
         }
 
    private:
-        MessageQueue _queue;
+        Scheduler _queue;
         std::list<Executor> _units;
     };
 }
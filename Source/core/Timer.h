@@ -27,6 +27,7 @@
 #include "Sync.h"
 #include "Thread.h"
 #include "Time.h"
+#include <functional>
 #include <utility>
 
 // ---- Referenced classes and types ----
@@ -47,85 +48,394 @@
 namespace WPEFramework {
 namespace Core {
     template <typename CONTENT>
-    class TimerType {
+    class TimedInfoType {
+    public:
+        inline TimedInfoType()
+            : m_ScheduleTime(0)
+            , m_Info()
+        {
+        }
+
+        inline TimedInfoType(const uint64_t time, const CONTENT& contents)
+            : m_ScheduleTime(time)
+            , m_Info(contents)
+        {
+        }
+
+        inline TimedInfoType(const uint64_t time, CONTENT&& contents)
+            : m_ScheduleTime(time)
+            , m_Info(std::move(contents))
+        {
+        }
+
+        inline TimedInfoType(const TimedInfoType& copy)
+            : m_ScheduleTime(copy.m_ScheduleTime)
+            , m_Info(copy.m_Info)
+        {
+        }
+
+        inline TimedInfoType(TimedInfoType&& copy)
+            : m_ScheduleTime(copy.m_ScheduleTime)
+            , m_Info(std::move(copy.m_Info))
+        {
+        }
+
+        inline ~TimedInfoType()
+        {
+        }
+
+        inline TimedInfoType& operator=(const TimedInfoType& RHS)
+        {
+            m_ScheduleTime = RHS.m_ScheduleTime;
+            m_Info = RHS.m_Info;
+
+            return (*this);
+        }
+
+        inline TimedInfoType& operator=(TimedInfoType&& RHS)
+        {
+            m_ScheduleTime = RHS.m_ScheduleTime;
+            m_Info = std::move(RHS.m_Info);
+
+            return (*this);
+        }
+
+        inline uint64_t ScheduleTime() const
+        {
+            return (m_ScheduleTime);
+        }
+
+        inline void ScheduleTime(const uint64_t scheduleTime)
+        {
+            m_ScheduleTime = scheduleTime;
+        }
+
+        inline CONTENT& Content()
+        {
+            return (m_Info);
+        }
+
     private:
-        TimerType(const TimerType&);
-        TimerType& operator=(const TimerType&);
+        uint64_t m_ScheduleTime;
+        CONTENT m_Info;
+    };
 
+
+    // -------------------------------------------------------------------
+    // Administration of the pending entries of a TimerType, ordered on
+    // their schedule time. Entries with the same time keep the order in
+    // which they were scheduled.
+    // The TimerList keeps them in a sorted list, scheduling and revoking
+    // an entry is a linear walk through that list. It makes no demands
+    // on the CONTENT, so this is the default.
+    // -------------------------------------------------------------------
+    template <typename CONTENT>
+    class TimerList {
     private:
-        template <typename ACTIVECONTENT>
-        class TimedInfo {
-        public:
-            inline TimedInfo()
-                : m_ScheduleTime(0)
-                , m_Info()
-            {
-            }
+        typedef std::list<TimedInfoType<CONTENT>> SubscriberList;
 
-            inline TimedInfo(const uint64_t time, const ACTIVECONTENT& contents)
-                : m_ScheduleTime(time)
-                , m_Info(contents)
-            {
+    public:
+        TimerList(const TimerList<CONTENT>&) = delete;
+        TimerList<CONTENT>& operator=(const TimerList<CONTENT>&) = delete;
+
+        TimerList()
+            : m_PendingQueue()
+        {
+        }
+        ~TimerList() = default;
+
+    public:
+        inline bool IsEmpty() const
+        {
+            return (m_PendingQueue.empty());
+        }
+        inline uint32_t Count() const
+        {
+            return (static_cast<uint32_t>(m_PendingQueue.size()));
+        }
+        inline uint64_t NextTime() const
+        {
+            ASSERT(IsEmpty() == false);
+
+            return (m_PendingQueue.front().ScheduleTime());
+        }
+        inline void Clear()
+        {
+            m_PendingQueue.clear();
+        }
+        // Returns true if the entry is the first one to expire now.
+        bool Insert(TimedInfoType<CONTENT>&& infoBlock)
+        {
+            bool reevaluate = false;
+            typename SubscriberList::iterator index = m_PendingQueue.begin();
+
+            while ((index != m_PendingQueue.end()) && (infoBlock.ScheduleTime() >= (*index).ScheduleTime())) {
+                ++index;
             }
 
-            inline TimedInfo(const uint64_t time, ACTIVECONTENT&& contents)
-                : m_ScheduleTime(time)
-                , m_Info(std::move(contents))
-            {
+            if (index == m_PendingQueue.begin()) {
+                m_PendingQueue.push_front(std::move(infoBlock));
+
+                // If we added the new time up front, retrigger the scheduler.
+                reevaluate = true;
+            } else if (index == m_PendingQueue.end()) {
+                m_PendingQueue.push_back(std::move(infoBlock));
+            } else {
+                m_PendingQueue.insert(index, std::move(infoBlock));
             }
 
-            inline TimedInfo(const TimedInfo& copy)
-                : m_ScheduleTime(copy.m_ScheduleTime)
-                , m_Info(copy.m_Info)
-            {
+            return (reevaluate);
+        }
+        // Removes all entries matching the info, returns true if the first entry was removed.
+        bool Remove(const CONTENT& info, bool& found)
+        {
+            bool changedHead = false;
+            typename SubscriberList::iterator index = m_PendingQueue.begin();
+
+            found = false;
+
+            while (index != m_PendingQueue.end()) {
+                if (index->Content() == info) {
+                    changedHead |= (index == m_PendingQueue.begin());
+                    found = true;
+
+                    // Remove this... Found it, remove it.
+                    index = m_PendingQueue.erase(index);
+                } else {
+
+                    ++index;
+                }
             }
 
-            inline TimedInfo(TimedInfo&& copy)
-                : m_ScheduleTime(copy.m_ScheduleTime)
-                , m_Info(std::move(copy.m_Info))
+            return (changedHead);
+        }
+        TimedInfoType<CONTENT> Extract()
+        {
+            ASSERT(IsEmpty() == false);
+
+            TimedInfoType<CONTENT> info(std::move(m_PendingQueue.front()));
+
+            m_PendingQueue.pop_front();
+
+            return (info);
+        }
+
+    private:
+        SubscriberList m_PendingQueue;
+    };
+
+    // -------------------------------------------------------------------
+    // The TimerHeap keeps the entries in a 4-ary min heap, so scheduling
+    // and expiring an entry is O(log n) with a shallow tree. The heap
+    // itself is a contiguous array of small nodes carrying the schedule
+    // time, the CONTENT is never moved around. Next to the heap, the
+    // position of every entry is indexed on the hash of its CONTENT, so
+    // revoking (and rescheduling) an entry does not need to search for
+    // it. The HASH should return the same value for all CONTENT that
+    // compares equal.
+    // -------------------------------------------------------------------
+    template <typename CONTENT, typename HASH = std::hash<CONTENT>>
+    class TimerHeap {
+    private:
+        static constexpr uint32_t Ways = 4;
+
+        typedef std::unordered_multimap<size_t, uint32_t> Index;
+        typedef typename Index::value_type Handle;
+
+        struct Node {
+            uint64_t Time;
+            uint64_t Sequence;
+            TimedInfoType<CONTENT>* Info;
+            Handle* Reference;
+
+            inline bool operator<(const Node& rhs) const
             {
+                return ((Time < rhs.Time) || ((Time == rhs.Time) && (Sequence < rhs.Sequence)));
             }
+        };
 
-            inline ~TimedInfo()
-            {
+    public:
+        TimerHeap(const TimerHeap<CONTENT, HASH>&) = delete;
+        TimerHeap<CONTENT, HASH>& operator=(const TimerHeap<CONTENT, HASH>&) = delete;
+
+        TimerHeap()
+            : _heap()
+            , _index()
+            , _sequence(0)
+        {
+        }
+        ~TimerHeap()
+        {
+            Clear();
+        }
+
+    public:
+        inline bool IsEmpty() const
+        {
+            return (_heap.empty());
+        }
+        inline uint32_t Count() const
+        {
+            return (static_cast<uint32_t>(_heap.size()));
+        }
+        inline uint64_t NextTime() const
+        {
+            ASSERT(IsEmpty() == false);
+
+            return (_heap.front().Time);
+        }
+        inline void Clear()
+        {
+            for (Node& node : _heap) {
+                delete node.Info;
             }
+            _heap.clear();
+            _index.clear();
+        }
+        // Returns true if the entry is the first one to expire now.
+        bool Insert(TimedInfoType<CONTENT>&& infoBlock)
+        {
+            uint32_t position = static_cast<uint32_t>(_heap.size());
+            typename Index::iterator entry = _index.emplace(HASH()(infoBlock.Content()), position);
 
-            inline TimedInfo& operator=(const TimedInfo& RHS)
-            {
-                m_ScheduleTime = RHS.m_ScheduleTime;
-                m_Info = RHS.m_Info;
+            Node node = { infoBlock.ScheduleTime(), _sequence++, new TimedInfoType<CONTENT>(std::move(infoBlock)), &(*entry) };
+
+            _heap.push_back(node);
+
+            return (Up(position) == 0);
+        }
+        // Removes all entries matching the info, returns true if the first entry was removed.
+        bool Remove(const CONTENT& info, bool& found)
+        {
+            bool changedHead = false;
+            std::pair<typename Index::iterator, typename Index::iterator> range(_index.equal_range(HASH()(info)));
 
-                return (*this);
+            found = false;
+
+            while (range.first != range.second) {
+                uint32_t position = range.first->second;
+
+                if (_heap[position].Info->Content() == info) {
+                    changedHead |= (position == 0);
+                    found = true;
+
+                    delete _heap[position].Info;
+                    range.first = _index.erase(range.first);
+                    RemoveAt(position);
+                } else {
+                    ++range.first;
+                }
             }
 
-            inline TimedInfo& operator=(TimedInfo&& RHS)
-            {
-                m_ScheduleTime = RHS.m_ScheduleTime;
-                m_Info = std::move(RHS.m_Info);
+            return (changedHead);
+        }
+        TimedInfoType<CONTENT> Extract()
+        {
+            ASSERT(IsEmpty() == false);
+
+            TimedInfoType<CONTENT>* entry = _heap.front().Info;
+            TimedInfoType<CONTENT> info(std::move(*entry));
 
-                return (*this);
+            delete entry;
+            Unindex(_heap.front().Reference);
+            RemoveAt(0);
+
+            return (info);
+        }
+
+    private:
+        void Unindex(const Handle* handle)
+        {
+            std::pair<typename Index::iterator, typename Index::iterator> range(_index.equal_range(handle->first));
+
+            while ((range.first != range.second) && (&(*range.first) != handle)) {
+                ++range.first;
             }
 
-            inline uint64_t ScheduleTime() const
-            {
-                return (m_ScheduleTime);
+            ASSERT(range.first != range.second);
+
+            _index.erase(range.first);
+        }
+        void RemoveAt(const uint32_t position)
+        {
+            uint32_t last = static_cast<uint32_t>(_heap.size() - 1);
+
+            if (position != last) {
+                _heap[position] = _heap[last];
+                _heap.pop_back();
+
+                // The last one might have to go either way from here.
+                if (Up(position) == position) {
+                    Down(position);
+                }
+            } else {
+                _heap.pop_back();
             }
+        }
+        uint32_t Up(uint32_t position)
+        {
+            Node node(_heap[position]);
 
-            inline void ScheduleTime(const uint64_t scheduleTime)
-            {
-                m_ScheduleTime = scheduleTime;
+            while (position > 0) {
+                uint32_t parent = (position - 1) / Ways;
+
+                if ((node < _heap[parent]) == false) {
+                    break;
+                }
+
+                Place(position, _heap[parent]);
+                position = parent;
             }
 
-            inline ACTIVECONTENT& Content()
-            {
-                return (m_Info);
+            Place(position, node);
+
+            return (position);
+        }
+        void Down(uint32_t position)
+        {
+            const uint32_t count = static_cast<uint32_t>(_heap.size());
+            Node node(_heap[position]);
+
+            while ((position * Ways) + 1 < count) {
+                uint32_t first = (position * Ways) + 1;
+                uint32_t end = std::min(first + Ways, count);
+                uint32_t child = first;
+
+                for (uint32_t index = first + 1; index < end; index++) {
+                    if (_heap[index] < _heap[child]) {
+                        child = index;
+                    }
+                }
+
+                if ((_heap[child] < node) == false) {
+                    break;
+                }
+
+                Place(position, _heap[child]);
+                position = child;
             }
 
-        private:
-            uint64_t m_ScheduleTime;
-            ACTIVECONTENT m_Info;
-        };
+            Place(position, node);
+        }
+        inline void Place(const uint32_t position, const Node& node)
+        {
+            _heap[position] = node;
+            _heap[position].Reference->second = position;
+        }
 
+    private:
+        std::vector<Node> _heap;
+        Index _index;
+        uint64_t _sequence;
+    };
+
+    template <typename CONTENT, typename STORAGE = TimerList<CONTENT>>
+    class TimerType {
+    private:
+        TimerType(const TimerType&);
+        TimerType& operator=(const TimerType&);
+
+    private:
         class TimeWorker : public Thread {
         public:
             TimeWorker() = delete;
@@ -147,12 +457,9 @@ namespace Core {
             }
 
         private:
-            TimerType<CONTENT>& m_Parent;
+            TimerType<CONTENT, STORAGE>& m_Parent;
         };
 
-        typedef TimedInfo<CONTENT> TimeInfoBlocks;
-        typedef typename std::list<TimeInfoBlocks> SubscriberList;
-
     public:
         TimerType(const uint32_t stackSize, const TCHAR* timerName)
             : m_PendingQueue()
@@ -170,7 +477,7 @@ namespace Core {
             m_TimerThread.Stop();
 
             // Force kill on all pending stuff...
-            m_PendingQueue.clear();
+            m_PendingQueue.Clear();
             m_Admin.Unlock();
 
             m_TimerThread.Wait(Thread::BLOCKED|Thread::STOPPED, Core::infinite);
@@ -188,20 +495,20 @@ namespace Core {
 
         inline void Schedule(const uint64_t& time, CONTENT&& info)
         {
-            Schedule(TimedInfo<CONTENT>(time, std::move(info)));
+            Schedule(TimedInfoType<CONTENT>(time, std::move(info)));
         }
 
         inline void Schedule(const uint64_t& time, const CONTENT& info)
         {
-            Schedule(std::move(TimedInfo<CONTENT>(time, info)));
+            Schedule(std::move(TimedInfoType<CONTENT>(time, info)));
         }
 
     private:
-        void Schedule(TimedInfo<CONTENT>&& timeInfo)
+        void Schedule(TimedInfoType<CONTENT>&& timeInfo)
         {
             m_Admin.Lock();
 
-            if (ScheduleEntry(std::move(timeInfo)) == true) {
+            if (m_PendingQueue.Insert(std::move(timeInfo)) == true) {
                 m_TimerThread.Run();
             }
 
@@ -212,21 +519,14 @@ namespace Core {
 
         void Trigger(const uint64_t& time, const CONTENT& info)
         {
-            TimedInfo<CONTENT> newEntry(time, info);
+            TimedInfoType<CONTENT> newEntry(time, info);
+            bool found;
 
             m_Admin.Lock();
 
-            typename SubscriberList::iterator index = m_PendingQueue.begin();
-
-            while ((index != m_PendingQueue.end()) && ((*index).Content() != info)) {
-                ++index;
-            }
-
-            if (index != m_PendingQueue.end()) {
-                m_PendingQueue.erase(index);
-            }
+            m_PendingQueue.Remove(info, found);
 
-            if (ScheduleEntry(std::move(newEntry)) == true) {
+            if (m_PendingQueue.Insert(std::move(newEntry)) == true) {
                 m_TimerThread.Run();
             }
 
@@ -239,12 +539,10 @@ namespace Core {
 
             m_Admin.Lock();
 
-            typename SubscriberList::iterator index = m_PendingQueue.begin();
-
             // Since we have the admin lock, we are pretty sure that there is not any
             // context running, so we can be pretty sure that if it was scheduled, it
             // is gone !!!
-            if (RemoveEntry(index, info, foundElement) == true) {
+            if (m_PendingQueue.Remove(info, foundElement) == true) {
 
                 // If we added the new time up front, retrigger the scheduler.
                 m_TimerThread.Run();
@@ -262,7 +560,7 @@ namespace Core {
 
         uint32_t Pending() const
         {
-            return (m_PendingQueue.size());
+            return (m_PendingQueue.Count());
         }
 
         ::ThreadId ThreadId() const
@@ -282,11 +580,9 @@ namespace Core {
             // Ranging from 0-Core::infinite
             m_TimerThread.Block();
 
-            while ((m_PendingQueue.empty() == false) && (m_PendingQueue.front().ScheduleTime() <= now)) {
-                TimedInfo<CONTENT> info(std::move(m_PendingQueue.front()));
-
+            while ((m_PendingQueue.IsEmpty() == false) && (m_PendingQueue.NextTime() <= now)) {
                 // Make sure we loose the current one before we do the call, that one might add ;-)
-                m_PendingQueue.pop_front();
+                TimedInfoType<CONTENT> info(m_PendingQueue.Extract());
 
                 m_Admin.Unlock();
 
@@ -298,24 +594,24 @@ namespace Core {
                     ASSERT(reschedule > now);
 
                     info.ScheduleTime(reschedule);
-                    ScheduleEntry(std::move(info));
+                    m_PendingQueue.Insert(std::move(info));
                 }
             }
 
             // Calculate the delay...
-            if (m_PendingQueue.empty() == true) {
+            if (m_PendingQueue.IsEmpty() == true) {
                 m_NextTrigger = NUMBER_MAX_UNSIGNED(uint64_t);
             } else {
                 // Refresh the time, just to be on the safe side...
                 uint64_t delta = Time::Now().Ticks();
 
-                if (delta >= m_PendingQueue.front().ScheduleTime()) {
+                if (delta >= m_PendingQueue.NextTime()) {
                     m_NextTrigger = delta;
                     delayTime = 0;
                 } else {
                     // The windows counter is in 100ns intervals dus we mmoeten even delen door  1000 (us) * 10 ns = 10.000
                     // om de waarde in ms te krijgen.
-                    m_NextTrigger = m_PendingQueue.front().ScheduleTime();
+                    m_NextTrigger = m_PendingQueue.NextTime();
                     delayTime = static_cast<uint32_t>((m_NextTrigger - delta) / Time::TicksPerMillisecond);
                 }
             }
@@ -326,52 +622,7 @@ namespace Core {
         }
 
     private:
-        bool ScheduleEntry(TimedInfo<CONTENT>&& infoBlock)
-        {
-            bool reevaluate = false;
-            typename SubscriberList::iterator index = m_PendingQueue.begin();
-
-            while ((index != m_PendingQueue.end()) && (infoBlock.ScheduleTime() >= (*index).ScheduleTime())) {
-                ++index;
-            }
-
-            if (index == m_PendingQueue.begin()) {
-                m_PendingQueue.push_front(std::move(infoBlock));
-
-                // If we added the new time up front, retrigger the scheduler.
-                reevaluate = true;
-            } else if (index == m_PendingQueue.end()) {
-                m_PendingQueue.push_back(std::move(infoBlock));
-            } else {
-                m_PendingQueue.insert(index, std::move(infoBlock));
-            }
-
-            return (reevaluate);
-        }
-        bool RemoveEntry(typename SubscriberList::iterator& index, const CONTENT& info, bool& found)
-        {
-            bool changedHead = false;
-
-            found = false;
-
-            while (index != m_PendingQueue.end()) {
-                if (index->Content() == info) {
-                    changedHead |= (index == m_PendingQueue.begin());
-                    found = true;
-
-                    // Remove this... Found it, remove it.
-                    index = m_PendingQueue.erase(index);
-                } else {
-
-                    ++index;
-                }
-            }
-
-            return (changedHead);
-        }
-
-    private:
-        SubscriberList m_PendingQueue;
+        STORAGE m_PendingQueue;
         TimeWorker m_TimerThread;
         CriticalSection m_Admin;
         uint64_t m_NextTrigger;
@@ -125,6 +125,14 @@ namespace Core {
             {
             }
 
+        public:
+            struct Hash {
+                size_t operator()(const Timer& timer) const
+                {
+                    return (std::hash<const IDispatch*>()(timer._job.IsValid() ? timer._job.operator->() : nullptr));
+                }
+            };
+
         public:
             bool operator==(const Timer& RHS) const
             {
@@ -253,7 +261,7 @@ namespace Core {
     private:
         ThreadPool _threadPool;
         ThreadPool::Minion _external;
-        Core::TimerType<Timer> _timer;
+        Core::TimerType<Timer, Core::TimerHeap<Timer, Timer::Hash>> _timer;
         mutable Metadata _metadata;
         ::ThreadId _joined;
     };
@@ -49,6 +49,7 @@
 #include "Factory.h"
 #include "FileSystem.h"
 #include "Frame.h"
+#include "Histogram.h"
 #include "IPCMessage.h"
 #include "IPCChannel.h"
 #include "IPCConnector.h"
@@ -48,21 +48,234 @@ namespace WPEFramework {
 
 namespace Crypto {
 
+namespace {
+
+    // The SSL context is shared by all secure sockets, setting it up is expensive. Next to that it
+    // remembers the last session per remote node, so a reconnect can skip the full handshake. If
+    // there are too many, the session of the remote that was not used the longest goes first.
+    class Context {
+    private:
+        typedef std::list<string> UseOrder;
+
+        struct Session {
+            SSL_SESSION* Handle;
+            UseOrder::iterator Used;
+        };
+
+        typedef std::map<string, Session> Sessions;
+
+    public:
+        Context(const Context&) = delete;
+        Context& operator=(const Context&) = delete;
+
+        Context()
+            : _adminLock()
+            , _context(nullptr)
+            , _sessions()
+            , _order()
+            , _maxSessions(32)
+            , _timeout(300)
+            , _tickets(true)
+            , _full(0)
+            , _resumed(0)
+        {
+        }
+        ~Context()
+        {
+            for (std::pair<const string, Session>& entry : _sessions) {
+                SSL_SESSION_free(entry.second.Handle);
+            }
+            if (_context != nullptr) {
+                SSL_CTX_free(_context);
+            }
+        }
+
+        static Context& Instance()
+        {
+            static Context singleton;
+            return (singleton);
+        }
+
+    public:
+        SSL_CTX* Handle()
+        {
+            _adminLock.Lock();
+
+            if (_context == nullptr) {
+                // _context = SSL_CTX_new(TLS_method());
+                _context = SSL_CTX_new(SSLv23_method());
+
+                // OpenSSL only tells the client about its sessions, it does not look them up by itself.
+                SSL_CTX_sess_set_new_cb(_context, NewSession);
+
+                Apply();
+            }
+
+            _adminLock.Unlock();
+
+            return (_context);
+        }
+        void Configure(const uint32_t sessions, const uint32_t timeout, const bool tickets)
+        {
+            _adminLock.Lock();
+
+            _maxSessions = sessions;
+            _timeout = timeout;
+            _tickets = tickets;
+
+            while (_sessions.size() > _maxSessions) {
+                Evict();
+            }
+
+            if (_context != nullptr) {
+                Apply();
+            }
+
+            _adminLock.Unlock();
+        }
+        void Resume(SSL* ssl, const string& remote)
+        {
+            _adminLock.Lock();
+
+            Sessions::iterator index(_sessions.find(remote));
+
+            if (index != _sessions.end()) {
+                SSL_SESSION* session = index->second.Handle;
+
+                if ((SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session)) > static_cast<long>(::time(nullptr))) {
+                    // The SSL takes its own reference, the entry stays for the next connection.
+                    SSL_set_session(ssl, session);
+                    _order.splice(_order.end(), _order, index->second.Used);
+                } else {
+                    SSL_SESSION_free(session);
+                    _order.erase(index->second.Used);
+                    _sessions.erase(index);
+                }
+            }
+
+            _adminLock.Unlock();
+        }
+        void Handshake(const bool resumed)
+        {
+            if (resumed == true) {
+                _resumed++;
+            } else {
+                _full++;
+            }
+        }
+        SecureSocketPort::Statistics Handshakes() const
+        {
+            SecureSocketPort::Statistics result;
+
+            result.Full = _full;
+            result.Resumed = _resumed;
+
+            return (result);
+        }
+
+    private:
+        void Apply()
+        {
+            if (_maxSessions == 0) {
+                SSL_CTX_set_session_cache_mode(_context, SSL_SESS_CACHE_OFF);
+            } else {
+                SSL_CTX_set_session_cache_mode(_context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+                SSL_CTX_sess_set_cache_size(_context, _maxSessions);
+                SSL_CTX_set_timeout(_context, _timeout);
+            }
+
+            if (_tickets == true) {
+                SSL_CTX_clear_options(_context, SSL_OP_NO_TICKET);
+            } else {
+                SSL_CTX_set_options(_context, SSL_OP_NO_TICKET);
+            }
+        }
+        bool Store(const string& remote, SSL_SESSION* session)
+        {
+            bool result = false;
+
+            _adminLock.Lock();
+
+            if (_maxSessions != 0) {
+                Sessions::iterator index(_sessions.find(remote));
+
+                if (index != _sessions.end()) {
+                    SSL_SESSION_free(index->second.Handle);
+                    index->second.Handle = session;
+                    _order.splice(_order.end(), _order, index->second.Used);
+                } else {
+                    if (_sessions.size() >= _maxSessions) {
+                        Evict();
+                    }
+                    _sessions.emplace(remote, Session { session, _order.insert(_order.end(), remote) });
+                }
+
+                result = true;
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        void Evict()
+        {
+            // The front of the use order is the remote we did not hear from the longest.
+            Sessions::iterator index(_sessions.find(_order.front()));
+
+            ASSERT(index != _sessions.end());
+
+            SSL_SESSION_free(index->second.Handle);
+            _sessions.erase(index);
+            _order.pop_front();
+        }
+        static int NewSession(SSL* ssl, SSL_SESSION* session)
+        {
+            const Core::SocketPort* socket = static_cast<const Core::SocketPort*>(SSL_get_app_data(ssl));
+
+            // Returning 1 means we keep the reference OpenSSL handed over.
+            return ((socket != nullptr) && (Instance().Store(socket->RemoteId(), session) == true) ? 1 : 0);
+        }
+
+    private:
+        Core::CriticalSection _adminLock;
+        SSL_CTX* _context;
+        Sessions _sessions;
+        UseOrder _order;
+        uint32_t _maxSessions;
+        uint32_t _timeout;
+        bool _tickets;
+        std::atomic<uint32_t> _full;
+        std::atomic<uint32_t> _resumed;
+    };
+
+}
+
+/* static */ void SecureSocketPort::SessionCache(const uint32_t sessions, const uint32_t timeout, const bool tickets) {
+    Context::Instance().Configure(sessions, timeout, tickets);
+}
+
+/* static */ SecureSocketPort::Statistics SecureSocketPort::Handshakes() {
+    return (Context::Instance().Handshakes());
+}
+
 SecureSocketPort::Handler::~Handler() {
     if(_ssl != nullptr) {
         SSL_free(static_cast<SSL*>(_ssl));
     }
-    if(_context != nullptr) {
-        SSL_CTX_free(static_cast<SSL_CTX*>(_context));
-    }
 }
 
 bool SecureSocketPort::Handler::Initialize() {
-    // _context = SSL_CTX_new(TLS_method());
-    _context = SSL_CTX_new(SSLv23_method());
+    _context = Context::Instance().Handle();
     
     _ssl = SSL_new(static_cast<SSL_CTX*>(_context));
     SSL_set_fd(static_cast<SSL*>(_ssl), static_cast<Core::IResource&>(*this).Descriptor());
+    SSL_set_app_data(static_cast<SSL*>(_ssl), static_cast<Core::SocketPort*>(this));
+
+    // Pick up where we left off with this remote, if the session is still fresh.
+    Context::Instance().Resume(static_cast<SSL*>(_ssl), RemoteId());
+
+    // Retries of referenced (mapped) data, do not necessarily come from the same address.
+    SSL_set_mode(static_cast<SSL*>(_ssl), SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
 
     return (Core::SocketPort::Initialize());
 }
@@ -80,6 +293,17 @@ int32_t SecureSocketPort::Handler::Write(const uint8_t buffer[], const uint16_t
     return (SSL_write(static_cast<SSL*>(_ssl), buffer, length));
 }
 
+// There is nothing to gather, the records are built by SSL. Send the buffer and, once that is
+// gone, the reference in chunks of a single record, so a retry always comes with the same size.
+int32_t SecureSocketPort::Handler::Write(const uint8_t buffer[], const uint16_t length, const uint8_t reference[], const uint32_t referenceLength) {
+    return (length > 0 ? Write(buffer, length) : SSL_write(static_cast<SSL*>(_ssl), reference, std::min(referenceLength, static_cast<uint32_t>(SSL3_RT_MAX_PLAIN_LENGTH))));
+}
+
+int32_t SecureSocketPort::Handler::Write(const uint8_t buffer[], const uint16_t length, const Core::File::Handle source, const uint64_t offset, const uint32_t sourceLength) {
+    // No sendfile here, the content has to be encrypted, map the file instead of reading it.
+    return (length > 0 ? Write(buffer, length) : Mapped(buffer, length, source, offset, std::min(sourceLength, static_cast<uint32_t>(SSL3_RT_MAX_PLAIN_LENGTH))));
+}
+
 void SecureSocketPort::Handler::Update() {
     if (IsOpen() == true) {
         int result;
@@ -88,6 +312,7 @@ void SecureSocketPort::Handler::Update() {
             result = SSL_connect(static_cast<SSL*>(_ssl));
             if (result == 1) {
                 _handShaking = CONNECTED;
+                Context::Instance().Handshake(SSL_session_reused(static_cast<SSL*>(_ssl)) == 1);
                 _parent.StateChange();
             }
             else {
@@ -100,6 +325,7 @@ void SecureSocketPort::Handler::Update() {
         else if (_handShaking == EXCHANGE) {
             if (SSL_do_handshake(static_cast<SSL*>(_ssl)) == 1) {
                 _handShaking = CONNECTED;
+                Context::Instance().Handshake(SSL_session_reused(static_cast<SSL*>(_ssl)) == 1);
                 _parent.StateChange();
             }
         }
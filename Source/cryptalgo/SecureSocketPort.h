@@ -53,11 +53,16 @@ namespace Crypto {
 
             int32_t Read(uint8_t buffer[], const uint16_t length) const override;
             int32_t Write(const uint8_t buffer[], const uint16_t length) override;
+            int32_t Write(const uint8_t buffer[], const uint16_t length, const uint8_t reference[], const uint32_t referenceLength) override;
+            int32_t Write(const uint8_t buffer[], const uint16_t length, const Core::File::Handle source, const uint64_t offset, const uint32_t sourceLength) override;
 
             // Methods to extract and insert data into the socket buffers
             uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
+            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize, Core::SocketPort::Reference& reference) override {
+                return (_parent.SendData(dataFrame, maxSendSize, reference));
+            }
 
             uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
@@ -80,6 +85,12 @@ namespace Crypto {
             mutable state _handShaking;
         };
 
+    public:
+        struct Statistics {
+            uint32_t Full;
+            uint32_t Resumed;
+        };
+
     public:
         SecureSocketPort(const SecureSocketPort&);
         SecureSocketPort& operator=(const SecureSocketPort&);
@@ -92,6 +103,13 @@ namespace Crypto {
         }
 
     public:
+        // All secure sockets of this process share one SSL context. Its session cache keeps up to
+        // sessions entries, one per remote node, that can be resumed up to timeout seconds after
+        // they were established. Session tickets are used on top of session IDs if tickets is set.
+        // A cache of 0 sessions disables resumption.
+        static void SessionCache(const uint32_t sessions, const uint32_t timeout, const bool tickets);
+        static Statistics Handshakes();
+
         inline bool IsOpen() const
         {
             return (_handler.IsOpen());
@@ -143,6 +161,11 @@ namespace Crypto {
         virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
         virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
 
+        // Same as the SocketPort one, referenced data is encrypted from where it is.
+        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize, Core::SocketPort::Reference& /* reference */) {
+            return (SendData(dataFrame, maxSendSize));
+        }
+
         // Signal a state change, Opened, Closed or Accepted
         virtual void StateChange() = 0;
 
@@ -20,6 +20,15 @@
 #include "Channel.h"
 
 namespace WPEFramework {
+
+ENUM_CONVERSION_BEGIN(PluginHost::Channel::overflow)
+
+    { PluginHost::Channel::DROP_OLDEST, _TXT("dropoldest") },
+    { PluginHost::Channel::COALESCE, _TXT("coalesce") },
+    { PluginHost::Channel::DISCONNECT, _TXT("disconnect") },
+
+ENUM_CONVERSION_END(PluginHost::Channel::overflow)
+
 namespace PluginHost {
 
     /* static */ RequestPool Channel::_requestAllocator(10);
@@ -38,6 +47,11 @@ namespace PluginHost {
         , _text()
         , _offset(0)
         , _sendQueue()
+        , _maxMessages(0)
+        , _maxBytes(0)
+        , _overflow(DROP_OLDEST)
+        , _peak(0)
+        , _dropped(0)
     {
     }
 #ifdef __WINDOWS__
@@ -48,5 +62,43 @@ namespace PluginHost {
     {
         Close(0);
     }
+
+    void Channel::Enqueue(Package&& package)
+    {
+        bool trigger = false;
+        bool disconnect = false;
+
+        _adminLock.Lock();
+
+        if ((Fits(package) == false) && (_overflow == DISCONNECT)) {
+            disconnect = true;
+        } else {
+            if ((Fits(package) == true) || (_overflow != COALESCE) || (_sendQueue.Coalesce(package) == false)) {
+                _sendQueue.Push(std::move(package));
+            } else {
+                // The queued notification is superseded by this one.
+                _dropped++;
+            }
+
+            while ((Overflowing() == true) && (_sendQueue.DropNotification() == true)) {
+                _dropped++;
+            }
+        }
+
+        if (_sendQueue.Messages() > _peak) {
+            _peak = _sendQueue.Messages();
+        }
+
+        trigger = (_sendQueue.Messages() == 1);
+
+        _adminLock.Unlock();
+
+        if (disconnect == true) {
+            TRACE_L1("Channel [%d] can not keep up with its outbound messages, closing it.", _ID);
+            BaseClass::Close(0);
+        } else if (trigger == true) {
+            BaseClass::Trigger();
+        }
+    }
 }
 }
@@ -30,33 +30,92 @@ namespace PluginHost {
     private:
         typedef Web::WebSocketLinkType<Core::SocketStream, Request, Web::Response, RequestPool&> BaseClass;
 
+        // A queued outbound message. Notifications (JSON-RPC messages without an id) are the
+        // only ones that may be dropped or coalesced when the queue overflows, responses and
+        // plain text are always delivered.
         class EXTERNAL Package {
         private:
-            Package() = delete;
+            enum kind : uint8_t {
+                NONE,
+                STRING,
+                ELEMENT
+            };
+
+        public:
             Package(const Package&) = delete;
             Package& operator=(const Package&) = delete;
 
-        public:
+            Package()
+                : _kind(NONE)
+                , _notification(false)
+                , _size(0)
+            {
+            }
             explicit Package(const Core::ProxyType<Core::JSON::IElement>& json)
-                : _json(true)
-                , _info(json)
+                : _kind(ELEMENT)
+                , _notification(false)
+                , _size(0)
+            {
+                new (&_info.json) Core::ProxyType<Core::JSON::IElement>(json);
+
+                const Core::JSON::Serialized* frame = dynamic_cast<const Core::JSON::Serialized*>(json.operator->());
+
+                if (frame != nullptr) {
+                    // Composed up front, only done for notifications send to many channels.
+                    _notification = true;
+                    _size = static_cast<uint32_t>(frame->Text().length());
+                } else {
+                    const Core::JSONRPC::Message* message = dynamic_cast<const Core::JSONRPC::Message*>(json.operator->());
+
+                    if (message != nullptr) {
+                        _notification = (message->Id.IsSet() == false);
+                        _size = Overhead + static_cast<uint32_t>(message->Designator.Value().length() + message->Parameters.Value().length() + message->Result.Value().length() + message->Error.Text.Value().length());
+                    } else {
+                        _size = Overhead;
+                    }
+                }
+            }
+            explicit Package(const string& text)
+                : _kind(STRING)
+                , _notification(false)
+                , _size(static_cast<uint32_t>(text.length()))
             {
+                new (&_info.text) string(text);
             }
-            explicit Package(const string& text) 
-                : _json(false)
-                , _info(text)
+            Package(Package&& move)
+                : _kind(NONE)
+                , _notification(false)
+                , _size(0)
             {
+                Take(move);
             }
-            ~Package()
+            Package& operator=(Package&& move)
             {
-                if (_json) {
-                    _info.json.~ProxyType<Core::JSON::IElement>();                
-                } else {
-                    _info.text.~string();
+                if (this != &move) {
+                    Clear();
+                    Take(move);
                 }
+                return (*this);
+            }
+            ~Package()
+            {
+                Clear();
             }
 
         public:
+            inline bool IsSet() const
+            {
+                return (_kind != NONE);
+            }
+            inline bool IsNotification() const
+            {
+                return (_notification);
+            }
+            // Bytes this package takes on the wire, estimated for JSON that is not serialized yet.
+            inline uint32_t Size() const
+            {
+                return (_size);
+            }
             const string& Text() const
             {
                 return (_info.text);
@@ -65,24 +124,196 @@ namespace PluginHost {
             {
                 return (_info.json);
             }
+            string Event() const
+            {
+                string result;
 
-        private:
-            bool _json;
-            union Info {
-                Info(const Core::ProxyType<Core::JSON::IElement>& value)
-                    : json(value)
-                {
+                if ((_notification == true) && (_kind == ELEMENT)) {
+                    const Core::JSON::Serialized* frame = dynamic_cast<const Core::JSON::Serialized*>(_info.json.operator->());
+
+                    if (frame != nullptr) {
+                        result = frame->Label();
+                    } else {
+                        result = static_cast<const Core::JSONRPC::Message&>(*_info.json).Designator.Value();
+                    }
                 }
-                Info(const string& value)
-                    : text(value)
-                {
+
+                return (result);
+            }
+            void Clear()
+            {
+                if (_kind == ELEMENT) {
+                    _info.json.~ProxyType<Core::JSON::IElement>();
+                } else if (_kind == STRING) {
+                    _info.text.~string();
                 }
+                _kind = NONE;
+                _notification = false;
+                _size = 0;
+            }
+
+        private:
+            void Take(Package& move)
+            {
+                if (move._kind == ELEMENT) {
+                    new (&_info.json) Core::ProxyType<Core::JSON::IElement>(std::move(move._info.json));
+                } else if (move._kind == STRING) {
+                    new (&_info.text) string(std::move(move._info.text));
+                }
+                _kind = move._kind;
+                _notification = move._notification;
+                _size = move._size;
+
+                move.Clear();
+            }
+
+        private:
+            // Envelope of a JSON-RPC message: jsonrpc, id and the member names.
+            static constexpr uint32_t Overhead = 64;
+
+            kind _kind;
+            bool _notification;
+            uint32_t _size;
+            union Info {
+                Info() {}
                 ~Info() {}
 
                 Core::ProxyType<Core::JSON::IElement> json;
                 string text;
             } _info;
         };
+        // Ring of packages that only allocates when it has to grow. Dropped or coalesced
+        // entries leave an empty slot behind that is skipped on the way out. The head is
+        // the package being sent, so it is never dropped or replaced.
+        class EXTERNAL SendQueue {
+        public:
+            SendQueue(const SendQueue&) = delete;
+            SendQueue& operator=(const SendQueue&) = delete;
+
+            SendQueue()
+                : _ring(InitialSize)
+                , _head(0)
+                , _used(0)
+                , _messages(0)
+                , _bytes(0)
+            {
+            }
+            ~SendQueue()
+            {
+            }
+
+        public:
+            inline uint32_t Messages() const
+            {
+                return (_messages);
+            }
+            inline uint32_t Bytes() const
+            {
+                return (_bytes);
+            }
+            inline Package& Front()
+            {
+                ASSERT(_messages > 0);
+
+                return (_ring[_head]);
+            }
+            void Push(Package&& package)
+            {
+                if (_used == _ring.size()) {
+                    Reorganize();
+                }
+
+                _bytes += package.Size();
+                _messages++;
+                _ring[(_head + _used) & (_ring.size() - 1)] = std::move(package);
+                _used++;
+            }
+            void Pop()
+            {
+                ASSERT(_messages > 0);
+
+                Remove(_ring[_head]);
+
+                do {
+                    _head = (_head + 1) & (_ring.size() - 1);
+                    _used--;
+                } while ((_used > 0) && (_ring[_head].IsSet() == false));
+            }
+            // Replace the oldest queued notification of the same event by this newer one.
+            bool Coalesce(Package& package)
+            {
+                bool result = false;
+                const string event(package.Event());
+
+                if (event.empty() == false) {
+                    for (uint32_t index = 1; (index < _used) && (result == false); index++) {
+                        Package& entry(_ring[(_head + index) & (_ring.size() - 1)]);
+
+                        if ((entry.IsNotification() == true) && (entry.Event() == event)) {
+                            _bytes -= entry.Size();
+                            _bytes += package.Size();
+                            entry = std::move(package);
+                            result = true;
+                        }
+                    }
+                }
+
+                return (result);
+            }
+            bool DropNotification()
+            {
+                bool result = false;
+
+                for (uint32_t index = 1; (index < _used) && (result == false); index++) {
+                    Package& entry(_ring[(_head + index) & (_ring.size() - 1)]);
+
+                    if (entry.IsNotification() == true) {
+                        Remove(entry);
+                        result = true;
+                    }
+                }
+
+                return (result);
+            }
+
+        private:
+            void Remove(Package& entry)
+            {
+                _bytes -= entry.Size();
+                _messages--;
+                entry.Clear();
+            }
+            void Reorganize()
+            {
+                // Squeeze out the empty slots, only grow if that does not free up enough.
+                const uint32_t size = static_cast<uint32_t>(_ring.size());
+                std::vector<Package> ring((_messages > (size / 2)) ? (size * 2) : size);
+                uint32_t loaded = 0;
+
+                for (uint32_t index = 0; index < _used; index++) {
+                    Package& entry(_ring[(_head + index) & (size - 1)]);
+
+                    if (entry.IsSet() == true) {
+                        ring[loaded++] = std::move(entry);
+                    }
+                }
+
+                ASSERT(loaded == _messages);
+
+                _ring.swap(ring);
+                _head = 0;
+                _used = loaded;
+            }
+
+        private:
+            static constexpr uint32_t InitialSize = 8;
+
+            std::vector<Package> _ring;
+            uint32_t _head;
+            uint32_t _used;
+            uint32_t _messages;
+            uint32_t _bytes;
+        };
         class EXTERNAL SerializerImpl {
         public:
             SerializerImpl() = delete;
@@ -124,7 +355,7 @@ namespace PluginHost {
         private:
             Channel& _parent;
             mutable Core::ProxyType<const Core::JSON::IElement> _current;
-            mutable uint16_t _offset;
+            mutable uint32_t _offset;
         };
         class EXTERNAL DeserializerImpl {
         public:
@@ -171,7 +402,7 @@ namespace PluginHost {
         private:
             Channel& _parent;
             Core::ProxyType<Core::JSON::IElement> _current;
-            uint16_t _offset;
+            uint32_t _offset;
         };
 
     public:
@@ -186,6 +417,13 @@ namespace PluginHost {
             NOTIFIED = 0x8000
         };
 
+        // What to do with an outbound message that does not fit within the limits of the channel.
+        enum overflow : uint8_t {
+            DROP_OLDEST, // Drop the oldest queued notifications
+            COALESCE, // Replace a queued notification of the same event, otherwise drop the oldest
+            DISCONNECT // Close the channel, the client can not keep up
+        };
+
     public:
         Channel() = delete;
         Channel(const Channel& copy) = delete;
@@ -239,35 +477,13 @@ namespace PluginHost {
         inline void Submit(const string& text)
         {
             if (IsOpen() == true) {
-
-                _adminLock.Lock();
-
-                _sendQueue.emplace_back(text);
-
-                bool trigger = (_sendQueue.size() == 1);
-
-                _adminLock.Unlock();
-
-                if (trigger == true) {
-                    BaseClass::Trigger();
-                }
+                Enqueue(Package(text));
             }
         }
         inline void Submit(const Core::ProxyType<Core::JSON::IElement>& entry)
         {
             if (IsOpen() == true) {
-
-                _adminLock.Lock();
-
-                _sendQueue.emplace_back(entry);
-
-                bool trigger = (_sendQueue.size() == 1);
-
-                _adminLock.Unlock();
-
-                if (trigger == true) {
-                    BaseClass::Trigger();
-                }
+                Enqueue(Package(entry));
             }
         }
         inline void Submit(const Core::ProxyType<Web::Response>& entry)
@@ -278,6 +494,34 @@ namespace PluginHost {
         {
             BaseClass::Trigger();
         }
+        inline uint32_t QueuedMessages() const
+        {
+            _adminLock.Lock();
+            uint32_t result = _sendQueue.Messages();
+            _adminLock.Unlock();
+            return (result);
+        }
+        inline uint32_t QueuedBytes() const
+        {
+            _adminLock.Lock();
+            uint32_t result = _sendQueue.Bytes();
+            _adminLock.Unlock();
+            return (result);
+        }
+        inline uint32_t PeakMessages() const
+        {
+            _adminLock.Lock();
+            uint32_t result = _peak;
+            _adminLock.Unlock();
+            return (result);
+        }
+        inline uint32_t DroppedMessages() const
+        {
+            _adminLock.Lock();
+            uint32_t result = _dropped;
+            _adminLock.Unlock();
+            return (result);
+        }
 
     protected:
         inline void SetId(const uint32_t id)
@@ -296,6 +540,13 @@ namespace PluginHost {
         {
             _nameOffset = offset;
         }
+        // Bound the outbound queue, 0 means no limit on messages or bytes.
+        inline void Limits(const uint32_t messages, const uint32_t bytes, const overflow policy)
+        {
+            _maxMessages = messages;
+            _maxBytes = bytes;
+            _overflow = policy;
+        }
         inline void State(const ChannelState state, const bool notification)
         {
             Binary(state == RAW);
@@ -305,7 +556,7 @@ namespace PluginHost {
         {
             uint16_t size = 0;
 
-            if (_sendQueue.size() != 0) {
+            if (_sendQueue.Messages() != 0) {
 
                 switch (State()) {
                 case JSON:
@@ -317,8 +568,8 @@ namespace PluginHost {
 
                         // See if there is more to do..
                         _adminLock.Lock();
-                        _sendQueue.pop_front();
-                        bool trigger(_sendQueue.size() > 0);
+                        _sendQueue.Pop();
+                        bool trigger(_sendQueue.Messages() > 0);
                         _adminLock.Unlock();
 
                         if (trigger == true) {
@@ -333,8 +584,8 @@ namespace PluginHost {
                 case TEXT: {
                     // Seems we need to send plain strings...
                     _adminLock.Lock();
-                    Package& data(_sendQueue.front());
-                    uint16_t neededBytes(static_cast<uint16_t>(data.Text().length() - _offset));
+                    Package& data(_sendQueue.Front());
+                    uint32_t neededBytes(static_cast<uint32_t>(data.Text().length() - _offset));
 
                     if (neededBytes <= maxSendSize) {
                         ::memcpy(dataFrame, &(data.Text().c_str()[_offset]), neededBytes);
@@ -342,7 +593,7 @@ namespace PluginHost {
                         _offset = 0;
 
                         // See if there is more to do..
-                        _sendQueue.pop_front();
+                        _sendQueue.Pop();
                     } else {
                         uint16_t addedBytes = maxSendSize - size;
                         ::memcpy(dataFrame, &(data.Text().c_str()[_offset]), addedBytes);
@@ -439,14 +690,23 @@ namespace PluginHost {
 
             _adminLock.Lock();
 
-            if (_sendQueue.size() > 0) {
-                result = _sendQueue.front().JSON();
+            if (_sendQueue.Messages() > 0) {
+                result = _sendQueue.Front().JSON();
 
             }
             _adminLock.Unlock();
 
             return (result);
         }
+        inline bool Fits(const Package& package) const
+        {
+            return (((_maxMessages == 0) || (_sendQueue.Messages() < _maxMessages)) && ((_maxBytes == 0) || ((_sendQueue.Bytes() + package.Size()) <= _maxBytes)));
+        }
+        inline bool Overflowing() const
+        {
+            return (((_maxMessages != 0) && (_sendQueue.Messages() > _maxMessages)) || ((_maxBytes != 0) && (_sendQueue.Bytes() > _maxBytes)));
+        }
+        void Enqueue(Package&& package);
 
     private:
         mutable Core::CriticalSection _adminLock;
@@ -457,7 +717,12 @@ namespace PluginHost {
         DeserializerImpl _deserializer;
         string _text;
         uint32_t _offset;
-        std::list<Package> _sendQueue;
+        SendQueue _sendQueue;
+        uint32_t _maxMessages;
+        uint32_t _maxBytes;
+        overflow _overflow;
+        uint32_t _peak;
+        uint32_t _dropped;
 
         // All requests needed by any instance of this webserver are coming from this web server. They are extracted
         // from a pool. If the request is nolonger needed, the request returns to this pool.
@@ -41,6 +41,7 @@ namespace Plugin {
             , WebUI()
             , Precondition()
             , Termination()
+            , Dependencies()
             , Configuration(false)
             , PersistentPathPostfix()
             , VolatilePathPostfix()
@@ -54,6 +55,7 @@ namespace Plugin {
             Add(_T("webui"), &WebUI);
             Add(_T("precondition"), &Precondition);
             Add(_T("termination"), &Termination);
+            Add(_T("dependencies"), &Dependencies);
             Add(_T("configuration"), &Configuration);
             Add(_T("persistentpathpostfix"), &PersistentPathPostfix);
             Add(_T("volatilepathpostfix"), &VolatilePathPostfix);
@@ -69,6 +71,7 @@ namespace Plugin {
             , WebUI(copy.WebUI)
             , Precondition(copy.Precondition)
             , Termination(copy.Termination)
+            , Dependencies(copy.Dependencies)
             , Configuration(copy.Configuration)
             , PersistentPathPostfix(copy.PersistentPathPostfix)
             , VolatilePathPostfix(copy.VolatilePathPostfix)
@@ -82,6 +85,7 @@ namespace Plugin {
             Add(_T("webui"), &WebUI);
             Add(_T("precondition"), &Precondition);
             Add(_T("termination"), &Termination);
+            Add(_T("dependencies"), &Dependencies);
             Add(_T("configuration"), &Configuration);
             Add(_T("persistentpathpostfix"), &PersistentPathPostfix);
             Add(_T("volatilepathpostfix"), &VolatilePathPostfix);
@@ -102,6 +106,7 @@ namespace Plugin {
             Configuration = RHS.Configuration;
             Precondition = RHS.Precondition;
             Termination = RHS.Termination;
+            Dependencies = RHS.Dependencies;
             PersistentPathPostfix = RHS.PersistentPathPostfix;
             VolatilePathPostfix = RHS.VolatilePathPostfix;
 
@@ -130,6 +135,7 @@ namespace Plugin {
         Core::JSON::String WebUI;
         Core::JSON::ArrayType<Core::JSON::EnumType<PluginHost::ISubSystem::subsystem>> Precondition;
         Core::JSON::ArrayType<Core::JSON::EnumType<PluginHost::ISubSystem::subsystem>> Termination;
+        Core::JSON::ArrayType<Core::JSON::String> Dependencies;
         Core::JSON::String Configuration;
         Core::JSON::String PersistentPathPostfix;
         Core::JSON::String VolatilePathPostfix;
@@ -32,7 +32,7 @@ namespace PluginHost {
     {
         std::vector<uint8_t> versions = { 1 };
 
-        _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+        _handlers.emplace_back([&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }, versions);
     }
 
     JSONRPC::JSONRPC(const std::vector<uint8_t> versions)
@@ -42,7 +42,7 @@ namespace PluginHost {
         , _callsign()
         , _validate()
     {
-        _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+        _handlers.emplace_back([&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }, versions);
     }
 
     JSONRPC::JSONRPC(const TokenCheckFunction& validation)
@@ -54,7 +54,7 @@ namespace PluginHost {
     {
         std::vector<uint8_t> versions = { 1 };
 
-        _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+        _handlers.emplace_back([&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }, versions);
     }
 
     JSONRPC::JSONRPC(const std::vector<uint8_t> versions, const TokenCheckFunction& validation)
@@ -64,7 +64,7 @@ namespace PluginHost {
         , _callsign()
         , _validate(validation)
     {
-        _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+        _handlers.emplace_back([&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }, versions);
     }
 
     /* virtual */ JSONRPC::~JSONRPC()
@@ -120,12 +120,12 @@ namespace PluginHost {
         }
         Core::JSONRPC::Handler& CreateHandler(const std::vector<uint8_t>& versions)
         {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+            _handlers.emplace_back([&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }, versions);
             return (_handlers.back());
         }
         Core::JSONRPC::Handler& CreateHandler(const std::vector<uint8_t>& versions, const Core::JSONRPC::Handler& source)
         {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions, source);
+            _handlers.emplace_back([&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }, versions, source);
             return (_handlers.back());
         }
         Core::JSONRPC::Handler* GetHandler(uint8_t version)
@@ -363,11 +363,25 @@ namespace PluginHost {
             }
             return (result);
         }
-        void Notify(const uint32_t id, const string& designator, const string& parameters)
+        void Notify(const std::vector<uint32_t>& ids, const string& designator, const string& parameters)
         {
-            Core::ProxyType<Core::JSONRPC::Message> message(Message());
-
             ASSERT(_service != nullptr);
+            ASSERT(ids.empty() == false);
+
+            if (ids.size() == 1) {
+                _service->Submit(ids.front(), Core::ProxyType<Core::JSON::IElement>(Notification(designator, parameters)));
+            } else {
+                // Serialize the notification once, all channels send out the very same text..
+                Core::ProxyType<Core::JSON::Serialized> frame(Core::ProxyType<Core::JSON::Serialized>::Create(*Notification(designator, parameters), designator));
+
+                for (const uint32_t id : ids) {
+                    _service->Submit(id, Core::ProxyType<Core::JSON::IElement>(frame));
+                }
+            }
+        }
+        Core::ProxyType<Core::JSONRPC::Message> Notification(const string& designator, const string& parameters) const
+        {
+            Core::ProxyType<Core::JSONRPC::Message> message(Message());
 
             if (!parameters.empty()) {
                 message->Parameters = parameters;
@@ -376,7 +390,7 @@ namespace PluginHost {
             message->Designator = designator;
             message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
 
-            _service->Submit(id, Core::ProxyType<Core::JSON::IElement>(message));
+            return (message);
         }
         virtual void Activate(IShell* service) override
         {
@@ -109,6 +109,8 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
 #endif
         Add(_T("module"), &Module);
         Add(_T("hash"), &Hash);
+        Add(_T("activationstart"), &ActivationStart);
+        Add(_T("activationend"), &ActivationEnd);
     }
     MetaData::Service::Service(const MetaData::Service& copy)
         : Plugin::Config(copy)
@@ -122,6 +124,8 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
 #endif
         , Module(copy.Module)
         , Hash(copy.Hash)
+        , ActivationStart(copy.ActivationStart)
+        , ActivationEnd(copy.ActivationEnd)
     {
         Add(_T("state"), &JSONState);
 #ifdef RUNTIME_STATISTICS
@@ -133,6 +137,8 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
 #endif
         Add(_T("module"), &Module);
         Add(_T("hash"), &Hash);
+        Add(_T("activationstart"), &ActivationStart);
+        Add(_T("activationend"), &ActivationEnd);
     }
     MetaData::Service::~Service()
     {
@@ -152,6 +158,10 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         Core::JSON::Container::Add(_T("activity"), &Activity);
         Core::JSON::Container::Add(_T("id"), &ID);
         Core::JSON::Container::Add(_T("name"), &Name);
+        Core::JSON::Container::Add(_T("queued"), &Queued);
+        Core::JSON::Container::Add(_T("queuedbytes"), &QueuedBytes);
+        Core::JSON::Container::Add(_T("peak"), &Peak);
+        Core::JSON::Container::Add(_T("dropped"), &Dropped);
     }
     MetaData::Channel::Channel(const MetaData::Channel& copy)
         : Core::JSON::Container()
@@ -160,12 +170,20 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         , Activity(copy.Activity)
         , ID(copy.ID)
         , Name(copy.Name)
+        , Queued(copy.Queued)
+        , QueuedBytes(copy.QueuedBytes)
+        , Peak(copy.Peak)
+        , Dropped(copy.Dropped)
     {
         Core::JSON::Container::Add(_T("remote"), &Remote);
         Core::JSON::Container::Add(_T("state"), &JSONState);
         Core::JSON::Container::Add(_T("activity"), &Activity);
         Core::JSON::Container::Add(_T("id"), &ID);
         Core::JSON::Container::Add(_T("name"), &Name);
+        Core::JSON::Container::Add(_T("queued"), &Queued);
+        Core::JSON::Container::Add(_T("queuedbytes"), &QueuedBytes);
+        Core::JSON::Container::Add(_T("peak"), &Peak);
+        Core::JSON::Container::Add(_T("dropped"), &Dropped);
     }
     MetaData::Channel::~Channel()
     {
@@ -178,6 +196,10 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         Activity = RHS.Activity;
         ID = RHS.ID;
         Name = RHS.Name;
+        Queued = RHS.Queued;
+        QueuedBytes = RHS.QueuedBytes;
+        Peak = RHS.Peak;
+        Dropped = RHS.Dropped;
 
         return (*this);
     }
@@ -221,11 +243,64 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
     {
     }
 
+    MetaData::Metrics::Latency::Latency()
+        : Core::JSON::Container()
+    {
+        Add(_T("method"), &Method);
+        Add(_T("count"), &Count);
+        Add(_T("p50"), &P50);
+        Add(_T("p90"), &P90);
+        Add(_T("p99"), &P99);
+        Add(_T("max"), &Max);
+    }
+    MetaData::Metrics::Latency::Latency(const Latency& copy)
+        : Core::JSON::Container()
+        , Method(copy.Method)
+        , Count(copy.Count)
+        , P50(copy.P50)
+        , P90(copy.P90)
+        , P99(copy.P99)
+        , Max(copy.Max)
+    {
+        Add(_T("method"), &Method);
+        Add(_T("count"), &Count);
+        Add(_T("p50"), &P50);
+        Add(_T("p90"), &P90);
+        Add(_T("p99"), &P99);
+        Add(_T("max"), &Max);
+    }
+    MetaData::Metrics::Latency::~Latency()
+    {
+    }
+
+    MetaData::Metrics::Metrics()
+        : Core::JSON::Container()
+    {
+        Add(_T("callsign"), &Callsign);
+        Add(_T("requests"), &Requests);
+        Add(_T("methods"), &Methods);
+    }
+    MetaData::Metrics::Metrics(const Metrics& copy)
+        : Core::JSON::Container()
+        , Callsign(copy.Callsign)
+        , Requests(copy.Requests)
+        , Methods(copy.Methods)
+    {
+        Add(_T("callsign"), &Callsign);
+        Add(_T("requests"), &Requests);
+        Add(_T("methods"), &Methods);
+    }
+    MetaData::Metrics::~Metrics()
+    {
+    }
+
     MetaData::Server::Server()
     {
         Core::JSON::Container::Add(_T("threads"), &ThreadPoolRuns);
         Core::JSON::Container::Add(_T("pending"), &PendingRequests);
         Core::JSON::Container::Add(_T("occupation"), &PoolOccupation);
+        Core::JSON::Container::Add(_T("fullhandshakes"), &FullHandshakes);
+        Core::JSON::Container::Add(_T("resumedhandshakes"), &ResumedHandshakes);
     }
     MetaData::Server::~Server()
     {
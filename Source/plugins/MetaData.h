@@ -88,6 +88,8 @@ namespace PluginHost {
 #endif
             Core::JSON::String Module;
             Core::JSON::String Hash;
+            Core::JSON::DecUInt64 ActivationStart;
+            Core::JSON::DecUInt64 ActivationEnd;
         };
 
         class EXTERNAL Channel : public Core::JSON::Container {
@@ -132,6 +134,10 @@ namespace PluginHost {
             Core::JSON::Boolean Activity;
             Core::JSON::DecUInt32 ID;
             Core::JSON::String Name;
+            Core::JSON::DecUInt32 Queued;
+            Core::JSON::DecUInt32 QueuedBytes;
+            Core::JSON::DecUInt32 Peak;
+            Core::JSON::DecUInt32 Dropped;
         };
 
         class EXTERNAL Bridge : public Core::JSON::Container {
@@ -169,6 +175,43 @@ namespace PluginHost {
             Core::JSON::ArrayType<Core::JSON::DecUInt32> ThreadPoolRuns;
             Core::JSON::DecUInt32 PendingRequests;
             Core::JSON::DecUInt32 PoolOccupation;
+            Core::JSON::DecUInt32 FullHandshakes;
+            Core::JSON::DecUInt32 ResumedHandshakes;
+        };
+
+        // Latencies, in microseconds, of the requests handled by a plugin.
+        class EXTERNAL Metrics : public Core::JSON::Container {
+        private:
+            Metrics& operator=(const Metrics&) = delete;
+
+        public:
+            class EXTERNAL Latency : public Core::JSON::Container {
+            private:
+                Latency& operator=(const Latency&) = delete;
+
+            public:
+                Latency();
+                Latency(const Latency& copy);
+                ~Latency();
+
+            public:
+                Core::JSON::String Method;
+                Core::JSON::DecUInt32 Count;
+                Core::JSON::DecUInt32 P50;
+                Core::JSON::DecUInt32 P90;
+                Core::JSON::DecUInt32 P99;
+                Core::JSON::DecUInt32 Max;
+            };
+
+        public:
+            Metrics();
+            Metrics(const Metrics& copy);
+            ~Metrics();
+
+        public:
+            Core::JSON::String Callsign;
+            Latency Requests;
+            Core::JSON::ArrayType<Latency> Methods;
         };
 
         class EXTERNAL SubSystem : public Core::JSON::Container {
@@ -86,23 +86,35 @@ namespace PluginHost {
     }
 #endif
 
-    void Service::FileToServe(const string& webServiceRequest, Web::Response& response)
+    void Service::FileToServe(const Web::Request& request, Web::Response& response)
     {
         Web::MIMETypes result;
         uint16_t offset = static_cast<uint16_t>(_config.WebPrefix().length()) + (_webURLPath.empty() ? 1 : static_cast<uint16_t>(_webURLPath.length()) + 2);
         string fileToService = _webServerFilePath;
+        Core::ProxyType<Web::FileBody> fileBody(IFactories::Instance().FileBody());
 
-        if ((webServiceRequest.length() <= offset) || (Web::MIMETypeForFile(webServiceRequest.substr(offset, -1), fileToService, result) == false)) {
-            Core::ProxyType<Web::FileBody> fileBody(IFactories::Instance().FileBody());
-
+        if ((request.Path.length() <= offset) || (Web::MIMETypeForFile(request.Path.substr(offset, -1), fileToService, result) == false)) {
             // No filename gives, be default, we go for the index.html page..
             *fileBody = fileToService + _T("index.html");
             response.ContentType = Web::MIME_HTML;
-            response.Body<Web::FileBody>(fileBody);
         } else {
-            Core::ProxyType<Web::FileBody> fileBody(IFactories::Instance().FileBody());
             *fileBody = fileToService;
             response.ContentType = result;
+        }
+
+        response.AcceptRange = _T("bytes");
+
+        if (request.Range.IsSet() == true) {
+            string contentRange;
+
+            response.ErrorCode = fileBody->Range(request.Range.Value(), contentRange);
+
+            if (contentRange.empty() == false) {
+                response.ContentRange = contentRange;
+            }
+        }
+
+        if (response.ErrorCode != Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE) {
             response.Body<Web::FileBody>(fileBody);
         }
     }
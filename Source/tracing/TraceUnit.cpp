@@ -113,6 +113,8 @@ namespace Trace {
         , m_Admin()
         , m_OutputChannel(nullptr)
         , m_DirectOut(false)
+        , m_Staging()
+        , m_Flusher(nullptr)
     {
     }
 
@@ -157,6 +159,101 @@ namespace Trace {
         _doorBell.Ring();
     }
 
+    void TraceUnit::StagingBuffer::Copy(const uint32_t position, const uint8_t data[], const uint32_t length)
+    {
+        const uint32_t offset = (position % Size);
+        const uint32_t part = std::min(length, static_cast<uint32_t>(Size - offset));
+
+        ::memcpy(&(_buffer[offset]), data, part);
+
+        if (part < length) {
+            ::memcpy(_buffer, &(data[part]), length - part);
+        }
+    }
+
+    void TraceUnit::StagingBuffer::Peek(const uint32_t position, uint8_t data[], const uint32_t length) const
+    {
+        const uint32_t offset = (position % Size);
+        const uint32_t part = std::min(length, static_cast<uint32_t>(Size - offset));
+
+        ::memcpy(data, &(_buffer[offset]), part);
+
+        if (part < length) {
+            ::memcpy(&(data[part]), _buffer, length - part);
+        }
+    }
+
+    // A staged record is the record as it will be written in the cyclic buffer (its 16 bit length
+    // first), preceded by the 16 bit length of its header, so the flusher can truncate the data.
+    bool TraceUnit::StagingBuffer::Push(const uint16_t headerLength, const uint8_t count, const uint8_t* const fragments[], const uint16_t lengths[])
+    {
+        uint32_t fullLength = 2;
+
+        for (uint8_t index = 0; index < count; index++) {
+            fullLength += lengths[index];
+        }
+
+        const uint32_t head = _head.load(std::memory_order_relaxed);
+        const uint32_t used = head - _tail.load(std::memory_order_acquire);
+
+        bool result = ((fullLength <= 0xFFFF) && ((2 + fullLength) <= (Size - used)));
+
+        if (result == true) {
+            const uint16_t convertedLength = static_cast<uint16_t>(fullLength);
+            uint32_t position = head;
+
+            Copy(position, reinterpret_cast<const uint8_t*>(&headerLength), 2);
+            position += 2;
+            Copy(position, reinterpret_cast<const uint8_t*>(&convertedLength), 2);
+            position += 2;
+
+            for (uint8_t index = 0; index < count; index++) {
+                Copy(position, fragments[index], lengths[index]);
+                position += lengths[index];
+            }
+
+            _head.store(position, std::memory_order_release);
+        }
+
+        return (result);
+    }
+
+    void TraceUnit::StagingBuffer::Flush(TraceBuffer& output)
+    {
+        const uint32_t head = _head.load(std::memory_order_acquire);
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+
+        while (tail != head) {
+            uint16_t headerLength;
+            uint16_t fullLength;
+
+            Peek(tail, reinterpret_cast<uint8_t*>(&headerLength), 2);
+            Peek(tail + 2, reinterpret_cast<uint8_t*>(&fullLength), 2);
+
+            // Tell the buffer how much we are going to write.
+            const uint32_t actualLength = output.Reserve(fullLength);
+
+            if ((actualLength >= headerLength) && (actualLength <= fullLength)) {
+                // If the buffer can not hold it all, the information is written partially.
+                const uint16_t convertedLength = static_cast<uint16_t>(actualLength);
+                const uint32_t offset = ((tail + 4) % Size);
+                const uint32_t length = actualLength - 2;
+                const uint32_t part = std::min(length, static_cast<uint32_t>(Size - offset));
+
+                output.Write(reinterpret_cast<const uint8_t*>(&convertedLength), 2);
+                output.Write(&(_buffer[offset]), part);
+
+                if (part < length) {
+                    output.Write(_buffer, length - part);
+                }
+            }
+
+            tail += (2 + fullLength);
+        }
+
+        _tail.store(tail, std::memory_order_release);
+    }
+
     /* static */ TraceUnit& TraceUnit::Instance()
     {
         return (Core::SingletonType<TraceUnit>::Instance());
@@ -170,10 +267,29 @@ namespace Trace {
             Close();
         }
 
+        m_Admin.Unlock();
+
+        // Nothing signals the flusher anymore without a channel. It takes the lock to flush, so
+        // it is stopped without holding it.
+        Flusher* flusher = m_Flusher.exchange(nullptr, std::memory_order_acq_rel);
+
+        if (flusher != nullptr) {
+            delete flusher;
+        }
+
+        m_Admin.Lock();
+
         while (m_Categories.size() != 0) {
             m_Categories.front()->Destroy();
         }
 
+        for (StagingBuffer* staging : m_Staging) {
+            if (staging->Release() == true) {
+                delete staging;
+            }
+        }
+        m_Staging.clear();
+
         m_Admin.Unlock();
     }
 
@@ -220,6 +336,10 @@ namespace Trace {
         ASSERT(m_OutputChannel != nullptr);
 
         if (m_OutputChannel != nullptr) {
+            // Do not loose what is still staged.
+            for (StagingBuffer* staging : m_Staging) {
+                staging->Flush(*m_OutputChannel);
+            }
             delete m_OutputChannel;
         }
 
@@ -379,50 +499,83 @@ namespace Trace {
         return isDefaultCategory;
     }
 
-    void TraceUnit::Trace(const char file[], const uint32_t lineNumber, const char className[], const ITrace* const information)
+    TraceUnit::StagingBuffer* TraceUnit::Staging()
     {
-        const char* fileName(Core::FileNameOnly(file));
+        ThreadContext& context(Core::Thread::GetContext<ThreadContext>());
+
+        if (context._staging == nullptr) {
+            context._staging = new StagingBuffer();
+
+            m_Admin.Lock();
+            m_Staging.push_back(context._staging);
+            m_Admin.Unlock();
+        }
+
+        return (context._staging);
+    }
 
+    void TraceUnit::Flush()
+    {
         m_Admin.Lock();
 
+        std::list<StagingBuffer*>::iterator index(m_Staging.begin());
+
+        while (index != m_Staging.end()) {
+            if (m_OutputChannel != nullptr) {
+                (*index)->Flush(*m_OutputChannel);
+            }
+
+            if (((*index)->IsOrphaned() == true) && ((*index)->IsEmpty() == true)) {
+                // The thread owning it is gone, nothing will be written into it anymore.
+                delete (*index);
+                index = m_Staging.erase(index);
+            } else {
+                index++;
+            }
+        }
+
+        m_Admin.Unlock();
+    }
+
+    void TraceUnit::Trace(const char file[], const uint32_t lineNumber, const char className[], const ITrace* const information)
+    {
+        const char* fileName(Core::FileNameOnly(file));
+
         if (m_OutputChannel != nullptr) {
 
             const char* category(information->Category());
             const char* module(information->Module());
             const uint64_t current = Core::Time::Now().Ticks();
-            const uint16_t fileNameLength = static_cast<uint16_t>(strlen(fileName) + 1); // File name.
-            const uint16_t moduleLength = static_cast<uint16_t>(strlen(module) + 1); // Module.
-            const uint16_t categoryLength = static_cast<uint16_t>(strlen(category) + 1); // Cateogory.
-            const uint16_t classNameLength = static_cast<uint16_t>(strlen(className) + 1); // Class name.
-            const uint16_t informationLength = information->Length(); // Actual data (no '\0' needed).
 
             // Trace entry has been simplified: 16 bit size followed by fields:
             // length(2 bytes) - clock ticks (8 bytes) - line number (4 bytes) - file/module/category/className
-            const uint16_t headerLength = 2 + 8 + 4 + fileNameLength + moduleLength + categoryLength + classNameLength;
-
-            const uint32_t fullLength = informationLength + headerLength; // Actual data (no '\0' needed).
-
-            // Tell the buffer how much we are going to write.
-            const uint32_t actualLength = m_OutputChannel->Reserve(fullLength);
-
-            if (actualLength >= headerLength) {
-                const uint16_t convertedLength = static_cast<uint16_t>(actualLength);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(&convertedLength), 2);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(&current), 8);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(&lineNumber), 4);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(fileName), fileNameLength);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(module), moduleLength);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(category), categoryLength);
-                m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(className), classNameLength);
-
-                if (actualLength >= fullLength) {
-                    // We can write the whole information.
-                    m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(information->Data()), informationLength);
-                } else {
-                    // Can only write information partially
-                    const uint16_t dropLength = actualLength - headerLength;
-
-                    m_OutputChannel->Write(reinterpret_cast<const uint8_t*>(information->Data()), dropLength);
+            const uint8_t* const fragments[] = {
+                reinterpret_cast<const uint8_t*>(&current),
+                reinterpret_cast<const uint8_t*>(&lineNumber),
+                reinterpret_cast<const uint8_t*>(fileName),
+                reinterpret_cast<const uint8_t*>(module),
+                reinterpret_cast<const uint8_t*>(category),
+                reinterpret_cast<const uint8_t*>(className),
+                reinterpret_cast<const uint8_t*>(information->Data())
+            };
+            const uint16_t lengths[] = {
+                8,
+                4,
+                static_cast<uint16_t>(strlen(fileName) + 1), // File name.
+                static_cast<uint16_t>(strlen(module) + 1), // Module.
+                static_cast<uint16_t>(strlen(category) + 1), // Category.
+                static_cast<uint16_t>(strlen(className) + 1), // Class name.
+                information->Length() // Actual data (no '\0' needed).
+            };
+            const uint16_t headerLength = 2 + lengths[0] + lengths[1] + lengths[2] + lengths[3] + lengths[4] + lengths[5];
+
+            // If this thread its staging buffer is full, the record is dropped, just like it
+            // would have been overwritten in the cyclic buffer.
+            if (Staging()->Push(headerLength, sizeof(lengths) / sizeof(uint16_t), fragments, lengths) == true) {
+                Flusher* flusher = m_Flusher.load(std::memory_order_acquire);
+
+                if (flusher != nullptr) {
+                    flusher->Signal();
                 }
             }
         }
@@ -434,8 +587,6 @@ namespace Trace {
             fprintf(stdout, "[%s]:[%s:%d]:[%s] %s: %s\n", time.c_str(), fileName, lineNumber, cleanClassName.Data(), information->Category(), information->Data());
             fflush(stdout);
         }
-
-        m_Admin.Unlock();
     }
 }
 } // namespace WPEFramework::Trace
@@ -186,6 +186,120 @@ namespace Trace {
             Core::DoorBell _doorBell;
         };
 
+        // Trace records are staged in a ring per thread, so the tracing threads never contend for a
+        // lock. The tracing thread is the only producer, the flusher the only consumer of a ring.
+        class EXTERNAL StagingBuffer {
+        private:
+            StagingBuffer(const StagingBuffer&) = delete;
+            StagingBuffer& operator=(const StagingBuffer&) = delete;
+
+        public:
+            enum { Size = 8 * 1024 };
+
+            StagingBuffer()
+                : _head(0)
+                , _tail(0)
+                , _references(2)
+            {
+            }
+            ~StagingBuffer()
+            {
+            }
+
+        public:
+            inline bool IsEmpty() const
+            {
+                return (_head.load(std::memory_order_acquire) == _tail.load(std::memory_order_relaxed));
+            }
+            // Both the thread and the TraceUnit hold a reference, the last one to let go deletes the buffer.
+            inline bool Release()
+            {
+                return (_references.fetch_sub(1) == 1);
+            }
+            inline bool IsOrphaned() const
+            {
+                return (_references.load() == 1);
+            }
+
+            bool Push(const uint16_t headerLength, const uint8_t count, const uint8_t* const fragments[], const uint16_t lengths[]);
+            void Flush(TraceBuffer& output);
+
+        private:
+            void Copy(const uint32_t position, const uint8_t data[], const uint32_t length);
+            void Peek(const uint32_t position, uint8_t data[], const uint32_t length) const;
+
+        private:
+            std::atomic<uint32_t> _head;
+            std::atomic<uint32_t> _tail;
+            std::atomic<uint8_t> _references;
+            uint8_t _buffer[Size];
+        };
+
+        class EXTERNAL Flusher : public Core::Thread {
+        private:
+            Flusher() = delete;
+            Flusher(const Flusher&) = delete;
+            Flusher& operator=(const Flusher&) = delete;
+
+        public:
+            Flusher(TraceUnit& parent)
+                : Core::Thread(Core::Thread::DefaultStackSize(), _T("TraceFlusher"))
+                , _parent(parent)
+                , _pending(false)
+            {
+            }
+            ~Flusher() override
+            {
+                Stop();
+                Wait(Core::Thread::STOPPED | Core::Thread::BLOCKED, Core::infinite);
+            }
+
+        public:
+            // Only the first record after a flush wakes up the flusher, all others piggyback.
+            inline void Signal()
+            {
+                if (_pending.exchange(true) == false) {
+                    Run();
+                }
+            }
+
+        private:
+            uint32_t Worker() override
+            {
+                Block();
+                _pending.store(false);
+                _parent.Flush();
+                return (Core::infinite);
+            }
+
+        private:
+            TraceUnit& _parent;
+            std::atomic<bool> _pending;
+        };
+
+    public:
+        // Per thread context, owning the thread its reference to its StagingBuffer.
+        class EXTERNAL ThreadContext {
+        private:
+            ThreadContext(const ThreadContext&) = delete;
+            ThreadContext& operator=(const ThreadContext&) = delete;
+
+        public:
+            ThreadContext()
+                : _staging(nullptr)
+            {
+            }
+            ~ThreadContext()
+            {
+                if ((_staging != nullptr) && (_staging->Release() == true)) {
+                    delete _staging;
+                }
+            }
+
+        public:
+            StagingBuffer* _staging;
+        };
+
     protected:
         TraceUnit();
 
@@ -246,6 +360,13 @@ namespace Trace {
         {
             ASSERT(m_OutputChannel == nullptr);
 
+            // The flusher thread is only started once there is something to flush, so a process
+            // that forks before opening the trace buffer (e.g. the zygote) does not lose it. It is
+            // there before the channel is, a Trace() that sees the channel also sees the flusher.
+            if (m_Flusher.load(std::memory_order_relaxed) == nullptr) {
+                m_Flusher.store(new Flusher(*this), std::memory_order_release);
+            }
+
             m_OutputChannel = new TraceBuffer(doorBell, fileName);
 
             ASSERT(m_OutputChannel->IsValid() == true);
@@ -253,12 +374,16 @@ namespace Trace {
             return (m_OutputChannel->IsValid() ? Core::ERROR_NONE : Core::ERROR_UNAVAILABLE);
         }
         void UpdateEnabledCategories(const Core::JSON::ArrayType<Setting::JSON>& info);
+        StagingBuffer* Staging();
+        void Flush();
 
         TraceControlList m_Categories;
         Core::CriticalSection m_Admin;
         TraceBuffer* m_OutputChannel;
         Settings m_EnabledCategories;
         bool m_DirectOut;
+        std::list<StagingBuffer*> m_Staging;
+        std::atomic<Flusher*> m_Flusher;
     };
 }
 } // namespace Trace
@@ -73,6 +73,13 @@ namespace JSONRPC {
                     {
                         return (!operator==(rhs));
                     }
+
+                    struct Hash {
+                        size_t operator()(const WatchDog& watchDog) const
+                        {
+                            return (std::hash<const void*>()(watchDog._client));
+                        }
+                    };
     
                 public:
                     uint64_t Timed(const uint64_t scheduledTime) {
@@ -120,7 +127,7 @@ namespace JSONRPC {
     
             private:
                 Core::ProxyPoolType<Core::JSONRPC::Message> _jsonRPCFactory;
-                Core::TimerType<WatchDog> _watchDog;
+                Core::TimerType<WatchDog, Core::TimerHeap<WatchDog, typename WatchDog::Hash>> _watchDog;
             };
     
             class ChannelImpl : public Core::StreamJSONType<Web::WebSocketClientType<Core::SocketStream>, FactoryImpl&, INTERFACE> {
@@ -580,7 +587,7 @@ namespace JSONRPC {
             : _adminLock()
             , _connectId(RemoteNodeId())
             , _channel(CommunicationChannel::Instance(_connectId, string("/jsonrpc/") + connectingCallsign, query))
-            , _handler([&](const uint32_t, const string&, const string&) {}, { DetermineVersion(callsign + '.') })
+            , _handler([&](const std::vector<uint32_t>&, const string&, const string&) {}, { DetermineVersion(callsign + '.') })
             , _callsign(callsign.empty() ? string() : Core::JSONRPC::Message::Callsign(callsign + '.'))
             , _localSpace()
             , _pendingQueue()
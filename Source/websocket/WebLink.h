@@ -198,6 +198,11 @@ namespace Web {
                 _activity = true;
                 return (_parent.SendData(_parent, dataFrame, maxSendSize));
             }
+            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize, Core::SocketPort::Reference& reference)
+            {
+                _activity = true;
+                return (_parent.SendData(_parent, dataFrame, maxSendSize, reference));
+            }
             uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
             {
                 _activity = true;
@@ -354,6 +359,21 @@ namespace Web {
             return (_serializerImpl.Serialize(dataFrame, receivedSize));
         }
 
+        // The transformer needs to see all data, so references are only handed out without one.
+        template <typename CLASSNAME>
+        inline typename Core::TypeTraits::enable_if<CLASSNAME::TraitSerializer::value, uint16_t>::type
+        SendData(const CLASSNAME&, uint8_t* dataFrame, const uint16_t receivedSize, Core::SocketPort::Reference&)
+        {
+            return (_transformer.Transform(_serializerImpl, dataFrame, receivedSize));
+        }
+
+        template <typename CLASSNAME>
+        inline typename Core::TypeTraits::enable_if<!CLASSNAME::TraitSerializer::value, uint16_t>::type
+        SendData(const CLASSNAME&, uint8_t* dataFrame, const uint16_t receivedSize, Core::SocketPort::Reference& reference)
+        {
+            return (_serializerImpl.Serialize(dataFrame, receivedSize, reference));
+        }
+
     private:
         SerializerImpl _serializerImpl;
         DeserializerImpl _deserialiserImpl;
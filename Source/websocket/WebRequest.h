@@ -66,6 +66,7 @@ namespace Web {
 
     enum EncodingTypes {
         ENCODING_GZIP,
+        ENCODING_DEFLATE,
         ENCODING_UNKNOWN
     };
 
@@ -95,6 +96,14 @@ namespace Web {
         // The Serialize and Deserialize methods allow the content to be serialized/deserialized.
         virtual uint16_t Serialize(uint8_t[] /* stream*/, const uint16_t /* maxLength */) const = 0;
         virtual uint16_t Deserialize(const uint8_t[] /* stream*/, const uint16_t /* maxLength */) = 0;
+
+        // Bodies that hold their content in memory, or in a file, can hand out the next length bytes
+        // as a reference, so they can be sent from where they are. These are accounted for as
+        // serialized. Returns false if the body does not support this.
+        virtual bool Content(const uint32_t /* length */, Core::SocketPort::Reference& /* reference */) const
+        {
+            return (false);
+        }
     };
 
     class EXTERNAL Signature {
@@ -246,7 +255,8 @@ namespace Web {
             MAN,
             M_X,
             S_T,
-			AUTHORIZATION
+			AUTHORIZATION,
+            RANGE
         };
 
         enum type {
@@ -336,9 +346,19 @@ namespace Web {
                 _lock.Unlock();
             }
 
-            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength);
+            inline uint16_t Serialize(uint8_t stream[], const uint16_t maxLength)
+            {
+                return (Serialize(stream, maxLength, nullptr));
+            }
+            // Same as above, but a body that is held in memory is handed out as a reference.
+            inline uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, Core::SocketPort::Reference& reference)
+            {
+                return (Serialize(stream, maxLength, &reference));
+            }
 
         private:
+            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, Core::SocketPort::Reference* reference);
+
             uint16_t _state;
             uint16_t _offset;
             uint8_t _keyIndex;
@@ -592,6 +612,7 @@ namespace Web {
             MX.Clear();
             ST.Clear();
             WebToken.Clear();
+            Range.Clear();
 
             if (_body.IsValid() == true) {
                 _body.Release();
@@ -629,6 +650,7 @@ namespace Web {
         Core::OptionalType<string> ST;
         Core::OptionalType<uint32_t> MX;
         Core::OptionalType<Authorization> WebToken;
+        Core::OptionalType<string> Range;
 
         inline bool HasBody() const
         {
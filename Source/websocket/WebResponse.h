@@ -86,6 +86,7 @@ namespace Web {
             CONTENT_ENCODING,
             TRANSFER_ENCODING,
             ACCEPT_RANGE,
+            CONTENT_RANGE,
             CONNECTION,
             ETAG,
             ACCESS_CONTROL_ALLOW_METHODS,
@@ -95,12 +96,14 @@ namespace Web {
             ALLOW,
             WEBSOCKET_ACCEPT,
             WEBSOCKET_PROTOCOL,
+            WEBSOCKET_EXTENSIONS,
             LOCATION,
             WAKEUP,
             U_S_N,
             S_T,
             CACHE_CONTROL,
-            APPLICATION_URL
+            APPLICATION_URL,
+            VARY
         };
 
         enum upgrade {
@@ -174,9 +177,19 @@ namespace Web {
                 _lock.Unlock();
             }
 
-            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength);
+            inline uint16_t Serialize(uint8_t stream[], const uint16_t maxLength)
+            {
+                return (Serialize(stream, maxLength, nullptr));
+            }
+            // Same as above, but a body that is held in memory is handed out as a reference.
+            inline uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, Core::SocketPort::Reference& reference)
+            {
+                return (Serialize(stream, maxLength, &reference));
+            }
 
         private:
+            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, Core::SocketPort::Reference* reference);
+
             uint16_t _state;
             uint16_t _offset;
             uint8_t _keyIndex;
@@ -279,6 +292,10 @@ namespace Web {
         };
 
     private:
+        // Bodies are compressed as a whole, up front, as the Content-Length must be known.
+        // Beyond this size, it is not worth the memory.
+        const static uint32_t MAX_COMPRESSION_SIZE = (4 * 1024 * 1024);
+
         Response(const Response&) = delete;
         Response& operator=(const Response&) = delete;
 
@@ -287,6 +304,7 @@ namespace Web {
             : ErrorCode(Web::STATUS_OK)
             , MajorVersion(Web::MajorVersion)
             , MinorVersion(Web::MinorVersion)
+            , _compressed()
         {
         }
         ~Response()
@@ -399,11 +417,13 @@ namespace Web {
             Server.Clear();
             Modified.Clear();
             AcceptRange.Clear();
+            ContentRange.Clear();
             ETag.Clear();
             ContentType.Clear();
             ContentLength.Clear();
             ContentEncoding.Clear();
             WebSocketAccept.Clear();
+            WebSocketExtensions.Clear();
             AccessControlOrigin.Clear();
             AccessControlMethod.Clear();
             AccessControlHeaders.Clear();
@@ -418,10 +438,13 @@ namespace Web {
             WakeUp.Clear();
             CacheControl.Clear();
             ApplicationURL.Clear();
+            Vary.Clear();
 
             if (_body.IsValid() == true) {
                 _body.Release();
             }
+
+            _compressed.clear();
         }
 
         uint16_t ErrorCode;
@@ -445,6 +468,7 @@ namespace Web {
         Core::OptionalType<string> AccessControlHeaders;
         Core::OptionalType<uint32_t> AccessControlMaxAge;
         Core::OptionalType<string> AcceptRange;
+        Core::OptionalType<string> ContentRange;
         Core::OptionalType<connection> Connection;
         Core::OptionalType<string> ST;
         Core::OptionalType<string> USN;
@@ -452,8 +476,16 @@ namespace Web {
         Core::OptionalType<string> WakeUp;
         Core::OptionalType<string> ETag;
         Core::OptionalType<string> WebSocketProtocol;
+        Core::OptionalType<string> WebSocketExtensions;
         Core::OptionalType<string> CacheControl;
         Core::OptionalType<Core::URL> ApplicationURL;
+        Core::OptionalType<string> Vary;
+
+        // Compresses the body with the given encoding, if it has at least threshold bytes and it
+        // gets smaller. This takes a while for big bodies, so it is up to the one submitting the
+        // response, not to the thread sending it out. Bodies that could have been compressed for
+        // another Accept-Encoding get a "Vary: Accept-Encoding", ENCODING_UNKNOWN only does that.
+        bool Compress(const EncodingTypes encoding, const uint32_t threshold);
 
         inline bool HasBody() const
         {
@@ -487,9 +519,13 @@ namespace Web {
             return (_marshalMode);
         }
 
+    private:
+        bool Deflate(const EncodingTypes encoding, const uint32_t length);
+
     private:
         Core::ProxyType<IBody> _body;
         MarshalType _marshalMode;
+        std::vector<uint8_t> _compressed;
     };
 }
 }
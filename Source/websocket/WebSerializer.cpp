@@ -42,6 +42,7 @@ static const TCHAR __CONNECTION_UPGRADE[] = _T("UPGRADE");
 static const TCHAR __CONNECTION_CLOSE[] = _T("CLOSE");
 static const TCHAR __CONNECTION_KEEPALIVE[] = _T("KEEP-ALIVE");
 static const TCHAR __ENCODING_GZIP[] = _T("GZIP");
+static const TCHAR __ENCODING_DEFLATE[] = _T("DEFLATE");
 
 static const TCHAR __HOST[] = _T("HOST:");
 static const TCHAR __UPGRADE[] = _T("UPGRADE:");
@@ -63,11 +64,13 @@ static const TCHAR __ST[] = _T("ST:");
 static const TCHAR __MAN[] = _T("MAN:");
 static const TCHAR __MX[] = _T("MX:");
 static const TCHAR __AUTHORIZATION[] = _T("AUTHORIZATION:");
+static const TCHAR __RANGE[] = _T("RANGE:");
 
 static const TCHAR __DATE[] = _T("DATE:");
 static const TCHAR __SERVER[] = _T("SERVER:");
 static const TCHAR __MODIFIED[] = _T("LAST-MODIFIED:");
 static const TCHAR __ACCEPT_RANGE[] = _T("ACCEPT-RANGES:");
+static const TCHAR __CONTENT_RANGE[] = _T("CONTENT-RANGE:");
 static const TCHAR __ETAG[] = _T("ETAG:");
 static const TCHAR __ALLOW[] = _T("ALLOW:");
 static const TCHAR __WEBSOCKET_KEY[] = _T("SEC-WEBSOCKET-KEY:");
@@ -84,6 +87,7 @@ static const TCHAR __LOCATION[] = _T("LOCATION:");
 static const TCHAR __WAKEUP[] = _T("WAKEUP:");
 static const TCHAR __CACHE_CONTROL[] = _T("CACHE-CONTROL:");
 static const TCHAR __APPLICATION_URL[] = _T("APPLICATION-URL:");
+static const TCHAR __VARY[] = _T("VARY:");
 
 static const TCHAR __CHARACTER_SET[] = _T("CHARSET=");
 
@@ -124,7 +128,8 @@ ENUM_CONVERSION_END(Web::MIMETypes)
 
 ENUM_CONVERSION_BEGIN(Web::EncodingTypes)
 
-    { Web::ENCODING_GZIP, _TXT(__ENCODING_GZIP) },
+    { Web::ENCODING_GZIP, _TXT("gzip") },
+    { Web::ENCODING_DEFLATE, _TXT("deflate") },
     { Web::ENCODING_UNKNOWN, _TXT(__UNKNOWN) },
 
 ENUM_CONVERSION_END(Web::EncodingTypes)
@@ -227,10 +232,12 @@ ENUM_CONVERSION_BEGIN(Web::Request::keywords)
     { Web::Request::WEBSOCKET_KEY, __TXT(__WEBSOCKET_KEY) },
     { Web::Request::WEBSOCKET_PROTOCOL, __TXT(__WEBSOCKET_PROTOCOL) },
     { Web::Request::WEBSOCKET_VERSION, __TXT(__WEBSOCKET_VERSION) },
+    { Web::Request::WEBSOCKET_EXTENSIONS, __TXT(__WEBSOCKET_EXTENSIONS) },
     { Web::Request::MAN, __TXT(__MAN) },
     { Web::Request::M_X, __TXT(__MX) },
     { Web::Request::S_T, __TXT(__ST) },
     { Web::Request::AUTHORIZATION, __TXT(__AUTHORIZATION) },
+    { Web::Request::RANGE, __TXT(__RANGE) },
 
 ENUM_CONVERSION_END(Web::Request::keywords)
 
@@ -262,6 +269,7 @@ ENUM_CONVERSION_BEGIN(Web::Response::keywords)
     { Web::Response::CONTENT_ENCODING, __TXT(__CONTENT_ENCODING) },
     { Web::Response::TRANSFER_ENCODING, __TXT(__TRANSFER_ENCODING) },
     { Web::Response::ACCEPT_RANGE, __TXT(__ACCEPT_RANGE) },
+    { Web::Response::CONTENT_RANGE, __TXT(__CONTENT_RANGE) },
     { Web::Response::CONNECTION, __TXT(__CONNECTION) },
     { Web::Response::ETAG, __TXT(__ETAG) },
     { Web::Response::ALLOW, __TXT(__ALLOW) },
@@ -271,12 +279,14 @@ ENUM_CONVERSION_BEGIN(Web::Response::keywords)
     { Web::Response::ACCESS_CONTROL_MAX_AGE, __TXT(__ACCESS_CONTROL_MAX_AGE) },
     { Web::Response::WEBSOCKET_ACCEPT, __TXT(__WEBSOCKET_ACCEPT) },
     { Web::Response::WEBSOCKET_PROTOCOL, __TXT(__WEBSOCKET_PROTOCOL) },
+    { Web::Response::WEBSOCKET_EXTENSIONS, __TXT(__WEBSOCKET_EXTENSIONS) },
     { Web::Response::LOCATION, __TXT(__LOCATION) },
     { Web::Response::WAKEUP, __TXT(__WAKEUP) },
     { Web::Response::U_S_N, __TXT(__USN) },
     { Web::Response::S_T, __TXT(__ST) },
     { Web::Response::CACHE_CONTROL, __TXT(__CACHE_CONTROL) },
     { Web::Response::APPLICATION_URL, __TXT(__APPLICATION_URL) },
+    { Web::Response::VARY, __TXT(__VARY) },
 
 ENUM_CONVERSION_END(Web::Response::keywords)
 
@@ -407,6 +417,74 @@ namespace Web
         return (filePresent);
     }
 
+    static bool ToRangeValue(const string& text, Core::OptionalType<uint64_t>& value)
+    {
+        bool result = true;
+
+        if (text.empty() == false) {
+            uint64_t number = 0;
+            string::const_iterator index(text.begin());
+
+            while ((result == true) && (index != text.end())) {
+                result = ((*index >= '0') && (*index <= '9') && (number <= (Core::NumberType<uint64_t>::Max() / 10)));
+                number = (number * 10) + (*index - '0');
+                index++;
+            }
+
+            if (result == true) {
+                value = number;
+            }
+        }
+
+        return (result);
+    }
+
+    WebStatus FileBody::Range(const string& range, string& contentRange)
+    {
+        static const TCHAR Unit[] = _T("bytes=");
+
+        // The range is resolved against the size the file has now, not the one it had when it was assigned.
+        LoadFileInfo();
+
+        const uint64_t size = Core::File::Size();
+        const size_t dash = range.find('-');
+        Core::OptionalType<uint64_t> first;
+        Core::OptionalType<uint64_t> last;
+        WebStatus result = STATUS_OK;
+
+        // Multiple ranges, we do not do multipart responses, just send it all..
+        if ((range.compare(0, (sizeof(Unit) / sizeof(TCHAR)) - 1, Unit) == 0) && (range.find(',') == string::npos) && (dash != string::npos) && (ToRangeValue(range.substr((sizeof(Unit) / sizeof(TCHAR)) - 1, dash - ((sizeof(Unit) / sizeof(TCHAR)) - 1)), first) == true) && (ToRangeValue(range.substr(dash + 1), last) == true) && ((first.IsSet() == true) || (last.IsSet() == true))) {
+
+            if (first.IsSet() == false) {
+                // Suffix range, the last N bytes..
+                if ((last.IsSet() == true) && (last.Value() > 0) && (size > 0)) {
+                    first = (last.Value() >= size ? 0 : size - last.Value());
+                    last = size - 1;
+                }
+            } else if ((last.IsSet() == false) || (last.Value() >= size)) {
+                last = size - 1;
+            }
+
+            if ((first.IsSet() == false) || (first.Value() >= size)) {
+                result = STATUS_REQUEST_RANGE_NOT_SATISFIABLE;
+                contentRange = _T("bytes */") + Core::NumberType<uint64_t>(size).Text();
+            } else if (last.Value() >= first.Value()) {
+                // A body is 32 bits at most, the client has to ask for what remains.
+                if ((last.Value() - first.Value()) >= static_cast<uint64_t>(~0u)) {
+                    last = first.Value() + static_cast<uint64_t>(~0u) - 1;
+                }
+
+                _startPosition = static_cast<int64_t>(first.Value());
+                _length = static_cast<uint32_t>(last.Value() - first.Value() + 1);
+
+                result = STATUS_PARTIAL_CONTENT;
+                contentRange = _T("bytes ") + Core::NumberType<uint64_t>(first.Value()).Text() + '-' + Core::NumberType<uint64_t>(last.Value()).Text() + '/' + Core::NumberType<uint64_t>(size).Text();
+            }
+        }
+
+        return (result);
+    }
+
     static Signature ToSignature(const string& input)
     {
         Core::TextFragment inputLine(input);
@@ -505,7 +583,80 @@ namespace Web
         }
     }
 
-    uint16_t Request::Serializer::Serialize(uint8_t stream[], const uint16_t maxLength)
+    // Pick the content coding we prefer from an Accept-Encoding list, gzip goes before deflate.
+    // A coding with a quality value of 0 is explicitly not acceptable.
+    static EncodingTypes PreferredEncoding(const string& text)
+    {
+        EncodingTypes result = ENCODING_UNKNOWN;
+        size_t begin = 0;
+
+        while ((result != ENCODING_GZIP) && (begin < text.length())) {
+            size_t end = text.find(',', begin);
+
+            if (end == string::npos) {
+                end = text.length();
+            }
+
+            size_t parameters = text.find(';', begin);
+            size_t first = text.find_first_not_of(_T(" \t"), begin);
+            size_t last = text.find_last_not_of(_T(" \t"), (parameters < end ? parameters : end) - 1);
+
+            if ((first != string::npos) && (last != string::npos) && (first <= last) && (last < end)) {
+                Core::TextFragment name(text, static_cast<uint32_t>(first), static_cast<uint32_t>(last - first + 1));
+                bool acceptable = true;
+
+                if (parameters < end) {
+                    size_t quality = text.find_first_of(_T("qQ"), parameters);
+
+                    if ((quality < end) && ((quality = text.find('=', quality)) < end)) {
+                        quality = text.find_first_not_of(_T("0. \t"), quality + 1);
+                        acceptable = (quality < end);
+                    }
+                }
+
+                if (acceptable == true) {
+                    if ((name.EqualText(__ENCODING_GZIP, 0, ((sizeof(__ENCODING_GZIP) / sizeof(TCHAR)) - 1), false) == true) || (name == _T("*"))) {
+                        result = ENCODING_GZIP;
+                    } else if (name.EqualText(__ENCODING_DEFLATE, 0, ((sizeof(__ENCODING_DEFLATE) / sizeof(TCHAR)) - 1), false) == true) {
+                        result = ENCODING_DEFLATE;
+                    }
+                }
+            }
+
+            begin = end + 1;
+        }
+
+        return (result);
+    }
+
+    // Content that is compressed by itself is not worth the effort of compressing it again.
+    static bool IsCompressible(const Core::OptionalType<MIMETypes>& mime)
+    {
+        bool result = true;
+
+        if (mime.IsSet() == true) {
+            switch (mime.Value()) {
+            case MIME_IMAGE_TIFF:
+            case MIME_IMAGE_VND:
+            case MIME_IMAGE_X_JNG:
+            case MIME_IMAGE_WEBP:
+            case MIME_IMAGE_GIF:
+            case MIME_IMAGE_JPG:
+            case MIME_IMAGE_PNG:
+            case MIME_FONT_OPENTYPE:
+            case MIME_APPLICATION_FONT_WOFF:
+            case MIME_APPLICATION_JAVA_ARCHIVE:
+                result = false;
+                break;
+            default:
+                break;
+            }
+        }
+
+        return (result);
+    }
+
+    uint16_t Request::Serializer::Serialize(uint8_t stream[], const uint16_t maxLength, Core::SocketPort::Reference* reference)
     {
         uint16_t current = 0;
 
@@ -808,15 +959,20 @@ namespace Web
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __AUTHORIZATION : _T("Authorization:"));
                             FromAuthorization(_current->WebToken.Value(), _value);
                             _offset = 0;
-                        } else if ((_keyIndex <= 22) && (((_bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0)) > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Request::CONNECTION_CLOSE))) {
-                            _keyIndex = (_bodyLength > 0 ? 23 : 24);
+                        } else if ((_keyIndex <= 22) && (_current->Range.IsSet() == true)) {
+                            _keyIndex = 23;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __RANGE : _T("Range:"));
+                            _value = _current->Range.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 23) && (((_bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0)) > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Request::CONNECTION_CLOSE))) {
+                            _keyIndex = (_bodyLength > 0 ? 24 : 25);
 
                             Core::NumberType<uint32_t, false, BASE_DECIMAL> number(_bodyLength);
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_LENGTH : _T("Content-Length:"));
                             number.Serialize(_value);
                             _offset = 0;
-                        } else if ((_keyIndex <= 23) && (_current->ContentSignature.IsSet() == true)) {
-                            _keyIndex = 24;
+                        } else if ((_keyIndex <= 24) && (_current->ContentSignature.IsSet() == true)) {
+                            _keyIndex = 25;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_SIGNATURE : _T("Content-HMAC:"));
                             FromSignature(_current->ContentSignature.Value(), _value);
                             _offset = 0;
@@ -863,6 +1019,16 @@ namespace Web
                     break;
                 }
                 case BODY: {
+                    if ((_bodyLength != 0) && (reference != nullptr)) {
+                        ASSERT(_current->_body.IsValid() == true);
+
+                        if (_current->_body->Content(_bodyLength, *reference) == true) {
+                            ASSERT(reference->Length == _bodyLength);
+
+                            _bodyLength = 0;
+                        }
+                    }
+
                     if (_bodyLength != 0) {
                         ASSERT(maxLength >= current);
                         uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
@@ -899,7 +1065,7 @@ namespace Web
         return (current);
     }
 
-    uint16_t Response::Serializer::Serialize(uint8_t stream[], const uint16_t maxLength)
+    uint16_t Response::Serializer::Serialize(uint8_t stream[], const uint16_t maxLength, Core::SocketPort::Reference* reference)
     {
         uint16_t current = 0;
 
@@ -936,6 +1102,13 @@ namespace Web
                     if (_buffer == nullptr) {
                         _buffer = HTTPKeyWord;
                         _offset = 0;
+
+                        // A new response, see what it takes to send out its body.
+                        if (_current->_compressed.empty() == false) {
+                            _bodyLength = static_cast<uint32_t>(_current->_compressed.size());
+                        } else {
+                            _bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0);
+                        }
                     }
 
                     // Copy the keyword..
@@ -1060,7 +1233,7 @@ namespace Web
                             _offset = 0;
                         } else if ((_keyIndex <= 6) && (_current->AcceptRange.IsSet() == true)) {
                             _keyIndex = 7;
-                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __ACCEPT_RANGE : _T("Accept-Range:"));
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __ACCEPT_RANGE : _T("Accept-Ranges:"));
                             _value = _current->AcceptRange.Value();
                             _offset = 0;
                         } else if ((_keyIndex <= 7) && (_current->ETag.IsSet() == true)) {
@@ -1187,15 +1360,30 @@ namespace Web
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __APPLICATION_URL : _T("Application-URL:"));
                             _value = _current->ApplicationURL.Value().Text();
                             _offset = 0;
-                        } else if ((_keyIndex <= 23) && (((_bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0)) > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Response::CONNECTION_CLOSE))) {
-                            _keyIndex = (_bodyLength > 0 ? 24 : 25);
+                        } else if ((_keyIndex <= 23) && (_current->ContentRange.IsSet() == true)) {
+                            _keyIndex = 24;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_RANGE : _T("Content-Range:"));
+                            _value = _current->ContentRange.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 24) && (_current->WebSocketExtensions.IsSet() == true)) {
+                            _keyIndex = 25;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __WEBSOCKET_EXTENSIONS : _T("Sec-WebSocket-Extensions:"));
+                            _value = _current->WebSocketExtensions.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 25) && (_current->Vary.IsSet() == true)) {
+                            _keyIndex = 26;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __VARY : _T("Vary:"));
+                            _value = _current->Vary.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 26) && ((_bodyLength > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Response::CONNECTION_CLOSE))) {
+                            _keyIndex = (_bodyLength > 0 ? 27 : 28);
 
                             Core::NumberType<uint32_t, false, BASE_DECIMAL> number(_bodyLength);
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_LENGTH : _T("Content-Length:"));
                             number.Serialize(_value);
                             _offset = 0;
-                        } else if ((_keyIndex <= 24) && (_current->ContentSignature.IsSet() == true)) {
-                            _keyIndex = 25;
+                        } else if ((_keyIndex <= 27) && (_current->ContentSignature.IsSet() == true)) {
+                            _keyIndex = 28;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_SIGNATURE : _T("Content-HMAC:"));
                             FromSignature(_current->ContentSignature.Value(), _value);
                             _offset = 0;
@@ -1242,14 +1430,34 @@ namespace Web
                     break;
                 }
                 case BODY: {
+                    if ((_bodyLength != 0) && (reference != nullptr)) {
+                        if (_current->_compressed.empty() == false) {
+                            reference->Data = &(_current->_compressed[_current->_compressed.size() - _bodyLength]);
+                            reference->Length = _bodyLength;
+                            _bodyLength = 0;
+                        } else {
+                            ASSERT(_current->_body.IsValid() == true);
+
+                            if (_current->_body->Content(_bodyLength, *reference) == true) {
+                                ASSERT(reference->Length == _bodyLength);
+
+                                _bodyLength = 0;
+                            }
+                        }
+                    }
+
                     if (_bodyLength != 0) {
                         ASSERT(maxLength >= current);
                         uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
 
                         if (size > 0) {
-                            ASSERT(_current->_body.IsValid() == true);
+                            if (_current->_compressed.empty() == false) {
+                                ::memcpy(&(stream[current]), &(_current->_compressed[_current->_compressed.size() - _bodyLength]), size);
+                            } else {
+                                ASSERT(_current->_body.IsValid() == true);
 
-                            _current->_body->Serialize(&(stream[current]), size);
+                                _current->_body->Serialize(&(stream[current]), size);
+                            }
                             _bodyLength -= size;
                             current += size;
                         }
@@ -1278,6 +1486,77 @@ namespace Web
         return (current);
     }
 
+    bool Response::Compress(const EncodingTypes encoding, const uint32_t threshold)
+    {
+        bool result = false;
+
+        if ((_body.IsValid() == true) && (_compressed.empty() == true) && (ContentEncoding.IsSet() == false) && (ContentRange.IsSet() == false) && (IsCompressible(ContentType) == true)) {
+            const uint32_t length = _body->Serialize();
+
+            if ((length >= threshold) && (length <= MAX_COMPRESSION_SIZE)) {
+                // Had it been asked for with another Accept-Encoding, the body might have been different.
+                Vary = _T("Accept-Encoding");
+
+                if ((encoding == ENCODING_GZIP) || (encoding == ENCODING_DEFLATE)) {
+                    result = Deflate(encoding, length);
+                }
+            }
+
+            // Whatever happened, the serializer starts reading the body all over again.
+            _body->End();
+        }
+
+        return (result);
+    }
+
+    bool Response::Deflate(const EncodingTypes encoding, const uint32_t length)
+    {
+        z_stream stream;
+        bool result = false;
+
+        stream.zalloc = nullptr;
+        stream.zfree = nullptr;
+        stream.opaque = nullptr;
+
+        // gzip comes with its own header and trailer, deflate (RFC 1950) with a zlib wrapper.
+        if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, (encoding == ENCODING_GZIP ? 16 + MAX_WBITS : MAX_WBITS), 8, Z_DEFAULT_STRATEGY) == Z_OK) {
+            uint8_t buffer[4096];
+            uint32_t remaining = length;
+            int status = Z_OK;
+
+            _compressed.resize(deflateBound(&stream, length));
+            stream.next_out = _compressed.data();
+            stream.avail_out = static_cast<uInt>(_compressed.size());
+            stream.avail_in = 0;
+
+            while (status == Z_OK) {
+                if ((stream.avail_in == 0) && (remaining != 0)) {
+                    uint16_t loaded = _body->Serialize(buffer, static_cast<uint16_t>(std::min(remaining, static_cast<uint32_t>(sizeof(buffer)))));
+
+                    remaining = (loaded == 0 ? 0 : remaining - loaded);
+                    stream.next_in = buffer;
+                    stream.avail_in = loaded;
+                }
+
+                status = deflate(&stream, (remaining == 0 ? Z_FINISH : Z_NO_FLUSH));
+            }
+
+            if ((status == Z_STREAM_END) && (stream.total_out < length)) {
+                _compressed.resize(stream.total_out);
+                ContentEncoding = encoding;
+                result = true;
+            }
+
+            deflateEnd(&stream);
+        }
+
+        if (result == false) {
+            _compressed.clear();
+        }
+
+        return (result);
+    }
+
     uint16_t Request::Deserializer::Parse(const uint8_t stream[], const uint16_t maxLength)
     {
         ASSERT(_current != nullptr);
@@ -1405,7 +1684,7 @@ namespace Web
                         _zlib.opaque = nullptr;
                         _zlib.avail_in = 0;
                         _zlib.next_in = nullptr;
-                        _zlibResult = inflateInit2(&_zlib, 16 + MAX_WBITS);
+                        _zlibResult = inflateInit2(&_zlib, 32 + MAX_WBITS);
                     } else {
                         _zlibResult = static_cast<uint32_t>(~0);
                     }
@@ -1482,6 +1761,9 @@ namespace Web
             case Request::AUTHORIZATION:
                 _current->WebToken = ToAuthorization(buffer);
                 break;
+            case Request::RANGE:
+                _current->Range = buffer;
+                break;
             case Request::CONTENT_SIGNATURE:
                 _current->ContentSignature = ToSignature(buffer);
                 break;
@@ -1499,13 +1781,10 @@ namespace Web
                 break;
             }
             case Request::ACCEPT_ENCODING: {
-                // We only allow for GZIP, right now, so see if it is an allowed format, if so, use it.
-                Core::TextSegmentIterator entries(Core::TextFragment(buffer), true, ',');
+                EncodingTypes encoding = PreferredEncoding(buffer);
 
-                while (entries.Next() != false) {
-                    if (entries.Current().EqualText(__ENCODING_GZIP, 0, ((sizeof(__ENCODING_GZIP) / sizeof(TCHAR)) - 1), false) == true) {
-                        _current->AcceptEncoding = ENCODING_GZIP;
-                    }
+                if (encoding != ENCODING_UNKNOWN) {
+                    _current->AcceptEncoding = encoding;
                 }
                 break;
             }
@@ -1766,7 +2045,7 @@ namespace Web
                         _zlib.opaque = nullptr;
                         _zlib.avail_in = 0;
                         _zlib.next_in = nullptr;
-                        _zlibResult = inflateInit2(&_zlib, 16 + MAX_WBITS);
+                        _zlibResult = inflateInit2(&_zlib, 32 + MAX_WBITS);
                     } else {
                         _zlibResult = static_cast<uint32_t>(~0);
                     }
@@ -1805,6 +2084,9 @@ namespace Web
             case Response::ACCEPT_RANGE:
                 _current->AcceptRange = buffer;
                 break;
+            case Response::CONTENT_RANGE:
+                _current->ContentRange = buffer;
+                break;
             case Response::ACCESS_CONTROL_ALLOW_ORIGIN:
                 _current->AccessControlOrigin = buffer;
                 break;
@@ -1823,6 +2105,9 @@ namespace Web
             case Response::WEBSOCKET_PROTOCOL:
                 _current->WebSocketProtocol = buffer;
                 break;
+            case Response::WEBSOCKET_EXTENSIONS:
+                _current->WebSocketExtensions = buffer;
+                break;
             case Response::CONTENT_SIGNATURE:
                 _current->ContentSignature = ToSignature(buffer);
                 break;
@@ -1844,6 +2129,9 @@ namespace Web
             case Response::CACHE_CONTROL:
                 _current->CacheControl = buffer;
                 break;
+            case Response::VARY:
+                _current->Vary = buffer;
+                break;
             case Response::CONTENT_TYPE:
                 ParseContentType(buffer, _current->ContentType, _current->ContentCharacterSet);
                 break;
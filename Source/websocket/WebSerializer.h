@@ -71,6 +71,16 @@ namespace Web {
 
             return size;
         }
+        bool Content(const uint32_t length, Core::SocketPort::Reference& reference) const override
+        {
+            ASSERT((_lastPosition + length) <= static_cast<uint32_t>(string::length() * sizeof(TCHAR)));
+
+            reference.Data = &(reinterpret_cast<const uint8_t*>(string::c_str())[_lastPosition]);
+            reference.Length = length;
+            _lastPosition += length;
+
+            return (true);
+        }
         uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength) override
         {
             uint16_t index = 0;
@@ -150,12 +160,14 @@ namespace Web {
             : Core::File()
             , _opened(false)
             , _startPosition(0)
+            , _length(static_cast<uint32_t>(~0))
         {
         }
         FileBody(const string& path, const bool sharable)
             : Core::File(path, sharable)
             , _opened(false)
             , _startPosition(0)
+            , _length(static_cast<uint32_t>(~0))
         {
         }
         ~FileBody() override = default;
@@ -165,28 +177,45 @@ namespace Web {
         {
             Core::File::operator=(location);
             _startPosition = 0;
+            _length = static_cast<uint32_t>(~0);
 
             return (*this);
         }
         inline FileBody& operator=(const File& RHS)
         {
             Core::File::operator=(RHS);
-            _startPosition = static_cast<int32_t>(Core::File::Position());
+            _startPosition = Core::File::Position();
+            _length = static_cast<uint32_t>(~0);
 
             return (*this);
         }
 
+        // Limit the body to the (single) byte range of a Range request header: "bytes=first-last",
+        // "bytes=first-" or "bytes=-suffix". Returns STATUS_PARTIAL_CONTENT with the matching
+        // Content-Range, STATUS_REQUEST_RANGE_NOT_SATISFIABLE if the file does not hold it, or
+        // STATUS_OK, if the range is not understood and the whole file should be sent.
+        WebStatus Range(const string& range, string& contentRange);
+
     protected:
         uint32_t Serialize() const override
         {
+            uint32_t result = 0;
+
             // Are we opening the file ?
             _opened = (Core::File::IsOpen() == false);
 
             if (_opened == false) {
                 const_cast<FileBody*>(this)->LoadFileInfo();
-                const_cast<FileBody*>(this)->Position(false, _startPosition);
             }
-            return (((_opened == false) || (Core::File::Open() == true)) ? static_cast<uint32_t>(Core::File::Size() - _startPosition) : 0);
+            if ((_opened == false) || (Core::File::Open() == true)) {
+                const uint64_t size = Core::File::Size();
+
+                if (static_cast<uint64_t>(_startPosition) < size) {
+                    const_cast<FileBody*>(this)->Position(false, _startPosition);
+                    result = static_cast<uint32_t>(std::min(size - _startPosition, static_cast<uint64_t>(_length)));
+                }
+            }
+            return (result);
         }
         uint32_t Deserialize() override
         {
@@ -197,11 +226,21 @@ namespace Web {
         {
             return Core::File::Read(stream, maxLength);
         }
+        // The file is sent from where it is, the file position is not moved.
+        bool Content(const uint32_t length, Core::SocketPort::Reference& reference) const override
+        {
+            reference.Data = nullptr;
+            reference.Length = length;
+            reference.Source = const_cast<FileBody&>(*this);
+            reference.Offset = Core::File::Position();
+
+            return (true);
+        }
         uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength) override
         {
             uint16_t write = Core::File::Write(stream, maxLength);
             if (!write) {
-                _startPosition = Core::NumberType<int32_t>::Max();
+                _startPosition = Core::NumberType<int64_t>::Max();
             }
 
             return write;
@@ -212,7 +251,7 @@ namespace Web {
                 if (_opened == true) {
                     Core::File::Close();
                 } else {
-                    if (_startPosition == Core::NumberType<int32_t>::Max()) {
+                    if (_startPosition == Core::NumberType<int64_t>::Max()) {
                         const_cast<FileBody*>(this)->SetSize(0);
                     } else {
                         const_cast<FileBody*>(this)->Position(false, _startPosition);
@@ -223,7 +262,8 @@ namespace Web {
 
     private:
         mutable bool _opened;
-        mutable int32_t _startPosition;
+        mutable int64_t _startPosition;
+        uint32_t _length;
     };
 
     template <typename HASHALGORITHM>
@@ -350,6 +390,16 @@ namespace Web {
             }
             return size;
         }
+        bool Content(const uint32_t length, Core::SocketPort::Reference& reference) const override
+        {
+            ASSERT((_lastPosition + length) <= static_cast<uint32_t>(_body.length() * sizeof(TCHAR)));
+
+            reference.Data = &(reinterpret_cast<const uint8_t*>(_body.c_str())[_lastPosition]);
+            reference.Length = length;
+            _lastPosition += length;
+
+            return (true);
+        }
         uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength) override
         {
             return static_cast<Core::JSON::IElement&>(*this).Deserialize(reinterpret_cast<const char*>(stream), maxLength, _offset);
@@ -361,7 +411,7 @@ namespace Web {
     private:
         mutable uint32_t _lastPosition;
         mutable string _body;
-        uint16_t _offset;
+        uint32_t _offset;
     };
 
     template <typename JSONOBJECT, typename HASHALGORITHM>
@@ -19,6 +19,12 @@
 
 #include "WebSocketLink.h"
 
+#if defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__GNUC__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace WPEFramework {
 namespace Web {
     namespace WebSocket {
@@ -40,7 +46,32 @@ namespace Web {
         static const uint8_t TYPE_FRAME = 0x0F;
         static const uint8_t MASKING_FRAME = 0x80;
         static const uint8_t CONTROL_FRAME = 0x08;
+        static const uint8_t COMPRESSED_FRAME = 0x40;
         static const uint8_t HandShakeKey[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+        static const uint8_t DeflateTail[] = { 0x00, 0x00, 0xFF, 0xFF };
+        static const TCHAR DeflateExtension[] = _T("permessage-deflate");
+        static constexpr uint16_t InflateBufferSize = 4096;
+
+        // Next element of a delimited header value, without the surrounding white space.
+        static string Element(const string& text, size_t& offset, const TCHAR delimiter)
+        {
+            string result;
+            size_t end = text.find(delimiter, offset);
+
+            if (end == string::npos) {
+                end = text.length();
+            }
+
+            size_t first = text.find_first_not_of(_T(" \t"), offset);
+
+            if (first < end) {
+                result = text.substr(first, text.find_last_not_of(_T(" \t"), end - 1) - first + 1);
+            }
+
+            offset = end + 1;
+
+            return (result);
+        }
 
         std::string Protocol::RequestKey() const
         {
@@ -68,6 +99,351 @@ namespace Web {
             return (baseEncodedKey);
         }
 
+        /* static */ void Protocol::Mask(uint8_t data[], const uint32_t length, const uint8_t key[4], const uint8_t offset)
+        {
+            // Line up the key with the first byte, from there on it repeats every 4 bytes, so the
+            // wide steps below never shift the pattern.
+            uint8_t pattern[16];
+            uint8_t* current = data;
+            uint8_t* const end = &(data[length]);
+
+            for (uint8_t index = 0; index < sizeof(pattern); index++) {
+                pattern[index] = key[(offset + index) & 0x03];
+            }
+
+#if defined(__GNUC__) && defined(__SSE2__)
+            const __m128i wide = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+
+            while ((end - current) >= 64) {
+                __m128i* chunk = reinterpret_cast<__m128i*>(current);
+
+                _mm_storeu_si128(&chunk[0], _mm_xor_si128(_mm_loadu_si128(&chunk[0]), wide));
+                _mm_storeu_si128(&chunk[1], _mm_xor_si128(_mm_loadu_si128(&chunk[1]), wide));
+                _mm_storeu_si128(&chunk[2], _mm_xor_si128(_mm_loadu_si128(&chunk[2]), wide));
+                _mm_storeu_si128(&chunk[3], _mm_xor_si128(_mm_loadu_si128(&chunk[3]), wide));
+                current += 64;
+            }
+            while ((end - current) >= 16) {
+                __m128i* chunk = reinterpret_cast<__m128i*>(current);
+
+                _mm_storeu_si128(chunk, _mm_xor_si128(_mm_loadu_si128(chunk), wide));
+                current += 16;
+            }
+#elif defined(__GNUC__) && defined(__ARM_NEON)
+            const uint8x16_t wide = vld1q_u8(pattern);
+
+            while ((end - current) >= 64) {
+                vst1q_u8(&current[0], veorq_u8(vld1q_u8(&current[0]), wide));
+                vst1q_u8(&current[16], veorq_u8(vld1q_u8(&current[16]), wide));
+                vst1q_u8(&current[32], veorq_u8(vld1q_u8(&current[32]), wide));
+                vst1q_u8(&current[48], veorq_u8(vld1q_u8(&current[48]), wide));
+                current += 64;
+            }
+            while ((end - current) >= 16) {
+                vst1q_u8(current, veorq_u8(vld1q_u8(current), wide));
+                current += 16;
+            }
+#endif
+            uint64_t word;
+
+            ::memcpy(&word, pattern, sizeof(word));
+
+            while ((end - current) >= static_cast<ptrdiff_t>(sizeof(word))) {
+                uint64_t chunk;
+
+                ::memcpy(&chunk, current, sizeof(chunk));
+                chunk ^= word;
+                ::memcpy(current, &chunk, sizeof(chunk));
+                current += sizeof(chunk);
+            }
+
+            for (uint8_t index = 0; current != end; index++, current++) {
+                *current ^= pattern[index];
+            }
+        }
+
+        // Evaluate one permessage-deflate element of a Sec-WebSocket-Extensions header. On the server this is
+        // an offer of the client, on the client the answer of the server to its own offer.
+        bool Protocol::CompressionParameters(const string& extension, const bool server, uint8_t& deflateBits)
+        {
+            size_t offset = 0;
+            bool result = (Element(extension, offset, ';') == DeflateExtension);
+
+            deflateBits = 0;
+
+            while ((result == true) && (offset < extension.length())) {
+                string parameter = Element(extension, offset, ';');
+                size_t assign = 0;
+                string name = Element(parameter, assign, '=');
+                string value = (assign < parameter.length() ? Element(parameter, assign, ';') : string());
+
+                if ((value.length() >= 2) && (value[0] == '\"') && (value[value.length() - 1] == '\"')) {
+                    value = value.substr(1, value.length() - 2);
+                }
+
+                if (name == _T("server_no_context_takeover")) {
+                    _compression |= (server ? DEFLATE_RESET : INFLATE_RESET);
+                } else if (name == _T("client_no_context_takeover")) {
+                    _compression |= (server ? INFLATE_RESET : DEFLATE_RESET);
+                } else if ((name == _T("server_max_window_bits")) || (name == _T("client_max_window_bits"))) {
+                    const bool ours = (server == (name[0] == 's'));
+                    const uint8_t bits = static_cast<uint8_t>(value.empty() ? 0 : ::atoi(value.c_str()));
+
+                    if (ours == true) {
+                        // It limits the window we compress with. A raw deflate stream with a window of 256
+                        // bytes is not something zlib can produce.
+                        result = ((bits >= 9) && (bits <= MAX_WBITS));
+                        deflateBits = bits;
+                    } else {
+                        // It limits the window the other side compresses with. We can inflate any window,
+                        // a client might only hint it supports the parameter, without a value.
+                        result = (value.empty() ? (server == true) : ((bits >= 8) && (bits <= MAX_WBITS)));
+                    }
+                } else {
+                    result = false;
+                }
+            }
+
+            return (result);
+        }
+
+        bool Protocol::CompressionBegin(const uint8_t deflateBits)
+        {
+            bool result = false;
+
+            _deflater.zalloc = nullptr;
+            _deflater.zfree = nullptr;
+            _deflater.opaque = nullptr;
+            _deflater.avail_in = 0;
+            _inflater.zalloc = nullptr;
+            _inflater.zfree = nullptr;
+            _inflater.opaque = nullptr;
+            _inflater.avail_in = 0;
+            _inflater.next_in = nullptr;
+
+            // Negative window sizes give raw deflate streams, without the zlib wrapper.
+            if (deflateInit2(&_deflater, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -static_cast<int>(deflateBits == 0 ? MAX_WBITS : deflateBits), 8, Z_DEFAULT_STRATEGY) == Z_OK) {
+                if (inflateInit2(&_inflater, -MAX_WBITS) == Z_OK) {
+                    _inflated.resize(InflateBufferSize);
+                    _carried = 0;
+                    _progressInfo &= (~0x10);
+                    _compression |= DEFLATE_ACTIVE;
+                    result = true;
+                } else {
+                    deflateEnd(&_deflater);
+                }
+            }
+
+            if (result == false) {
+                TRACE_L1("Could not initialize the permessage-deflate compression. Messages are sent as is.%s", "");
+            }
+
+            return (result);
+        }
+
+        string Protocol::CompressionOffer() const
+        {
+            string result;
+
+            if ((_compression & DEFLATE_ENABLED) != 0) {
+                result = DeflateExtension;
+
+                if ((_compression & DEFLATE_TAKEOVER) == 0) {
+                    result += _T("; server_no_context_takeover; client_no_context_takeover");
+                }
+            }
+
+            return (result);
+        }
+
+        bool Protocol::CompressionAccepted(const string& response)
+        {
+            bool result = false;
+
+            CompressionEnd();
+
+            if ((_compression & DEFLATE_ENABLED) != 0) {
+                uint8_t deflateBits;
+                uint16_t flags = _compression;
+
+                if (CompressionParameters(response, false, deflateBits) == true) {
+                    // Keeping the context is always up to the compressing side.
+                    if ((_compression & DEFLATE_TAKEOVER) == 0) {
+                        _compression |= DEFLATE_RESET;
+                    }
+                    result = CompressionBegin(deflateBits);
+                }
+
+                if (result == false) {
+                    _compression = flags;
+                }
+            }
+
+            return (result);
+        }
+
+        bool Protocol::CompressionOffered(const string& offers, string& response)
+        {
+            bool result = false;
+
+            CompressionEnd();
+
+            if ((_compression & DEFLATE_ENABLED) != 0) {
+                const uint16_t flags = _compression;
+                size_t offset = 0;
+
+                // The offers are in the order of preference of the client, pick the first we can honour.
+                while ((result == false) && (offset < offers.length())) {
+                    uint8_t deflateBits;
+
+                    _compression = flags;
+
+                    if ((CompressionParameters(Element(offers, offset, ','), true, deflateBits) == true) && (CompressionBegin(deflateBits) == true)) {
+                        if ((_compression & DEFLATE_TAKEOVER) == 0) {
+                            // Ask the client to do the same, we can drop our context as well then.
+                            _compression |= (DEFLATE_RESET | INFLATE_RESET);
+                        }
+
+                        response = DeflateExtension;
+
+                        if ((_compression & DEFLATE_RESET) != 0) {
+                            response += _T("; server_no_context_takeover");
+                        }
+                        if ((_compression & INFLATE_RESET) != 0) {
+                            response += _T("; client_no_context_takeover");
+                        }
+                        if (deflateBits != 0) {
+                            response += _T("; server_max_window_bits=") + Core::NumberType<uint8_t>(deflateBits).Text();
+                        }
+
+                        result = true;
+                    }
+                }
+
+                if (result == false) {
+                    _compression = flags;
+                }
+            }
+
+            return (result);
+        }
+
+        void Protocol::Staged(const uint16_t length, const bool final)
+        {
+            ASSERT(IsStaging() == true);
+
+            // An empty bit only matters if it completes a message.
+            if ((length != 0) || ((_compression & DEFLATE_MESSAGE) != 0)) {
+                _compression |= (DEFLATE_MESSAGE | (final ? DEFLATE_FLUSH : 0));
+                _deflater.next_in = _staging.data();
+                _deflater.avail_in = length;
+            }
+        }
+
+        uint16_t Protocol::Deflate(uint8_t frame[], const uint16_t maxSize, bool& final)
+        {
+            uint16_t result = 0;
+
+            final = false;
+
+            if (((_compression & DEFLATE_MESSAGE) != 0) && (maxSize > sizeof(_carry))) {
+                const bool flush = ((_compression & DEFLATE_FLUSH) != 0);
+
+                ::memcpy(frame, _carry, _carried);
+
+                _deflater.next_out = &(frame[_carried]);
+                _deflater.avail_out = maxSize - _carried;
+
+                int status = deflate(&_deflater, (flush ? Z_SYNC_FLUSH : Z_NO_FLUSH));
+
+                ASSERT(status != Z_STREAM_ERROR);
+                DEBUG_VARIABLE(status);
+
+                result = static_cast<uint16_t>(maxSize - _deflater.avail_out);
+
+                if ((flush == true) && (_deflater.avail_out != 0)) {
+                    // The message is complete. The flush ends it with 0x00 0x00 0xFF 0xFF, which is not
+                    // sent, the receiving side appends it again (RFC 7692, 7.2.1).
+                    ASSERT(result >= sizeof(DeflateTail));
+
+                    result -= sizeof(DeflateTail);
+                    _carried = 0;
+                    final = true;
+                    _compression &= ~(DEFLATE_MESSAGE | DEFLATE_FLUSH);
+
+                    if ((_compression & DEFLATE_RESET) != 0) {
+                        deflateReset(&_deflater);
+                    }
+                } else {
+                    // Hold back the last bytes, they might turn out to be the start of that tail.
+                    _carried = static_cast<uint8_t>(std::min(result, static_cast<uint16_t>(sizeof(_carry))));
+                    result -= _carried;
+                    ::memcpy(_carry, &(frame[result]), _carried);
+                }
+            }
+
+            return (result);
+        }
+
+        void Protocol::Inflate(uint8_t frame[], const uint16_t length, const bool final)
+        {
+            ASSERT(_inflater.avail_in == 0);
+
+            _inflater.next_in = frame;
+            _inflater.avail_in = length;
+
+            if (final == true) {
+                _compression |= INFLATE_FINAL;
+            }
+        }
+
+        uint16_t Protocol::Inflated(uint8_t*& data)
+        {
+            uint16_t result = 0;
+
+            while ((result == 0) && ((_inflater.avail_in != 0) || ((_compression & (INFLATE_FINAL | INFLATE_PENDING)) != 0))) {
+
+                if ((_inflater.avail_in == 0) && ((_compression & INFLATE_PENDING) == 0)) {
+                    // All of the message went in, add the tail the sender left out.
+                    _inflater.next_in = const_cast<uint8_t*>(DeflateTail);
+                    _inflater.avail_in = sizeof(DeflateTail);
+                    _compression &= (~INFLATE_FINAL);
+                }
+
+                _inflater.next_out = _inflated.data();
+                _inflater.avail_out = static_cast<uInt>(_inflated.size());
+
+                int status = inflate(&_inflater, Z_SYNC_FLUSH);
+
+                result = static_cast<uint16_t>(_inflated.size() - _inflater.avail_out);
+
+                if ((status == Z_OK) && (_inflater.avail_out == 0)) {
+                    _compression |= INFLATE_PENDING;
+                } else {
+                    _compression &= (~INFLATE_PENDING);
+
+                    if (status == Z_STREAM_END) {
+                        // The sender closed the deflate stream, whatever follows is a new one.
+                        inflateReset(&_inflater);
+                    } else if ((status != Z_OK) && (status != Z_BUF_ERROR)) {
+                        TRACE_L1("Could not inflate the websocket message, error: %d", status);
+
+                        _inflater.avail_in = 0;
+                        _compression &= (~INFLATE_FINAL);
+                        inflateReset(&_inflater);
+                    }
+                }
+            }
+
+            if ((result == 0) && ((_compression & INFLATE_RESET) != 0) && (IsCompressedMessage() == true) && (ReceiveInProgress() == false) && (IsCompleteMessage() == true)) {
+                inflateReset(&_inflater);
+            }
+
+            data = _inflated.data();
+
+            return (result);
+        }
+
         /*  %x0 denotes a continuation frame
  *  %x1 denotes a text frame
  *  %x2 denotes a binary frame
@@ -77,43 +453,35 @@ namespace Web {
  *  %xA denotes a pong
  *  %xB-F are reserved for further control frames
  */
-        uint16_t Protocol::Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize)
+        uint16_t Protocol::Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize, const bool final)
         {
             uint32_t result = 0;
 
-            if ((usedSize != 0) || (SendInProgress() == true)) {
-                result = (usedSize <= 125 ? 2 : 4);
+            if ((usedSize != 0) || ((final == true) && (SendInProgress() == true))) {
+                // Only the first frame of a message carries the compressed flag (RSV1).
+                const uint8_t compressed = (((SendInProgress() == false) && (IsCompressed() == true)) ? COMPRESSED_FRAME : 0);
 
-                if ((_setFlags & MASKING_FRAME) == 0) {
-                    // Only if this is a smallFrame, we need to "flush" 2 bytes..
-                    if ((result == 2) && (usedSize != 0)) {
-                        // No masking, so just move and insert the header up front..
-                        ::memmove(&dataFrame[2], &(dataFrame[4]), usedSize);
-                    }
-                } else {
+                const uint8_t reserved = HeaderSize();
+
+                result = (usedSize <= 125 ? 2 : 4) + ((_setFlags & MASKING_FRAME) != 0 ? 4 : 0);
+
+                // The payload was loaded behind the largest header, only a small frame has to move up.
+                if ((result != reserved) && (usedSize != 0)) {
+                    ::memmove(&dataFrame[result], &(dataFrame[reserved]), usedSize);
+                }
+
+                if ((_setFlags & MASKING_FRAME) != 0) {
                     uint32_t value;
-                    // Generate a new mask value
-                    uint8_t maskKey[4];
+                    uint8_t* maskKey = &dataFrame[result - 4];
+
+                    // Generate a new mask value, it goes right in front of the payload.
                     Crypto::Random(value);
                     maskKey[0] = value & 0xFF;
                     maskKey[1] = (value >> 8) & 0xFF;
                     maskKey[2] = (value >> 16) & 0xFF;
                     maskKey[3] = (value >> 24) & 0xFF;
 
-                    // Mask and insert the bytes on the right spots
-                    uint8_t* source = &dataFrame[usedSize - 1 + 4];
-                    uint8_t* destination = &dataFrame[usedSize - 1 + 4 + result];
-                    uint32_t bytesToMove = usedSize;
-
-                    while (bytesToMove != 0) {
-                        bytesToMove--;
-                        *destination-- = (*source ^ maskKey[(bytesToMove & 0x3)]);
-                        source--;
-                    }
-
-                    // Now there is space again, write down the encryption key.
-                    ::memcpy(&dataFrame[result], &maskKey, 4);
-                    result += 4;
+                    Mask(&dataFrame[result], usedSize, maskKey, 0);
                 }
 
                 if (usedSize <= 125) {
@@ -125,13 +493,12 @@ namespace Web {
                     dataFrame[3] = (usedSize & 0xFF);
                 }
 
-                if (usedSize < maxSendSize) {
-                    // Seems like not all available space is used, so I guess we are ready..
-                    dataFrame[0] = FINISHING_FRAME | (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
+                if (final == true) {
+                    dataFrame[0] = FINISHING_FRAME | compressed | (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
                     _progressInfo &= (~0x40);
                 } else {
                     // There is more to come, this is just part of a bigger picture
-                    dataFrame[0] = (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
+                    dataFrame[0] = compressed | (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
                     _progressInfo |= (0x40);
                 }
 
@@ -169,18 +536,14 @@ namespace Web {
                 // Just unscramble, what is left...
                 if ((_progressInfo & 0x20) == 0x20) {
                     // looks like we need to unscramble..
-                    uint8_t* source = dataFrame;
-
                     if (_pendingReceiveBytes < receivedSize) {
                         receivedSize = _pendingReceiveBytes;
                     }
 
-                    for (uint16_t tmp = receivedSize; _pendingReceiveBytes != 0 && tmp != 0; --tmp) {
-                        *source = (*source ^ _scrambleKey[(_progressInfo & 0x3)]);
-                        source++;
-                        _progressInfo = ((_progressInfo + 1) & 0x03) | (_progressInfo & 0xFC);
-                        _pendingReceiveBytes--;
-                    }
+                    Mask(dataFrame, receivedSize, _scrambleKey, (_progressInfo & 0x03));
+
+                    _progressInfo = ((_progressInfo + receivedSize) & 0x03) | (_progressInfo & 0xFC);
+                    _pendingReceiveBytes -= receivedSize;
                 } else {
                     if (_pendingReceiveBytes > receivedSize) {
                         _pendingReceiveBytes -= receivedSize;
@@ -206,6 +569,18 @@ namespace Web {
                 } else {
                     _frameType = static_cast<frameType>(dataFrame[0] & TYPE_FRAME);
 
+                    // The first frame of a data message tells if the message is compressed.
+                    if ((_frameType == TEXT) || (_frameType == BINARY)) {
+                        if ((dataFrame[0] & COMPRESSED_FRAME) == 0) {
+                            _progressInfo &= (~0x10);
+                        } else if (IsCompressed() == true) {
+                            _progressInfo |= 0x10;
+                        } else {
+                            // Compressed, without having agreed on it..
+                            _frameType = VIOLATION;
+                        }
+                    }
+
                     // Continuation frame is only allowed if a receive is in progress...
                     if (ReceiveInProgress() == true) {
                         if (_frameType == 0) {
@@ -260,14 +635,9 @@ namespace Web {
                             _progressInfo |= 0x20;
                             _progressInfo &= (~0x03);
 
-                            uint8_t* source = &dataFrame[actualHeader];
+                            Mask(&dataFrame[actualHeader], bytesToMove, _scrambleKey, 0);
 
-                            while (bytesToMove != 0) {
-                                *source = (*source ^ _scrambleKey[(_progressInfo & 0x3)]);
-                                source++;
-                                bytesToMove--;
-                                _progressInfo = ((_progressInfo + 1) & 0xF3);
-                            }
+                            _progressInfo |= (bytesToMove & 0x03);
                         }
                     }
                 }
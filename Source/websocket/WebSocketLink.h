@@ -49,6 +49,19 @@ namespace Web {
                 CLOSE_INPROGRESS = 0x08
             };
 
+            // permessage-deflate (RFC 7692) administration.
+            enum compressionTypes {
+                DEFLATE_ENABLED = 0x0001, // Offer/accept permessage-deflate on the upgrade
+                DEFLATE_TAKEOVER = 0x0002, // Allow the compression context to be kept between messages
+                DEFLATE_ACTIVE = 0x0004, // Negotiated, data messages are compressed
+                DEFLATE_RESET = 0x0008, // Outbound messages start with a clean context
+                INFLATE_RESET = 0x0010, // Inbound messages start with a clean context
+                DEFLATE_MESSAGE = 0x0020, // Outbound message is being compressed
+                DEFLATE_FLUSH = 0x0040, // Outbound message is complete, flush it out
+                INFLATE_FINAL = 0x0080, // Inbound message is complete, the tail still has to go in
+                INFLATE_PENDING = 0x0100 // Inflated more than fitted, more output to come
+            };
+
             Protocol() = delete;
             Protocol(const Protocol&) = delete;
             Protocol& operator=(const Protocol&) = delete;
@@ -60,10 +73,17 @@ namespace Web {
                 , _pendingReceiveBytes(0)
                 , _frameType(TEXT)
                 , _controlStatus(0)
+                , _compression(0)
+                , _deflater()
+                , _inflater()
+                , _carried(0)
+                , _staging()
+                , _inflated()
             {
             }
             ~Protocol()
             {
+                CompressionEnd();
             }
 
         public:
@@ -119,9 +139,78 @@ namespace Web {
                 return ((_setFlags & 0x80) != 0);
             }
 
-            uint16_t Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize);
+            // Use permessage-deflate, if the other side agrees on it during the upgrade. Without context
+            // takeover, each message is compressed on its own, at the expense of the compression ratio.
+            inline void Compression(const bool enabled, const bool contextTakeover)
+            {
+                _compression = (enabled ? DEFLATE_ENABLED : 0) | (contextTakeover ? DEFLATE_TAKEOVER : 0);
+            }
+            inline bool IsCompressed() const
+            {
+                return ((_compression & DEFLATE_ACTIVE) != 0);
+            }
+            inline bool IsCompressedMessage() const
+            {
+                return ((_progressInfo & 0x10) != 0);
+            }
+
+            // Client side, the Sec-WebSocket-Extensions to offer and the evaluation of the servers answer.
+            string CompressionOffer() const;
+            bool CompressionAccepted(const string& response);
+
+            // Server side, pick the offer we can live with and fill in the answer to it.
+            bool CompressionOffered(const string& offers, string& response);
+
+            // Outbound compression. If the compressor IsStaging(), the next bit of the message is to be
+            // written to Staging() and reported by Staged(). Deflate() produces the frame payload.
+            inline bool IsStaging() const
+            {
+                return (((_compression & DEFLATE_FLUSH) == 0) && (_deflater.avail_in == 0));
+            }
+            inline uint8_t* Staging(const uint16_t size)
+            {
+                if (_staging.size() < size) {
+                    _staging.resize(size);
+                }
+                return (_staging.data());
+            }
+            void Staged(const uint16_t length, const bool final);
+            uint16_t Deflate(uint8_t frame[], const uint16_t maxSize, bool& final);
+
+            // Inbound compression. Hand over the frame payload and collect the inflated message data
+            // until nothing is left.
+            void Inflate(uint8_t frame[], const uint16_t length, const bool final);
+            uint16_t Inflated(uint8_t*& data);
+
+            // The Encoder expects the payload to be loaded at HeaderSize(), the room for the largest header
+            // it might write, so frames carrying more than 125 bytes are never moved.
+            inline uint8_t HeaderSize() const
+            {
+                return (Masking() == true ? 8 : 4);
+            }
+            inline uint16_t Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize)
+            {
+                // Seems like not all available space is used, so I guess we are ready..
+                return (Encoder(dataFrame, maxSendSize, usedSize, (usedSize < maxSendSize)));
+            }
+            uint16_t Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize, const bool final);
             uint16_t Decoder(uint8_t* dataFrame, uint16_t& receivedSize);
 
+            // XOR the data with the masking key, starting at key byte offset (0-3). Masking is its own inverse.
+            static void Mask(uint8_t data[], const uint32_t length, const uint8_t key[4], const uint8_t offset);
+
+        private:
+            bool CompressionParameters(const string& extension, const bool server, uint8_t& deflateBits);
+            bool CompressionBegin(const uint8_t deflateBits);
+            void CompressionEnd()
+            {
+                if ((_compression & DEFLATE_ACTIVE) != 0) {
+                    deflateEnd(&_deflater);
+                    inflateEnd(&_inflater);
+                    _compression &= (DEFLATE_ENABLED | DEFLATE_TAKEOVER);
+                }
+            }
+
         private:
             uint8_t _setFlags;
             uint8_t _progressInfo;
@@ -129,6 +218,13 @@ namespace Web {
             frameType _frameType;
             uint8_t _scrambleKey[4];
             uint8_t _controlStatus;
+            uint16_t _compression;
+            z_stream _deflater;
+            z_stream _inflater;
+            uint8_t _carry[4];
+            uint8_t _carried;
+            std::vector<uint8_t> _staging;
+            std::vector<uint8_t> _inflated;
         };
 
         class EXTERNAL RequestAllocator : public Core::ProxyPoolType<Web::Request> {
@@ -237,6 +333,10 @@ namespace Web {
                 {
                     return (OUTBOUND::Serializer::Serialize(stream, maxLength));
                 }
+                inline uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, Core::SocketPort::Reference& reference)
+                {
+                    return (OUTBOUND::Serializer::Serialize(stream, maxLength, reference));
+                }
                 void Flush()
                 {
                     _adminLock.Lock();
@@ -382,6 +482,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1, typename Arg2>
@@ -399,6 +501,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3>
@@ -416,6 +520,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4>
@@ -433,6 +539,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5>
@@ -450,6 +558,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6>
@@ -467,6 +577,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7>
@@ -484,6 +596,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1>
@@ -501,6 +615,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1, typename Arg2>
@@ -518,6 +634,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3>
@@ -535,6 +653,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4>
@@ -552,6 +672,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5>
@@ -569,6 +691,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7>
@@ -586,6 +710,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7>
@@ -603,6 +729,8 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _contentCompression(~0)
+                , _encodings()
             {
             }
 #ifdef __WINDOWS__
@@ -670,6 +798,22 @@ namespace Web {
             {
                 _handler.Masking(masking);
             }
+            inline void ContentCompression(const uint32_t threshold)
+            {
+                _contentCompression = threshold;
+            }
+            inline void MessageCompression(const bool enabled, const bool contextTakeover)
+            {
+                _adminLock.Lock();
+
+                _handler.Compression(enabled, contextTakeover);
+
+                _adminLock.Unlock();
+            }
+            inline bool IsCompressed() const
+            {
+                return (_handler.IsCompressed());
+            }
             inline void Ping()
             {
                 _pingFireTime = Core::Time::Now().Ticks();
@@ -706,6 +850,8 @@ namespace Web {
             }
             inline void Submit(const Core::ProxyType<OUTBOUND>& element)
             {
+                Compress(element, TemplateIntToType<Core::TypeTraits::same_or_inherits<Web::Request, INBOUND>::value>());
+
                 _adminLock.Lock();
 
                 if ((IsSuspended() == false) && (IsOpen() == true) && (_serializerImpl.Submit(element) == true)) {
@@ -743,29 +889,11 @@ namespace Web {
             // Methods to extract and insert data into the socket buffers
             virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
             {
-                uint16_t result = 0;
-
-                _adminLock.Lock();
-
-                _state = static_cast<EnumlinkState>(_state | ACTIVITY);
-
-                if ((_state & WEBSOCKET) != 0) {
-                    if (maxSendSize > 4) {
-                        result = _parent.SendData(&(dataFrame[4]), (maxSendSize - 4));
-
-                        result = _handler.Encoder(dataFrame, (maxSendSize - 4), result);
-                    }
-                } else {
-                    result = _serializerImpl.Serialize(dataFrame, maxSendSize);
-                }
-
-                _adminLock.Unlock();
-
-                if (result == 0) {
-                    CheckForClose(0);
-                }
-
-                return (result);
+                return (SendData(dataFrame, maxSendSize, nullptr));
+            }
+            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize, Core::SocketPort::Reference& reference)
+            {
+                return (SendData(dataFrame, maxSendSize, &reference));
             }
             virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
             {
@@ -826,6 +954,17 @@ namespace Web {
                                 }
 
                                 result += headerSize; // actualDataSize
+                            } else if (_handler.IsCompressedMessage() == true) {
+                                uint8_t* inflated;
+                                uint16_t length;
+
+                                _handler.Inflate(&(dataFrame[result + headerSize]), actualDataSize, ((_handler.IsCompleteMessage() == true) && (_handler.ReceiveInProgress() == false)));
+
+                                while ((length = _handler.Inflated(inflated)) != 0) {
+                                    _parent.ReceiveData(inflated, length);
+                                }
+
+                                result += (headerSize + actualDataSize);
                             } else {
                                 _parent.ReceiveData(&(dataFrame[result + headerSize]), actualDataSize);
 
@@ -872,6 +1011,58 @@ namespace Web {
             }
 
         private:
+            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize, Core::SocketPort::Reference* reference)
+            {
+                uint16_t result = 0;
+
+                _adminLock.Lock();
+
+                _state = static_cast<EnumlinkState>(_state | ACTIVITY);
+
+                if ((_state & WEBSOCKET) != 0) {
+                    const uint8_t header = _handler.HeaderSize();
+
+                    if (maxSendSize > header) {
+                        const uint16_t room = (maxSendSize - header);
+
+                        if (_handler.IsCompressed() == false) {
+                            result = _parent.SendData(&(dataFrame[header]), room);
+
+                            result = _handler.Encoder(dataFrame, room, result);
+                        } else {
+                            uint16_t loaded = room;
+                            bool final = false;
+
+                            // Compression might swallow a full buffer without producing anything yet,
+                            // keep on feeding it as long as the application has more.
+                            do {
+                                if (_handler.IsStaging() == true) {
+                                    loaded = _parent.SendData(_handler.Staging(room), room);
+                                    _handler.Staged(loaded, (loaded < room));
+                                }
+
+                                result = _handler.Deflate(&(dataFrame[header]), room, final);
+
+                            } while ((result == 0) && (final == false) && (loaded == room) && (_handler.IsStaging() == true));
+
+                            result = _handler.Encoder(dataFrame, room, result, final);
+                        }
+                    }
+                } else if (reference != nullptr) {
+                    // Plain HTTP, a body held in memory need not be copied..
+                    result = _serializerImpl.Serialize(dataFrame, maxSendSize, *reference);
+                } else {
+                    result = _serializerImpl.Serialize(dataFrame, maxSendSize);
+                }
+
+                _adminLock.Unlock();
+
+                if ((result == 0) && ((reference == nullptr) || (reference->Length == 0))) {
+                    CheckForClose(0);
+                }
+
+                return (result);
+            }
             inline uint32_t CheckForClose(uint32_t waitTime)
             {
                 uint32_t result = 0;
@@ -965,6 +1156,14 @@ namespace Web {
                             if (_protocol.empty() == false) {
                                 _webSocketMessage->WebSocketProtocol = _protocol;
                             }
+
+                            string extension;
+
+                            if ((element->WebSocketExtensions.IsSet() == true) && (_handler.CompressionOffered(element->WebSocketExtensions.Value(), extension) == true)) {
+                                _webSocketMessage->WebSocketExtensions = extension;
+                            } else {
+                                _webSocketMessage->WebSocketExtensions.Clear();
+                            }
                         }
                     }
 
@@ -975,9 +1174,34 @@ namespace Web {
 
                     ACTUALLINK::Trigger();
                 } else {
+                    if (_contentCompression != static_cast<uint32_t>(~0)) {
+                        // Responses go out in the order of the requests, remember what this one accepts.
+                        _adminLock.Lock();
+                        _encodings.push_back(element->AcceptEncoding.IsSet() == true ? element->AcceptEncoding.Value() : Web::ENCODING_UNKNOWN);
+                        _adminLock.Unlock();
+                    }
+
                     _parent.Received(element);
                 }
             }
+            inline void Compress(const Core::ProxyType<OUTBOUND>& element, const TemplateIntToType<1>& /* For compile time diffrentiation */)
+            {
+                if (_contentCompression != static_cast<uint32_t>(~0)) {
+                    Web::EncodingTypes encoding = Web::ENCODING_UNKNOWN;
+
+                    _adminLock.Lock();
+
+                    if (_encodings.empty() == false) {
+                        encoding = _encodings.front();
+                        _encodings.pop_front();
+                    }
+
+                    _adminLock.Unlock();
+
+                    // On the thread submitting the response, so the reactor does not have to.
+                    element->Compress(encoding, _contentCompression);
+                }
+            }
             inline void UpgradeCompleted(const TemplateIntToType<1>& /* For compile time diffrentiation */)
             {
                 // We send back the response on what we upgraded, Assuming it was succesfull, we are upgraded.
@@ -1027,6 +1251,12 @@ namespace Web {
                         _webSocketMessage->WebSocketProtocol = protocol;
                     }
 
+                    string offer(_handler.CompressionOffer());
+
+                    if (offer.empty() == false) {
+                        _webSocketMessage->WebSocketExtensions = offer;
+                    }
+
                     _query = query;
                     _path = path;
                     _protocol = protocol;
@@ -1039,6 +1269,10 @@ namespace Web {
 
                 return (result);
             }
+            inline void Compress(const Core::ProxyType<OUTBOUND>& /* element */, const TemplateIntToType<0>& /* For compile time diffrentiation */)
+            {
+                // Requests are sent as they are.
+            }
             inline void UpgradeCompleted(const TemplateIntToType<0>& /* For compile time diffrentiation */)
             {
                 // We send out the request to upgrade. So what wait for the answer...
@@ -1054,6 +1288,10 @@ namespace Web {
                     // Seems like we succeeded, turn on the link..
                     _state = static_cast<EnumlinkState>((_state & 0xF0) | WEBSOCKET);
 
+                    if (element->WebSocketExtensions.IsSet() == true) {
+                        _handler.CompressionAccepted(element->WebSocketExtensions.Value());
+                    }
+
                     _parent.StateChange();
 
                     _adminLock.Unlock();
@@ -1076,6 +1314,8 @@ namespace Web {
             string _commandData;
             Core::ProxyType<typename OUTBOUND::BaseElement> _webSocketMessage;
             uint64_t _pingFireTime;
+            uint32_t _contentCompression;
+            std::list<Web::EncodingTypes> _encodings;
         };
 
     public:
@@ -1222,6 +1462,21 @@ namespace Web {
         {
             return (_channel.Masking());
         }
+        // Compress HTTP responses with a body of threshold bytes or more, for requests that
+        // accept gzip or deflate. Should be set before the link is opened.
+        inline void ContentCompression(const uint32_t threshold)
+        {
+            _channel.ContentCompression(threshold);
+        }
+        // Negotiate permessage-deflate on the upgrade to a websocket.
+        inline void MessageCompression(const bool enabled, const bool contextTakeover = true)
+        {
+            _channel.MessageCompression(enabled, contextTakeover);
+        }
+        inline bool IsCompressed() const
+        {
+            return (_channel.IsCompressed());
+        }
         inline void ResetActivity()
         {
             return (_channel.ResetActivity());
@@ -1541,6 +1796,14 @@ namespace Web {
         {
             return (_channel.Masking());
         }
+        inline void MessageCompression(const bool enabled, const bool contextTakeover = true)
+        {
+            _channel.MessageCompression(enabled, contextTakeover);
+        }
+        inline bool IsCompressed() const
+        {
+            return (_channel.IsCompressed());
+        }
         inline uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
@@ -1779,6 +2042,14 @@ namespace Web {
         {
             return (_channel.Masking());
         }
+        inline void MessageCompression(const bool enabled, const bool contextTakeover = true)
+        {
+            _channel.MessageCompression(enabled, contextTakeover);
+        }
+        inline bool IsCompressed() const
+        {
+            return (_channel.IsCompressed());
+        }
         inline uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
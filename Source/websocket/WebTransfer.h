@@ -466,8 +466,21 @@ namespace Web {
                     string message = Authorize(*element);
 
                     if (message.empty() == true) {
-                        _CalculateHash<LINK, FILEBODY>(*_response);
-                        _response->Body(_fileBody);
+                        string contentRange;
+
+                        _response->AcceptRange = _T("bytes");
+
+                        if (element->Range.IsSet() == true) {
+                            _response->ErrorCode = _fileBody->Range(element->Range.Value(), contentRange);
+                        }
+
+                        if (contentRange.empty() == false) {
+                            _response->ContentRange = contentRange;
+                        }
+                        if (_response->ErrorCode != Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE) {
+                            _CalculateHash<LINK, FILEBODY>(*_response);
+                            _response->Body(_fileBody);
+                        }
                     } else {
                         // Somehow we are not Authorzed. Kill it....
                         _response->ErrorCode = Web::STATUS_UNAUTHORIZED;
@@ -0,0 +1,418 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <broadcast/broadcast.h>
+#include <broadcast/ProgramTable.h>
+#include <core/core.h>
+
+using namespace WPEFramework;
+
+namespace {
+
+typedef std::vector<uint8_t> Bytes;
+
+// Keeps a copy of every section offered.
+class Sections : public Broadcast::ISection {
+public:
+    Sections(const Sections&) = delete;
+    Sections& operator=(const Sections&) = delete;
+
+    Sections() = default;
+    ~Sections() override = default;
+
+public:
+    void Handle(const Broadcast::MPEG::Section& section) override
+    {
+        Bytes copy(section.Length());
+
+        for (uint16_t index = 0; index < section.Length(); index++) {
+            copy[index] = section.GetNumber<uint8_t>(index);
+        }
+
+        Received.push_back(copy);
+    }
+
+    std::vector<Bytes> Received;
+};
+
+// Synthetic transport stream, with the MPEG-2 CRC calculated bit by bit so it does not
+// depend on the table driven one under test.
+class Stream {
+public:
+    Stream(const Stream&) = delete;
+    Stream& operator=(const Stream&) = delete;
+
+    Stream()
+        : _data()
+        , _continuity()
+    {
+    }
+
+public:
+    static uint32_t CRC(const uint8_t data[], const uint32_t length)
+    {
+        uint32_t crc = 0xFFFFFFFF;
+
+        for (uint32_t index = 0; index < length; index++) {
+            crc ^= static_cast<uint32_t>(data[index]) << 24;
+
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                crc = ((crc & 0x80000000) != 0 ? ((crc << 1) ^ 0x04C11DB7) : (crc << 1));
+            }
+        }
+
+        return (crc);
+    }
+    // A long form section with the given body, or a body of some pattern of this size.
+    static Bytes Section(const uint8_t tableId, const uint16_t extension, const uint8_t version, const Bytes& body)
+    {
+        const uint16_t length = static_cast<uint16_t>(5 + body.size() + 4);
+        Bytes section(3 + length);
+
+        section[0] = tableId;
+        section[1] = 0xB0 | (length >> 8);
+        section[2] = length & 0xFF;
+        section[3] = extension >> 8;
+        section[4] = extension & 0xFF;
+        section[5] = 0xC1 | ((version & 0x1F) << 1);
+        section[6] = 0;
+        section[7] = 0;
+        std::copy(body.begin(), body.end(), section.begin() + 8);
+
+        const uint32_t crc = CRC(section.data(), static_cast<uint32_t>(section.size() - 4));
+
+        section[section.size() - 4] = (crc >> 24) & 0xFF;
+        section[section.size() - 3] = (crc >> 16) & 0xFF;
+        section[section.size() - 2] = (crc >> 8) & 0xFF;
+        section[section.size() - 1] = crc & 0xFF;
+
+        return (section);
+    }
+    static Bytes Section(const uint8_t tableId, const uint16_t extension, const uint8_t version, const uint16_t size)
+    {
+        Bytes body(size);
+
+        for (uint16_t index = 0; index < size; index++) {
+            body[index] = static_cast<uint8_t>(index * 7);
+        }
+
+        return (Section(tableId, extension, version, body));
+    }
+
+    // Packetize these sections back to back on the PID, stuffing the last packet.
+    void Add(const uint16_t pid, const std::vector<Bytes>& sections)
+    {
+        Bytes payload;
+
+        for (const Bytes& section : sections) {
+            payload.insert(payload.end(), section.begin(), section.end());
+        }
+
+        uint32_t position = 0;
+
+        while (position < payload.size()) {
+            uint8_t packet[188];
+            uint8_t offset = 4;
+
+            ::memset(packet, 0xFF, sizeof(packet));
+
+            packet[0] = 0x47;
+            packet[1] = (position == 0 ? 0x40 : 0x00) | (pid >> 8);
+            packet[2] = pid & 0xFF;
+            packet[3] = 0x10 | Next(pid);
+
+            if (position == 0) {
+                packet[offset++] = 0; // pointer_field
+            }
+
+            const uint32_t size = std::min(static_cast<uint32_t>(payload.size() - position), static_cast<uint32_t>(sizeof(packet) - offset));
+
+            ::memcpy(&(packet[offset]), &(payload[position]), size);
+            position += size;
+
+            _data.insert(_data.end(), packet, packet + sizeof(packet));
+        }
+    }
+    // A packet with an adaptation field of the given length in front of the payload.
+    void Adaptation(const uint16_t pid, const uint8_t length, const Bytes& section)
+    {
+        uint8_t packet[188];
+        uint8_t offset = 4;
+
+        ::memset(packet, 0xFF, sizeof(packet));
+
+        packet[0] = 0x47;
+        packet[1] = 0x40 | (pid >> 8);
+        packet[2] = pid & 0xFF;
+        packet[3] = 0x30 | Next(pid);
+        packet[offset++] = length;
+
+        if (length > 0) {
+            packet[offset] = 0x00; // no flags, the rest is stuffing
+        }
+
+        if ((offset + length + 1 + section.size()) <= sizeof(packet)) {
+            offset += length;
+            packet[offset++] = 0; // pointer_field
+            ::memcpy(&(packet[offset]), section.data(), section.size());
+        } else {
+            // Too long a field, put the section where an 8 bit offset that wrapped around finds it.
+            const uint8_t wrapped = static_cast<uint8_t>(offset + length);
+
+            if ((wrapped < sizeof(packet)) && ((wrapped + 1 + packet[wrapped] + section.size()) <= sizeof(packet))) {
+                ::memcpy(&(packet[wrapped + 1 + packet[wrapped]]), section.data(), section.size());
+            }
+        }
+
+        _data.insert(_data.end(), packet, packet + sizeof(packet));
+    }
+    inline const Bytes& Data() const
+    {
+        return (_data);
+    }
+    inline uint32_t Packets() const
+    {
+        return (static_cast<uint32_t>(_data.size() / 188));
+    }
+    // Repeat or remove the packet at this index.
+    void Duplicate(const uint32_t packet)
+    {
+        const Bytes copy(_data.begin() + (packet * 188), _data.begin() + ((packet + 1) * 188));
+
+        _data.insert(_data.begin() + ((packet + 1) * 188), copy.begin(), copy.end());
+    }
+    void Remove(const uint32_t packet)
+    {
+        _data.erase(_data.begin() + (packet * 188), _data.begin() + ((packet + 1) * 188));
+    }
+    // Put bytes that are no packet in front of the packet at this index.
+    void Insert(const uint32_t packet, const Bytes& bytes)
+    {
+        _data.insert(_data.begin() + (packet * 188), bytes.begin(), bytes.end());
+    }
+
+private:
+    uint8_t Next(const uint16_t pid)
+    {
+        return (_continuity[pid]++ & 0x0F);
+    }
+
+private:
+    Bytes _data;
+    std::map<uint16_t, uint8_t> _continuity;
+};
+
+}
+
+TEST(Broadcast_Demux, Reassembly)
+{
+    const Bytes small(Stream::Section(0x42, 1, 1, 10));
+    const Bytes large(Stream::Section(0x42, 2, 1, 500));
+    const Bytes other(Stream::Section(0x46, 3, 1, 20));
+
+    Stream stream;
+    stream.Add(0x11, { small, large, other });
+    stream.Add(0x11, { small });
+
+    Sections actual, others;
+    Broadcast::Demux demux;
+    demux.Filter(0x11, 0x42, &actual);
+    demux.Filter(0x11, 0x46, &others);
+
+    demux.Process(stream.Data().data(), static_cast<uint32_t>(stream.Data().size()));
+
+    // The second small one is a repetition of the same version.
+    ASSERT_EQ(actual.Received.size(), 2u);
+    EXPECT_EQ(actual.Received[0], small);
+    EXPECT_EQ(actual.Received[1], large);
+    ASSERT_EQ(others.Received.size(), 1u);
+    EXPECT_EQ(others.Received[0], other);
+
+    EXPECT_EQ(demux.Packets(), stream.Packets());
+    EXPECT_EQ(demux.Sections(), 3u);
+    EXPECT_EQ(demux.Errors(), 0u);
+}
+
+TEST(Broadcast_Demux, SplitPackets)
+{
+    const Bytes large(Stream::Section(0x42, 2, 1, 1000));
+
+    Stream stream;
+    stream.Add(0x11, { large });
+
+    // Every split of a packet over two calls, down to a byte at a time.
+    for (const uint32_t chunk : { 1u, 7u, 100u, 187u, 189u, 376u }) {
+        Sections actual;
+        Broadcast::Demux demux;
+        demux.Filter(0x11, 0x42, &actual);
+
+        for (uint32_t offset = 0; offset < stream.Data().size(); offset += chunk) {
+            demux.Process(&(stream.Data()[offset]), std::min(chunk, static_cast<uint32_t>(stream.Data().size() - offset)));
+        }
+
+        ASSERT_EQ(actual.Received.size(), 1u) << "chunks of " << chunk;
+        EXPECT_EQ(actual.Received[0], large);
+        EXPECT_EQ(demux.Packets(), stream.Packets());
+        EXPECT_EQ(demux.Errors(), 0u);
+    }
+}
+
+TEST(Broadcast_Demux, DuplicatePackets)
+{
+    const Bytes large(Stream::Section(0x42, 2, 1, 500));
+
+    Stream stream;
+    stream.Add(0x11, { large });
+    stream.Duplicate(1);
+
+    Sections actual;
+    Broadcast::Demux demux;
+    demux.Filter(0x11, 0x42, &actual);
+
+    demux.Process(stream.Data().data(), static_cast<uint32_t>(stream.Data().size()));
+
+    // A packet sent twice carries nothing new, and it is no error either.
+    ASSERT_EQ(actual.Received.size(), 1u);
+    EXPECT_EQ(actual.Received[0], large);
+    EXPECT_EQ(demux.Errors(), 0u);
+}
+
+TEST(Broadcast_Demux, ContinuityLoss)
+{
+    const Bytes large(Stream::Section(0x42, 2, 1, 500));
+    const Bytes small(Stream::Section(0x42, 3, 1, 10));
+
+    Stream stream;
+    stream.Add(0x11, { large });
+    stream.Remove(1);
+    stream.Add(0x11, { small });
+
+    Sections actual;
+    Broadcast::Demux demux;
+    demux.Filter(0x11, 0x42, &actual);
+
+    demux.Process(stream.Data().data(), static_cast<uint32_t>(stream.Data().size()));
+
+    // The section with a packet missing is dropped, the next one starts clean.
+    ASSERT_EQ(actual.Received.size(), 1u);
+    EXPECT_EQ(actual.Received[0], small);
+    EXPECT_EQ(demux.Errors(), 1u);
+}
+
+TEST(Broadcast_Demux, LostSync)
+{
+    const Bytes first(Stream::Section(0x42, 1, 1, 10));
+    const Bytes second(Stream::Section(0x42, 2, 1, 10));
+    Bytes garbage(50, 0x00);
+
+    // A sync byte without another one a packet further.
+    garbage[10] = 0x47;
+
+    Stream stream;
+    stream.Add(0x11, { first });
+    stream.Add(0x11, { second });
+    stream.Insert(1, garbage);
+
+    Sections actual;
+    Broadcast::Demux demux;
+    demux.Filter(0x11, 0x42, &actual);
+
+    demux.Process(stream.Data().data(), static_cast<uint32_t>(stream.Data().size()));
+
+    // Synchronized again on the packet after the garbage, not on the sync byte in it.
+    ASSERT_EQ(actual.Received.size(), 2u);
+    EXPECT_EQ(actual.Received[0], first);
+    EXPECT_EQ(actual.Received[1], second);
+    EXPECT_EQ(demux.Errors(), 1u);
+    EXPECT_EQ(demux.Packets(), 2u);
+}
+
+TEST(Broadcast_Demux, AdaptationField)
+{
+    const Bytes small(Stream::Section(0x42, 1, 1, 10));
+    const Bytes bogus(Stream::Section(0x42, 2, 1, 10));
+    const Bytes next(Stream::Section(0x42, 3, 1, 10));
+
+    Stream stream;
+    stream.Adaptation(0x11, 7, small);
+    // With a payload, more than 182 bytes of adaptation field run off the packet. At 251 an
+    // 8 bit offset wraps around to the sync byte, which then reads as a pointer_field.
+    stream.Adaptation(0x11, 183, bogus);
+    stream.Adaptation(0x11, 251, bogus);
+    stream.Adaptation(0x11, 182, Bytes());
+    stream.Adaptation(0x11, 0, next);
+
+    Sections actual;
+    Broadcast::Demux demux;
+    demux.Filter(0x11, 0x42, &actual);
+
+    demux.Process(stream.Data().data(), static_cast<uint32_t>(stream.Data().size()));
+
+    ASSERT_EQ(actual.Received.size(), 2u);
+    EXPECT_EQ(actual.Received[0], small);
+    EXPECT_EQ(actual.Received[1], next);
+    EXPECT_EQ(demux.Errors(), 2u);
+    EXPECT_EQ(demux.Packets(), 5u);
+}
+
+TEST(Broadcast_Demux, Repetitions)
+{
+    const Bytes small(Stream::Section(0x42, 1, 1, 10));
+
+    Stream stream;
+    stream.Add(0x11, { small });
+    stream.Add(0x11, { small });
+
+    Sections actual;
+    Broadcast::Demux demux(true);
+    demux.Filter(0x11, 0x42, &actual);
+
+    demux.Process(stream.Data().data(), static_cast<uint32_t>(stream.Data().size()));
+
+    EXPECT_EQ(actual.Received.size(), 2u);
+}
+
+TEST(Broadcast_Demux, Programs)
+{
+    // Program 1 has its PMT on PID 0x100, with one H.264 stream on PID 0x101.
+    const Bytes pat(Stream::Section(Broadcast::MPEG::PAT::ID, 0x1234, 1, Bytes({ 0x00, 0x01, 0xE1, 0x00 })));
+    const Bytes pmt(Stream::Section(Broadcast::MPEG::PMT::ID, 1, 1, Bytes({ 0xE1, 0x01, 0xF0, 0x00, 0x1B, 0xE1, 0x01, 0xF0, 0x00 })));
+
+    Stream stream;
+    stream.Add(0x000, { pat });
+    stream.Add(0x100, { pmt });
+
+    Broadcast::Demux demux;
+    EXPECT_EQ(demux.Programs(7), Core::ERROR_NONE);
+    EXPECT_EQ(demux.Programs(7), Core::ERROR_INPROGRESS);
+
+    demux.Process(stream.Data().data(), static_cast<uint32_t>(stream.Data().size()));
+
+    // The PAT leads to the PMT, after which the ProgramTable is done with this demux.
+    Broadcast::MPEG::PMT program;
+    EXPECT_TRUE(Broadcast::ProgramTable::Instance().Program(7, 1, program));
+    EXPECT_EQ(demux.Sections(), 2u);
+    EXPECT_EQ(demux.Errors(), 0u);
+    EXPECT_EQ(demux.Programs(7), Core::ERROR_NONE);
+
+    Broadcast::ProgramTable::Instance().Reset();
+    Core::Singleton::Dispose();
+}
@@ -0,0 +1,68 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+// Bitwise CRC-32/MPEG-2, the reference the table driven version should match.
+static uint32_t ReferenceCRC32(const uint8_t* data, const uint32_t length)
+{
+    uint32_t crc = 0xffffffff;
+
+    for (uint32_t index = 0; index < length; index++) {
+        crc ^= (static_cast<uint32_t>(data[index]) << 24);
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = ((crc & 0x80000000) != 0 ? ((crc << 1) ^ 0x04c11db7) : (crc << 1));
+        }
+    }
+
+    return (crc);
+}
+
+TEST(Core_DataElement, CRC32CheckValue)
+{
+    uint8_t text[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    Core::DataElement element(sizeof(text), text);
+
+    EXPECT_EQ(element.CRC32(0, sizeof(text)), 0x0376e6e7u);
+    EXPECT_EQ(element.CRC32(0, 0), 0xffffffffu);
+}
+
+TEST(Core_DataElement, CRC32AllLengthsAndOffsets)
+{
+    uint8_t buffer[67];
+
+    for (uint8_t index = 0; index < sizeof(buffer); index++) {
+        buffer[index] = static_cast<uint8_t>((index * 131) + 7);
+    }
+
+    Core::DataElement element(sizeof(buffer), buffer);
+
+    for (uint32_t offset = 0; offset < 9; offset++) {
+        for (uint32_t length = 0; (offset + length) <= sizeof(buffer); length++) {
+            EXPECT_EQ(element.CRC32(offset, length), ReferenceCRC32(&(buffer[offset]), length));
+        }
+    }
+}
+
+} // Tests
+} // WPEFramework
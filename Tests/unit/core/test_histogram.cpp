@@ -0,0 +1,114 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+TEST(Core_Histogram, Empty)
+{
+    Core::HistogramType<> histogram;
+
+    EXPECT_EQ(histogram.Measurements(), 0u);
+    EXPECT_EQ(histogram.Max(), 0u);
+    EXPECT_EQ(histogram.Percentile(50), 0u);
+    EXPECT_EQ(histogram.Percentile(99), 0u);
+}
+
+TEST(Core_Histogram, SmallValuesAreExact)
+{
+    Core::HistogramType<4> histogram;
+
+    for (uint32_t value = 0; value < 16; value++) {
+        histogram.Set(value);
+    }
+
+    EXPECT_EQ(histogram.Measurements(), 16u);
+    EXPECT_EQ(histogram.Percentile(50), 7u);
+    EXPECT_EQ(histogram.Percentile(100), 15u);
+    EXPECT_EQ(histogram.Max(), 15u);
+}
+
+TEST(Core_Histogram, PercentilesWithinPrecision)
+{
+    Core::HistogramType<4> histogram;
+
+    for (uint32_t value = 1; value <= 10000; value++) {
+        histogram.Set(value);
+    }
+
+    const uint8_t percentiles[] = { 50, 90, 99 };
+
+    for (const uint8_t percentile : percentiles) {
+        const uint32_t expected = 100 * percentile;
+        const uint32_t reported = histogram.Percentile(percentile);
+
+        // Reported is the top of the bucket, so never below, and at most 1/16 above.
+        EXPECT_GE(reported, expected);
+        EXPECT_LE(reported, expected + (expected / 16));
+    }
+
+    EXPECT_EQ(histogram.Percentile(100), 10000u);
+    EXPECT_EQ(histogram.Max(), 10000u);
+}
+
+TEST(Core_Histogram, FullRange)
+{
+    Core::HistogramType<> histogram;
+
+    histogram.Set(0);
+    histogram.Set(~static_cast<uint32_t>(0));
+
+    EXPECT_EQ(histogram.Percentile(50), 0u);
+    EXPECT_EQ(histogram.Percentile(100), ~static_cast<uint32_t>(0));
+    EXPECT_EQ(histogram.Max(), ~static_cast<uint32_t>(0));
+
+    histogram.Reset();
+
+    EXPECT_EQ(histogram.Measurements(), 0u);
+    EXPECT_EQ(histogram.Max(), 0u);
+}
+
+TEST(Core_Histogram, ConcurrentRecording)
+{
+    Core::HistogramType<> histogram;
+    std::vector<std::thread> threads;
+
+    for (uint32_t thread = 0; thread < 4; thread++) {
+        threads.emplace_back([&histogram, thread]() {
+            for (uint32_t value = 0; value < 10000; value++) {
+                histogram.Set(value + thread);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(histogram.Measurements(), 40000u);
+    EXPECT_EQ(histogram.Max(), 10002u);
+}
+
+} // Tests
+} // WPEFramework
@@ -67,5 +67,97 @@ namespace Tests {
         }
         testAdmin.Sync("done testing");
     }
+
+    namespace {
+
+        typedef Core::IPCMessageType<7, Core::IPC::ScalarType<uint32_t>, Core::IPC::ScalarType<uint32_t>> SequenceMessage;
+
+        // Frames messages into a buffer and reads them back, as the two sides of a channel would.
+        class SequenceFrames : public Core::IMessage::Serializer, public Core::IMessage::Deserializer, public Core::IDispatchType<Core::IIPC> {
+        public:
+            SequenceFrames() = delete;
+            SequenceFrames(const SequenceFrames&) = delete;
+            SequenceFrames& operator=(const SequenceFrames&) = delete;
+
+            SequenceFrames(Core::IPCChannel::IPCFactory& administration)
+                : _administration(administration)
+                , _element()
+                , _dispatched(0)
+            {
+            }
+            ~SequenceFrames() override = default;
+
+        public:
+            uint32_t Dispatched() const
+            {
+                return (_dispatched);
+            }
+            // Send the response to the outbound message back, as if it came from the other side.
+            bool Respond(const Core::ProxyType<Core::IIPC>& outbound)
+            {
+                uint8_t buffer[64];
+
+                Submit(*(outbound->IResponse()));
+
+                uint16_t length = Serialize(buffer, sizeof(buffer));
+
+                return ((Deserialize(buffer, length) == length) && (_element.IsValid() == false));
+            }
+
+        private:
+            void Serialized(const Core::IMessage&) override
+            {
+            }
+            Core::IMessage* Element(const uint32_t& label, const uint32_t sequence) override
+            {
+                _element = _administration.Element(label, sequence);
+
+                return (_element.IsValid() == true ? &(*_element) : nullptr);
+            }
+            void Deserialized(Core::IMessage&) override
+            {
+                Core::ProxyType<Core::IIPC> inbound;
+
+                _administration.ReceivedMessage(_element, inbound);
+                _element.Release();
+            }
+            void Dispatch(Core::IIPC&) override
+            {
+                _dispatched++;
+            }
+
+        private:
+            Core::IPCChannel::IPCFactory& _administration;
+            Core::ProxyType<Core::IMessage> _element;
+            uint32_t _dispatched;
+        };
+    }
+
+    TEST(Core_IPC, SequenceWrap)
+    {
+        Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t> > factory(Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t> >::Create());
+        Core::IPCChannel::IPCFactory administration(factory, 0x1FFFFFFE);
+        SequenceFrames frames(administration);
+
+        Core::ProxyType<Core::IIPC> last(Core::ProxyType<SequenceMessage>::Create());
+        Core::ProxyType<Core::IIPC> wrapped(Core::ProxyType<SequenceMessage>::Create());
+
+        // The highest sequence that fits in a frame.
+        EXPECT_TRUE(administration.SetOutbound(last, &frames));
+        EXPECT_EQ(last->Sequence(), 0x1FFFFFFFu);
+        EXPECT_TRUE(frames.Respond(last));
+        EXPECT_EQ(frames.Dispatched(), 1u);
+
+        // The next one wraps, skipping 0.
+        EXPECT_TRUE(administration.SetOutbound(wrapped, &frames));
+        EXPECT_EQ(wrapped->Sequence(), 1u);
+        EXPECT_TRUE(frames.Respond(wrapped));
+        EXPECT_EQ(frames.Dispatched(), 2u);
+
+        EXPECT_FALSE(administration.InProgress());
+
+        factory->DestroyFactories();
+        Core::Singleton::Dispose();
+    }
 } // Tests
 } // WPEFramework
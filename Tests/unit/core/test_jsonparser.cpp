@@ -768,6 +768,467 @@ namespace Tests {
         ExecutePrimitiveJsonTest<Core::JSON::EnumType<JSONTestEnum>>(data, false, nullptr);
     }
 
+    class EventJson : public Core::JSON::Container {
+    public:
+        EventJson()
+            : Core::JSON::Container()
+        {
+            Init();
+        }
+        EventJson(const EventJson& copy)
+            : Core::JSON::Container()
+            , Id(copy.Id)
+            , Title(copy.Title)
+            , Description(copy.Description)
+            , Starttime(copy.Starttime)
+        {
+            Init();
+        }
+        EventJson& operator=(const EventJson& rhs)
+        {
+            Id = rhs.Id;
+            Title = rhs.Title;
+            Description = rhs.Description;
+            Starttime = rhs.Starttime;
+            return (*this);
+        }
+
+    private:
+        void Init()
+        {
+            Add(_T("id"), &Id);
+            Add(_T("title"), &Title);
+            Add(_T("description"), &Description);
+            Add(_T("starttime"), &Starttime);
+        }
+
+    public:
+        Core::JSON::DecUInt32 Id;
+        Core::JSON::String Title;
+        Core::JSON::String Description;
+        Core::JSON::DecUInt64 Starttime;
+    };
+
+    static void FillEvents(Core::JSON::ArrayType<EventJson>& events, const uint32_t count)
+    {
+        for (uint32_t index = 0; index < count; index++) {
+            EventJson& event(events.Add());
+            event.Id = index;
+            event.Title = _T("Event ") + Core::NumberType<uint32_t>(index).Text();
+            event.Description = string(80 + (index % 40), 'a' + (index % 26));
+            event.Starttime = 1600000000ULL + (index * 1800);
+        }
+    }
+
+    // The way ToString used to do it: a fixed stack buffer, resuming the serialization per chunk.
+    static bool ChunkedToString(const Core::JSON::IElement& element, string& text)
+    {
+        char buffer[1024];
+        uint32_t loaded;
+        uint32_t offset = 0;
+
+        text.clear();
+
+        do {
+            loaded = element.Serialize(buffer, sizeof(buffer), offset);
+            text += string(buffer, loaded);
+        } while ((offset != 0) && (loaded == sizeof(buffer)));
+
+        return (offset == 0);
+    }
+
+    TEST(JSONParser, LargeDocument)
+    {
+        Core::JSON::ArrayType<EventJson> events;
+        FillEvents(events, 2000);
+
+        string direct, chunked;
+        EXPECT_TRUE(events.ToString(direct));
+        EXPECT_TRUE(ChunkedToString(events, chunked));
+        EXPECT_GT(direct.length(), 0x10000u);
+        EXPECT_EQ(direct, chunked);
+
+        Core::JSON::ArrayType<EventJson> parsed;
+        EXPECT_TRUE(parsed.FromString(direct));
+        ASSERT_EQ(parsed.Length(), 2000u);
+        EXPECT_EQ(parsed[1999].Id.Value(), 1999u);
+        EXPECT_EQ(parsed[1999].Description.Value(), events[1999].Description.Value());
+
+        string again;
+        EXPECT_TRUE(parsed.ToString(again));
+        EXPECT_EQ(again, direct);
+    }
+
+    TEST(JSONParser, LargeMessagePack)
+    {
+        Core::JSON::String text;
+        text = string(100000, 'x');
+
+        std::vector<uint8_t> stream;
+        EXPECT_TRUE(text.IMessagePack::ToBuffer(stream));
+        ASSERT_EQ(stream.size(), 100005u);
+        EXPECT_EQ(stream[0], 0xDB);
+
+        Core::JSON::String parsed;
+        EXPECT_TRUE(parsed.IMessagePack::FromBuffer(stream));
+        EXPECT_EQ(parsed.Value(), text.Value());
+    }
+
+    // Not so much a test, but a micro benchmark of the direct ToString against the
+    // chunked serialization it replaced.
+    TEST(JSONParser, SerializeBenchmark)
+    {
+        for (uint32_t count : { 10, 1000, 20000 }) {
+            Core::JSON::ArrayType<EventJson> events;
+            FillEvents(events, count);
+
+            const uint32_t rounds = (200000 / count) + 1;
+            string direct, chunked;
+
+            uint64_t start = Core::Time::Now().Ticks();
+            for (uint32_t round = 0; round < rounds; round++) {
+                ChunkedToString(events, chunked);
+            }
+            uint64_t middle = Core::Time::Now().Ticks();
+            for (uint32_t round = 0; round < rounds; round++) {
+                events.ToString(direct);
+            }
+            uint64_t end = Core::Time::Now().Ticks();
+
+            EXPECT_EQ(direct, chunked);
+            printf("%6u events (%8u bytes) x %5u: chunked %8u us, direct %8u us\n", count, static_cast<uint32_t>(direct.length()), rounds,
+                static_cast<uint32_t>(middle - start), static_cast<uint32_t>(end - middle));
+        }
+    }
+
+    TEST(JSONParser, ScannerPlain)
+    {
+        string text(200, 'a');
+
+        EXPECT_EQ(Core::JSON::Scanner::Plain(text.data(), text.data() + text.length()), text.data() + text.length());
+
+        for (uint32_t position : { 0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 150, 199 }) {
+            for (char special : { '\"', '\\' }) {
+                string probe(text);
+                probe[position] = special;
+                const char* begin = probe.data();
+                const char* end = begin + probe.length();
+
+                EXPECT_EQ(Core::JSON::Scanner::Plain(begin, end), begin + position);
+                EXPECT_EQ(Core::JSON::Scanner::Plain(begin, end), Core::JSON::Scanner::PlainScalar(begin, end));
+                EXPECT_EQ(Core::JSON::Scanner::Plain(begin + position + 1, end), end);
+            }
+        }
+    }
+
+    TEST(JSONParser, LongStrings)
+    {
+        Core::JSON::String value;
+        string text = "\"" + string(100, 'x') + "\\\"" + string(40, 'y') + "\\n" + string(20, 'z') + "\"";
+
+        EXPECT_TRUE(value.FromString(text));
+        EXPECT_EQ(value.Value(), string(100, 'x') + "\"" + string(40, 'y') + "\n" + string(20, 'z'));
+
+        string serialized;
+        value = string(100, 'x') + "\"" + string(40, 'y');
+        EXPECT_TRUE(value.ToString(serialized));
+        EXPECT_EQ(serialized, "\"" + string(100, 'x') + "\\\"" + string(40, 'y') + "\"");
+    }
+
+    class BlobJson : public Core::JSON::Container {
+    public:
+        BlobJson(const BlobJson&) = delete;
+        BlobJson& operator=(const BlobJson&) = delete;
+
+        BlobJson()
+            : Core::JSON::Container()
+        {
+            Add(_T("key"), &Key);
+            Add(_T("url"), &Url);
+            Add(_T("config"), &Config);
+        }
+
+    public:
+        Core::JSON::String Key;
+        Core::JSON::String Url;
+        Core::JSON::String Config;
+    };
+
+    // Not so much a test, but a micro benchmark of the plain text scanning in strings, on its
+    // own and while parsing a document with long strings (keys, URLs and escaped config blobs).
+    TEST(JSONParser, ParseBenchmark)
+    {
+        string text;
+        for (uint32_t index = 0; index < 4096; index++) {
+            text += static_cast<char>('A' + (index % 26));
+        }
+
+        const uint32_t rounds = 20000;
+        uint64_t start = Core::Time::Now().Ticks();
+        uintptr_t sum = 0;
+        for (uint32_t round = 0; round < rounds; round++) {
+            sum += reinterpret_cast<uintptr_t>(Core::JSON::Scanner::PlainScalar(text.data() + (round & 7), text.data() + text.length()));
+        }
+        uint64_t middle = Core::Time::Now().Ticks();
+        for (uint32_t round = 0; round < rounds; round++) {
+            sum -= reinterpret_cast<uintptr_t>(Core::JSON::Scanner::Plain(text.data() + (round & 7), text.data() + text.length()));
+        }
+        uint64_t end = Core::Time::Now().Ticks();
+
+        EXPECT_EQ(sum, 0u);
+        printf("scan %u x 4KB: scalar %8u us, vectorized %8u us\n", rounds, static_cast<uint32_t>(middle - start), static_cast<uint32_t>(end - middle));
+
+        BlobJson blob;
+        blob.Key = text.substr(0, 2048);
+        blob.Url = _T("https://example.com/") + text.substr(0, 200) + _T("?query=") + text.substr(300, 100);
+        blob.Config = _T("{\"name\":\"") + text.substr(0, 1000) + _T("\",\"values\":[\"") + text.substr(1000, 1000) + _T("\"]}");
+
+        string document;
+        EXPECT_TRUE(blob.ToString(document));
+
+        start = Core::Time::Now().Ticks();
+        bool parsed = true;
+        for (uint32_t round = 0; round < (rounds / 4); round++) {
+            parsed = blob.FromString(document) && parsed;
+        }
+        end = Core::Time::Now().Ticks();
+
+        EXPECT_TRUE(parsed);
+        EXPECT_EQ(blob.Key.Value(), text.substr(0, 2048));
+        printf("parse %u x %u bytes: %8u us\n", rounds / 4, static_cast<uint32_t>(document.length()), static_cast<uint32_t>(end - start));
+    }
+
+
+    // More members than the Container walks, so the labels are looked up through the index.
+    class WideJson : public Core::JSON::Container {
+    public:
+        WideJson(const WideJson&) = delete;
+        WideJson& operator=(const WideJson&) = delete;
+
+        WideJson()
+            : Core::JSON::Container()
+        {
+            for (uint8_t index = 0; index < (sizeof(Fields) / sizeof(Core::JSON::DecUInt32)); index++) {
+                _labels[index] = _T("field") + Core::NumberType<uint8_t>(index).Text();
+                Add(_labels[index].c_str(), &(Fields[index]));
+            }
+        }
+
+    public:
+        // Remove() matches the label by pointer, not by value.
+        const TCHAR* Label(const uint8_t index) const
+        {
+            return (_labels[index].c_str());
+        }
+        static string Document(const uint8_t count)
+        {
+            // Backwards, so the order of the document does not match the order of adding.
+            string document(_T("{"));
+            for (uint8_t index = count; index > 0; index--) {
+                document += _T("\"field") + Core::NumberType<uint8_t>(index - 1).Text() + _T("\":") + Core::NumberType<uint32_t>(100 + index - 1).Text();
+                document += (index > 1 ? _T(",") : _T(""));
+            }
+            return (document + _T("}"));
+        }
+
+    public:
+        Core::JSON::DecUInt32 Fields[12];
+
+    private:
+        string _labels[12];
+    };
+
+    TEST(JSONParser, ContainerIndexedLabels)
+    {
+        WideJson wide;
+
+        EXPECT_TRUE(wide.FromString(WideJson::Document(12)));
+
+        for (uint8_t index = 0; index < 12; index++) {
+            EXPECT_TRUE(wide.Fields[index].IsSet());
+            EXPECT_EQ(wide.Fields[index].Value(), 100u + index);
+        }
+
+        string text;
+        EXPECT_TRUE(wide.ToString(text));
+        EXPECT_EQ(text, _T("{\"field0\":100,\"field1\":101,\"field2\":102,\"field3\":103,\"field4\":104,\"field5\":105,")
+                        _T("\"field6\":106,\"field7\":107,\"field8\":108,\"field9\":109,\"field10\":110,\"field11\":111}"));
+    }
+
+    TEST(JSONParser, ContainerDuplicateLabels)
+    {
+        // Below and above the number of members that gets an index, the first one added wins.
+        for (const uint8_t members : { 2, 20 }) {
+            Core::JSON::DecUInt32 values[20];
+            Core::JSON::Container container;
+
+            for (uint8_t index = 0; index < members; index++) {
+                container.Add(_T("same"), &(values[index]));
+            }
+
+            EXPECT_TRUE(container.FromString(_T("{\"same\":42}")));
+            EXPECT_EQ(values[0].Value(), 42u);
+
+            for (uint8_t index = 1; index < members; index++) {
+                EXPECT_FALSE(values[index].IsSet());
+            }
+        }
+    }
+
+    TEST(JSONParser, ContainerAddRemoveIndexed)
+    {
+        WideJson wide;
+        Core::JSON::DecUInt32 late, early;
+        const TCHAR lateLabel[] = _T("late");
+        const TCHAR earlyLabel[] = _T("field3");
+
+        // Builds the index..
+        EXPECT_TRUE(wide.FromString(WideJson::Document(12)));
+
+        // .. which should follow elements that are added and removed afterwards.
+        wide.Add(lateLabel, &late);
+        wide.Remove(wide.Label(3));
+        wide.Add(earlyLabel, &early);
+
+        wide.Clear();
+        wide.Fields[3].Clear();
+        EXPECT_TRUE(wide.FromString(_T("{\"late\":7,\"field3\":8,\"field11\":9}")));
+        EXPECT_EQ(late.Value(), 7u);
+        EXPECT_EQ(early.Value(), 8u);
+        EXPECT_FALSE(wide.Fields[3].IsSet());
+        EXPECT_EQ(wide.Fields[11].Value(), 9u);
+
+        wide.Remove(lateLabel);
+        late.Clear();
+        EXPECT_TRUE(wide.FromString(_T("{\"late\":5}")));
+        EXPECT_FALSE(late.IsSet());
+    }
+
+    TEST(JSONParser, VariantContainerGrowth)
+    {
+        string document(_T("{"));
+        for (uint8_t index = 0; index < 40; index++) {
+            document += (index != 0 ? _T(",\"key") : _T("\"key")) + Core::NumberType<uint8_t>(index).Text() + _T("\":") + Core::NumberType<uint8_t>(index).Text();
+        }
+        document += _T("}");
+
+        Core::JSON::VariantContainer container;
+        EXPECT_TRUE(container.FromString(document));
+
+        for (uint8_t index = 0; index < 40; index++) {
+            const string label(_T("key") + Core::NumberType<uint8_t>(index).Text());
+            ASSERT_TRUE(container.HasLabel(label.c_str()));
+            EXPECT_EQ(container.Get(label.c_str()).Number(), index);
+        }
+
+        // The same keys again, now all of them are found through the index.
+        EXPECT_TRUE(container.FromString(document));
+
+        uint32_t count = 0;
+        Core::JSON::VariantContainer::Iterator variants(container.Variants());
+        while (variants.Next() == true) {
+            count++;
+        }
+        EXPECT_EQ(count, 40u);
+
+        string text;
+        EXPECT_TRUE(container.ToString(text));
+        EXPECT_EQ(text, document);
+    }
+
+    TEST(JSONParser, ArrayReferenceStability)
+    {
+        Core::JSON::ArrayType<Core::JSON::DecUInt32> array;
+        std::vector<Core::JSON::DecUInt32*> added;
+
+        // Enough to grow over a number of chunks.
+        for (uint32_t index = 0; index < 1000; index++) {
+            Core::JSON::DecUInt32& element(array.Add());
+            element = index;
+            added.push_back(&element);
+        }
+
+        ASSERT_EQ(array.Length(), 1000u);
+
+        for (uint32_t index = 0; index < 1000; index++) {
+            EXPECT_EQ(&(array[index]), added[index]);
+            EXPECT_EQ(added[index]->Value(), index);
+        }
+
+        uint32_t expected = 0;
+        Core::JSON::ArrayType<Core::JSON::DecUInt32>::Iterator elements(array.Elements());
+        while (elements.Next() == true) {
+            EXPECT_EQ(&(elements.Current()), added[expected]);
+            expected++;
+        }
+        EXPECT_EQ(expected, 1000u);
+    }
+
+    class Counted {
+    public:
+        Counted(const uint32_t value = 0)
+            : Value(value)
+        {
+            Instances++;
+        }
+        Counted(const Counted& copy)
+            : Value(copy.Value)
+        {
+            Instances++;
+        }
+        ~Counted()
+        {
+            Instances--;
+        }
+        Counted& operator=(const Counted& rhs)
+        {
+            Value = rhs.Value;
+            return (*this);
+        }
+
+    public:
+        uint32_t Value;
+        static int32_t Instances;
+    };
+
+    int32_t Counted::Instances = 0;
+
+    TEST(JSONParser, ArenaClear)
+    {
+        {
+            Core::JSON::ArenaType<Counted> arena;
+
+            for (uint32_t index = 0; index < 100; index++) {
+                arena.emplace_back(index);
+            }
+            EXPECT_EQ(Counted::Instances, 100);
+            EXPECT_EQ(arena.size(), 100u);
+
+            const Counted* first = &(arena[0]);
+
+            arena.clear();
+            EXPECT_EQ(Counted::Instances, 0);
+            EXPECT_TRUE(arena.empty());
+            EXPECT_TRUE(arena.begin() == arena.end());
+
+            // The chunks are kept, so the storage is reused.
+            arena.push_back(Counted(7));
+            EXPECT_EQ(&(arena[0]), first);
+            EXPECT_EQ(arena.back().Value, 7u);
+
+            for (uint32_t index = 1; index < 50; index++) {
+                arena.emplace_back(index);
+            }
+            EXPECT_EQ(Counted::Instances, 50);
+
+            Core::JSON::ArenaType<Counted> copy(arena);
+            EXPECT_EQ(Counted::Instances, 100);
+            EXPECT_EQ(copy[49].Value, 49u);
+        }
+
+        EXPECT_EQ(Counted::Instances, 0);
+    }
+
 } // Tests
 
 ENUM_CONVERSION_BEGIN(Tests::JSONTestEnum){ WPEFramework::Tests::JSONTestEnum::ONE, _TXT("one") },
@@ -0,0 +1,215 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+using namespace WPEFramework;
+
+namespace {
+
+class Client : public Core::SocketStream {
+public:
+    Client() = delete;
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+
+    Client(const SOCKET& connector, const Core::NodeId& remoteId)
+        : Core::SocketStream(false, connector, remoteId, 1024, 1024)
+    {
+    }
+    ~Client() override
+    {
+        Close(Core::infinite);
+    }
+
+private:
+    uint16_t SendData(uint8_t*, const uint16_t) override
+    {
+        return (0);
+    }
+    uint16_t ReceiveData(uint8_t*, const uint16_t receivedSize) override
+    {
+        return (receivedSize);
+    }
+    void StateChange() override
+    {
+    }
+};
+
+// Accepts on one of the reactors. The accepted client is registered on whatever reactor its
+// address hashes to, so that is often another reactor than the one accepting.
+class Listener : public Core::SocketListner {
+public:
+    Listener() = delete;
+    Listener(const Listener&) = delete;
+    Listener& operator=(const Listener&) = delete;
+
+    Listener(const string& path, std::atomic<uint32_t>& accepting)
+        : Core::SocketListner(Core::NodeId(path.c_str()))
+        , _path(path)
+        , _accepting(accepting)
+        , _lock()
+        , _clients()
+        , _reactor(0)
+    {
+    }
+    ~Listener() override
+    {
+        Close(Core::infinite);
+
+        for (Client* client : _clients) {
+            delete client;
+        }
+    }
+
+public:
+    const string& Path() const
+    {
+        return (_path);
+    }
+    ::ThreadId Reactor() const
+    {
+        return (_reactor);
+    }
+    uint32_t Clients() const
+    {
+        _lock.Lock();
+        uint32_t result = static_cast<uint32_t>(_clients.size());
+        _lock.Unlock();
+        return (result);
+    }
+    void Accept(SOCKET& newClient, const Core::NodeId& remoteId) override
+    {
+        _reactor = Core::Thread::ThreadId();
+
+        // Do not register before the other listener is accepting as well, or until it is
+        // clear that it is not going to.
+        _accepting++;
+
+        uint32_t waiting = 100;
+        while ((_accepting.load() < 2) && (waiting-- != 0)) {
+            ::SleepMs(1);
+        }
+
+        Client* client = new Client(newClient, remoteId);
+
+        client->Open(0);
+
+        _lock.Lock();
+        _clients.push_back(client);
+        _lock.Unlock();
+    }
+
+private:
+    const string _path;
+    std::atomic<uint32_t>& _accepting;
+    mutable Core::CriticalSection _lock;
+    std::vector<Client*> _clients;
+    ::ThreadId _reactor;
+};
+
+int Connect(const string& path)
+{
+    struct sockaddr_un address;
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+    ::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    ::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    if (::connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        fd = -1;
+    }
+
+    return (fd);
+}
+
+bool WaitFor(const Listener& listener, const uint32_t clients)
+{
+    uint32_t waiting = 2000;
+
+    while ((listener.Clients() < clients) && (waiting-- != 0)) {
+        ::SleepMs(1);
+    }
+
+    return (listener.Clients() >= clients);
+}
+
+}
+
+TEST(Core_ResourceMonitor, AcceptOnTwoReactors)
+{
+    Core::Singleton::Dispose();
+    Core::ResourceMonitor::Reactors(2);
+
+    ASSERT_EQ(Core::ResourceMonitor::Instance().Reactors(), 2);
+
+    std::atomic<uint32_t> accepting(0);
+    std::vector<Listener*> listeners;
+    std::vector<int> connections;
+    Listener* first = nullptr;
+    Listener* second = nullptr;
+
+    // Listeners are spread over the reactors by their address, find one on each.
+    for (uint32_t index = 0; (index < 32) && (second == nullptr); index++) {
+        Listener* listener = new Listener(_T("/tmp/wpemonitor") + Core::NumberType<uint32_t>(index).Text(), accepting);
+
+        listeners.push_back(listener);
+        ASSERT_EQ(listener->Open(Core::infinite), Core::ERROR_NONE);
+
+        accepting = 2;
+        connections.push_back(Connect(listener->Path()));
+        ASSERT_TRUE(WaitFor(*listener, 1));
+
+        if (first == nullptr) {
+            first = listener;
+        } else if (listener->Reactor() != first->Reactor()) {
+            second = listener;
+        }
+    }
+
+    ASSERT_TRUE(second != nullptr);
+
+    // Both reactors accept at the same time and register the new clients on each other.
+    for (uint32_t round = 1; round <= 40; round++) {
+        accepting = 0;
+
+        connections.push_back(Connect(first->Path()));
+        connections.push_back(Connect(second->Path()));
+
+        ASSERT_TRUE(WaitFor(*first, 1 + round)) << "round " << round;
+        ASSERT_TRUE(WaitFor(*second, 1 + round)) << "round " << round;
+    }
+
+    for (int fd : connections) {
+        ::close(fd);
+    }
+    for (Listener* listener : listeners) {
+        delete listener;
+    }
+
+    Core::Singleton::Dispose();
+    Core::ResourceMonitor::Reactors(1);
+}
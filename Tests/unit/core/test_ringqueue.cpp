@@ -0,0 +1,192 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        class Element : public Core::QueuedFlag {
+        public:
+            Element(const Element&) = delete;
+            Element& operator=(const Element&) = delete;
+
+            Element() = default;
+            ~Element() = default;
+        };
+
+        uint64_t Elapsed(const uint64_t start)
+        {
+            // In milliseconds
+            return ((Core::Time::Now().Ticks() - start) / 1000);
+        }
+    }
+
+    TEST(Core_RingQueue, Timeouts)
+    {
+        Core::RingQueueType<uint32_t> queue(4);
+        uint32_t entry = 0;
+
+        uint64_t start = Core::Time::Now().Ticks();
+        EXPECT_FALSE(queue.Extract(entry, 100));
+        EXPECT_GE(Elapsed(start), 100u);
+        EXPECT_LT(Elapsed(start), 1000u);
+
+        for (uint32_t index = 1; index <= 4; index++) {
+            EXPECT_TRUE(queue.Insert(index, 0));
+        }
+        EXPECT_TRUE(queue.IsFull());
+        EXPECT_FALSE(queue.Post(5));
+
+        start = Core::Time::Now().Ticks();
+        EXPECT_FALSE(queue.Insert(5, 100));
+        EXPECT_GE(Elapsed(start), 100u);
+        EXPECT_LT(Elapsed(start), 1000u);
+
+        for (uint32_t index = 1; index <= 4; index++) {
+            EXPECT_TRUE(queue.Extract(entry, 0));
+            EXPECT_EQ(entry, index);
+        }
+        EXPECT_TRUE(queue.IsEmpty());
+    }
+
+    TEST(Core_RingQueue, DeadlineOverRetries)
+    {
+        Core::RingQueueType<uint32_t> queue(2);
+        std::atomic<bool> running(true);
+
+        EXPECT_TRUE(queue.Post(1));
+        EXPECT_TRUE(queue.Post(2));
+        EXPECT_TRUE(queue.IsFull());
+
+        // Keeps the queue changing, but full, so the waiting Insert is woken over and over again.
+        std::thread churn([&]() {
+            uint32_t entry;
+
+            while (running == true) {
+                if (queue.Extract(entry, 10) == true) {
+                    queue.Insert(entry, 10);
+                }
+            }
+        });
+
+        // It might get in between, it might not, but it does not wait much longer than it was told.
+        const uint64_t start = Core::Time::Now().Ticks();
+        queue.Insert(3, 200);
+        EXPECT_LT(Elapsed(start), 1000u);
+
+        running = false;
+        churn.join();
+
+        EXPECT_EQ(queue.Length(), 2u);
+    }
+
+    TEST(Core_RingQueue, ProducerConsumer)
+    {
+        Core::RingQueueType<uint32_t> queue(8);
+        const uint32_t count = 10000;
+        uint64_t sum = 0;
+
+        std::thread consumer([&]() {
+            uint32_t entry;
+
+            for (uint32_t index = 0; index < count; index++) {
+                if (queue.Extract(entry, 1000) == true) {
+                    sum += entry;
+                }
+            }
+        });
+
+        for (uint32_t index = 1; index <= count; index++) {
+            EXPECT_TRUE(queue.Insert(index, 1000));
+        }
+
+        consumer.join();
+
+        EXPECT_EQ(sum, (static_cast<uint64_t>(count) * (count + 1)) / 2);
+        EXPECT_TRUE(queue.IsEmpty());
+    }
+
+    TEST(Core_RingQueue, DisableReleasesWaiters)
+    {
+        Core::RingQueueType<uint32_t> queue(2);
+        uint32_t entry = 0;
+        bool received = true;
+
+        std::thread consumer([&]() {
+            received = queue.Extract(entry, Core::infinite);
+        });
+
+        ::SleepMs(50);
+        queue.Disable();
+        consumer.join();
+
+        EXPECT_FALSE(received);
+        EXPECT_FALSE(queue.Post(1));
+
+        queue.Enable();
+        EXPECT_TRUE(queue.Post(1));
+    }
+
+    TEST(Core_RingQueue, DuplicateSuppression)
+    {
+        Core::RingQueueType<Element*, Core::IntrusiveQueueFilter<Element*>> queue(4);
+        Element first;
+        Element second;
+        Element* entry = nullptr;
+
+        EXPECT_TRUE(queue.Post(&first));
+        EXPECT_TRUE(first.IsQueued());
+
+        // Already waiting in the queue, accepted, but not queued again.
+        EXPECT_TRUE(queue.Post(&first));
+        EXPECT_TRUE(queue.Insert(&first, 0));
+        EXPECT_EQ(queue.Length(), 1u);
+
+        EXPECT_TRUE(queue.Post(&second));
+        EXPECT_EQ(queue.Length(), 2u);
+
+        EXPECT_TRUE(queue.Extract(entry, 0));
+        EXPECT_EQ(entry, &first);
+        EXPECT_FALSE(first.IsQueued());
+
+        // Once out of the queue, it can be queued again.
+        EXPECT_TRUE(queue.Post(&first));
+        EXPECT_EQ(queue.Length(), 2u);
+
+        EXPECT_TRUE(queue.Extract(entry, 0));
+        EXPECT_EQ(entry, &second);
+        EXPECT_TRUE(queue.Extract(entry, 0));
+        EXPECT_EQ(entry, &first);
+        EXPECT_FALSE(queue.Extract(entry, 0));
+
+        // What is flushed, is not queued anymore.
+        EXPECT_TRUE(queue.Post(&second));
+        queue.Disable();
+        queue.Flush();
+        EXPECT_FALSE(second.IsQueued());
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,351 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <com/com.h>
+
+static string g_arenaConnectorName = _T("/tmp/wperpc02");
+
+namespace WPEFramework {
+namespace Exchange {
+    struct IChecksum : virtual public Core::IUnknown {
+        enum { ID = 0x80000002 };
+        virtual uint32_t Sum(const uint32_t length, const uint8_t data[] /* @length:length @shared */) = 0;
+        virtual void Fill(const uint8_t value, const uint32_t length, uint8_t data[] /* @out @length:length @shared */) = 0;
+    };
+}
+}
+
+using namespace WPEFramework;
+
+class Checksum : public Exchange::IChecksum {
+public:
+    Checksum() = default;
+
+    uint32_t Sum(const uint32_t length, const uint8_t data[]) override
+    {
+        uint32_t result = 0;
+
+        for (uint32_t index = 0; index < length; index++) {
+            result += data[index];
+        }
+
+        return (result);
+    }
+    void Fill(const uint8_t value, const uint32_t length, uint8_t data[]) override
+    {
+        ::memset(data, value, length);
+    }
+
+    BEGIN_INTERFACE_MAP(Checksum)
+        INTERFACE_ENTRY(Exchange::IChecksum)
+    END_INTERFACE_MAP
+};
+
+// Proxystubs, as generated from IChecksum.
+namespace WPEFramework {
+    using namespace Exchange;
+
+    // -----------------------------------------------------------------
+    // STUB
+    // -----------------------------------------------------------------
+
+    ProxyStub::MethodHandler ChecksumStubMethods[] = {
+        // virtual uint32_t Sum(const uint32_t, const uint8_t*) = 0
+        //
+        [](Core::ProxyType<Core::IPCChannel>& channel VARIABLE_IS_NOT_USED, Core::ProxyType<RPC::InvokeMessage>& message) {
+            RPC::Data::Input& input(message->Parameters());
+
+            // read parameters
+            RPC::Data::Frame::Reader reader(input.Reader());
+            const uint8_t* param1 = nullptr;
+            uint32_t param1_length = static_cast<uint32_t>(RPC::BulkBuffer::Lock(channel, reader, param1));
+
+            // call implementation
+            IChecksum* implementation = reinterpret_cast<IChecksum*>(input.Implementation());
+            ASSERT((implementation != nullptr) && "Null IChecksum implementation pointer");
+            const uint32_t output = implementation->Sum(param1_length, param1);
+
+            // write return value
+            RPC::Data::Frame::Writer writer(message->Response().Writer());
+            writer.Number<const uint32_t>(output);
+        },
+
+        // virtual void Fill(const uint8_t, const uint32_t, uint8_t*) = 0
+        //
+        [](Core::ProxyType<Core::IPCChannel>& channel VARIABLE_IS_NOT_USED, Core::ProxyType<RPC::InvokeMessage>& message) {
+            RPC::Data::Input& input(message->Parameters());
+
+            // read parameters
+            RPC::Data::Frame::Reader reader(input.Reader());
+            const uint8_t param0 = reader.Number<uint8_t>();
+            const uint32_t param2_length = reader.Number<uint32_t>();
+            uint8_t* param2 = nullptr;
+            uint32_t param2_capacity = 0;
+            RPC::BulkBuffer::Lock(channel, reader, param2, param2_capacity);
+
+            // use the shared buffer in place, or make room if it came in the frame
+            if (param2_capacity < param2_length) {
+                uint8_t* param2_storage = static_cast<uint8_t*>(ALLOCA(param2_length));
+                ASSERT(param2_storage != nullptr);
+                param2 = param2_storage;
+            }
+
+            // call implementation
+            IChecksum* implementation = reinterpret_cast<IChecksum*>(input.Implementation());
+            ASSERT((implementation != nullptr) && "Null IChecksum implementation pointer");
+            implementation->Fill(param0, param2_length, param2);
+
+            // write return value
+            RPC::Data::Frame::Writer writer(message->Response().Writer());
+            RPC::BulkBuffer::Complete(channel, writer, param2_length, param2);
+        },
+
+        nullptr
+    }; // ChecksumStubMethods[]
+
+    // -----------------------------------------------------------------
+    // PROXY
+    // -----------------------------------------------------------------
+
+    class ChecksumProxy final : public ProxyStub::UnknownProxyType<IChecksum> {
+    public:
+        ChecksumProxy(const Core::ProxyType<Core::IPCChannel>& channel, RPC::instance_id implementation, const bool otherSideInformed)
+            : BaseClass(channel, implementation, otherSideInformed)
+        {
+        }
+
+        uint32_t Sum(const uint32_t param0, const uint8_t* param1) override
+        {
+            IPCMessage newMessage(BaseClass::Message(0));
+
+            // write parameters
+            RPC::Data::Frame::Writer writer(newMessage->Parameters().Writer());
+            RPC::BulkBuffer param1_bulk(BaseClass::Channel(), param0);
+            param1_bulk.Write(writer, param1, param0);
+
+            // invoke the method handler
+            uint32_t output{};
+            if ((output = ((param1_bulk.IsValid() == true) ? Invoke(newMessage) : Core::ERROR_INVALID_INPUT_LENGTH)) == Core::ERROR_NONE) {
+                // read return value
+                RPC::Data::Frame::Reader reader(newMessage->Response().Reader());
+                output = reader.Number<uint32_t>();
+            }
+
+            return output;
+        }
+
+        void Fill(const uint8_t param0, const uint32_t param1, uint8_t* /* out */ param2) override
+        {
+            IPCMessage newMessage(BaseClass::Message(1));
+
+            // write parameters
+            RPC::Data::Frame::Writer writer(newMessage->Parameters().Writer());
+            writer.Number<const uint8_t>(param0);
+            writer.Number<const uint32_t>(param1);
+            RPC::BulkBuffer param2_bulk(BaseClass::Channel(), param1);
+            param2_bulk.Write(writer, nullptr, 0);
+
+            // invoke the method handler
+            if ((param2_bulk.IsValid() == true) && (Invoke(newMessage) == Core::ERROR_NONE)) {
+                // read return value
+                RPC::Data::Frame::Reader reader(newMessage->Response().Reader());
+                param2_bulk.Read(reader, param2);
+            }
+        }
+
+        // Not generated: the name of the arena our buffers go through, a region of it that stays
+        // claimed, and a Sum() that claims its input is wherever we say it is. The stub should
+        // not take our word for it.
+        string Arena()
+        {
+            return (RPC::Administrator::Instance().Outbound(BaseClass::Channel())->Name());
+        }
+        RPC::BulkBuffer* Claim(const uint32_t size)
+        {
+            return (new RPC::BulkBuffer(BaseClass::Channel(), size));
+        }
+        uint32_t Forged(const string& name, const uint32_t offset, const uint32_t room, const uint32_t length)
+        {
+            IPCMessage newMessage(BaseClass::Message(0));
+
+            RPC::Data::Frame::Writer writer(newMessage->Parameters().Writer());
+            writer.Number<uint8_t>(1); // SHARED
+            writer.Text(name);
+            writer.Number<uint32_t>(offset);
+            writer.Number<uint32_t>(room);
+            writer.Number<uint32_t>(length);
+
+            uint32_t output{};
+            if ((output = Invoke(newMessage)) == Core::ERROR_NONE) {
+                RPC::Data::Frame::Reader reader(newMessage->Response().Reader());
+                output = reader.Number<uint32_t>();
+            }
+
+            return output;
+        }
+    }; // class ChecksumProxy
+
+    // -----------------------------------------------------------------
+    // REGISTRATION
+    // -----------------------------------------------------------------
+
+    namespace {
+
+        typedef ProxyStub::UnknownStubType<IChecksum, ChecksumStubMethods> ChecksumStub;
+
+        static class Instantiation {
+        public:
+            Instantiation()
+            {
+                RPC::Administrator::Instance().Announce<IChecksum, ChecksumProxy, ChecksumStub>();
+            }
+            ~Instantiation()
+            {
+                RPC::Administrator::Instance().Recall<IChecksum>();
+            }
+        } ProxyStubRegistration;
+
+    } // namespace
+}
+
+namespace {
+class ChecksumAccess : public RPC::Communicator {
+private:
+    ChecksumAccess() = delete;
+    ChecksumAccess(const ChecksumAccess&) = delete;
+    ChecksumAccess& operator=(const ChecksumAccess&) = delete;
+
+public:
+    ChecksumAccess(const Core::NodeId& source)
+        : RPC::Communicator(source, _T(""))
+    {
+        Open(Core::infinite);
+    }
+    ~ChecksumAccess()
+    {
+        Close(Core::infinite);
+    }
+
+private:
+    void* Aquire(const string& className VARIABLE_IS_NOT_USED, const uint32_t interfaceId, const uint32_t versionId VARIABLE_IS_NOT_USED) override
+    {
+        void* result = nullptr;
+
+        if (interfaceId == Exchange::IChecksum::ID) {
+            result = Core::Service<Checksum>::Create<Exchange::IChecksum>();
+        }
+
+        return result;
+    }
+};
+}
+
+TEST(Core_RPC, SharedBuffers)
+{
+    IPTestAdministrator::OtherSideMain otherSide = [](IPTestAdministrator& testAdmin) {
+        ChecksumAccess communicator(Core::NodeId(g_arenaConnectorName.c_str()));
+
+        testAdmin.Sync("setup server");
+
+        testAdmin.Sync("done testing");
+    };
+
+    IPTestAdministrator testAdmin(otherSide);
+
+    testAdmin.Sync("setup server");
+
+    {
+        Core::ProxyType<RPC::CommunicatorClient> client(Core::ProxyType<RPC::CommunicatorClient>::Create(Core::NodeId(g_arenaConnectorName.c_str())));
+
+        Exchange::IChecksum* checksum = client->Open<Exchange::IChecksum>(_T("Checksum"));
+        ASSERT_TRUE(checksum != nullptr);
+
+        ChecksumProxy* proxy = dynamic_cast<ChecksumProxy*>(checksum);
+        ASSERT_TRUE(proxy != nullptr);
+
+        // Below the threshold the buffer goes in the frame, above it through the arena.
+        std::vector<uint8_t> small(RPC::ArenaThreshold / 2, 3);
+        EXPECT_EQ(checksum->Sum(static_cast<uint32_t>(small.size()), small.data()), static_cast<uint32_t>(small.size() * 3));
+
+        std::vector<uint8_t> large(64 * 1024, 1);
+        EXPECT_EQ(checksum->Sum(static_cast<uint32_t>(large.size()), large.data()), static_cast<uint32_t>(large.size()));
+
+        const string arena(proxy->Arena());
+        EXPECT_EQ(arena.find(_T("/dev/shm/comrpc.")), 0u);
+        EXPECT_TRUE(Core::File(arena).Exists());
+
+        std::vector<uint8_t> filled(large.size(), 0);
+        checksum->Fill(7, static_cast<uint32_t>(filled.size()), filled.data());
+        EXPECT_EQ(std::count(filled.begin(), filled.end(), 7), static_cast<std::ptrdiff_t>(filled.size()));
+
+        // The 64 KiB of the calls above are still at the start of the arena. A region only ever
+        // gives access to what it was claimed for, the rest reads as no buffer at all.
+        EXPECT_EQ(proxy->Forged(arena, 0, static_cast<uint32_t>(large.size()), static_cast<uint32_t>(large.size())), static_cast<uint32_t>(large.size() * 7));
+        EXPECT_EQ(proxy->Forged(arena, 0, 1024, static_cast<uint32_t>(large.size())), 0u);
+        EXPECT_EQ(proxy->Forged(arena, RPC::ArenaSize - 1024, 2048, 1024), 0u);
+        EXPECT_EQ(proxy->Forged(arena, static_cast<uint32_t>(~0) - 1023, 2048, 1024), 0u);
+
+        // Only arenas of our own making are opened.
+        EXPECT_EQ(proxy->Forged(_T("/etc/hostname"), 0, 4, 4), 0u);
+        EXPECT_EQ(proxy->Forged(arena + _T("/../../../etc/hostname"), 0, 4, 4), 0u);
+
+        // And the channel still works after all that.
+        EXPECT_EQ(checksum->Sum(static_cast<uint32_t>(large.size()), large.data()), static_cast<uint32_t>(large.size()));
+
+        // Without room in the arena, a buffer too large for the frame fails the call instead of
+        // going out truncated. Smaller ones still go in the frame.
+        std::vector<RPC::BulkBuffer*> claims;
+
+        for (const uint32_t size : { 1024u * 1024u, 64u * 1024u }) {
+            RPC::BulkBuffer* claim;
+
+            while ((claim = proxy->Claim(size))->IsValid() == true) {
+                claims.push_back(claim);
+            }
+
+            delete claim;
+        }
+
+        std::vector<uint8_t> huge(96 * 1024, 1);
+        EXPECT_EQ(checksum->Sum(static_cast<uint32_t>(huge.size()), huge.data()), static_cast<uint32_t>(Core::ERROR_INVALID_INPUT_LENGTH));
+        EXPECT_EQ(checksum->Sum(static_cast<uint32_t>(small.size()), small.data()), static_cast<uint32_t>(small.size() * 3));
+
+        std::vector<uint8_t> untouched(huge.size(), 0);
+        checksum->Fill(7, static_cast<uint32_t>(untouched.size()), untouched.data());
+        EXPECT_EQ(std::count(untouched.begin(), untouched.end(), 0), static_cast<std::ptrdiff_t>(untouched.size()));
+
+        for (RPC::BulkBuffer* claim : claims) {
+            delete claim;
+        }
+
+        EXPECT_EQ(checksum->Sum(static_cast<uint32_t>(huge.size()), huge.data()), static_cast<uint32_t>(huge.size()));
+
+        checksum->Release();
+
+        client->Close(Core::infinite);
+    }
+
+    testAdmin.Sync("done testing");
+    Core::Singleton::Dispose();
+}
@@ -0,0 +1,211 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+class TimedJob {
+public:
+    TimedJob()
+        : _id(0)
+        , _fired(nullptr)
+    {
+    }
+    TimedJob(const uint32_t id, std::vector<uint32_t>* fired = nullptr)
+        : _id(id)
+        , _fired(fired)
+    {
+    }
+    TimedJob(const TimedJob& copy) = default;
+    TimedJob& operator=(const TimedJob& rhs) = default;
+
+    struct Hash {
+        size_t operator()(const TimedJob& job) const
+        {
+            return (std::hash<uint32_t>()(job._id));
+        }
+    };
+
+public:
+    bool operator==(const TimedJob& rhs) const
+    {
+        return (_id == rhs._id);
+    }
+    bool operator!=(const TimedJob& rhs) const
+    {
+        return (!operator==(rhs));
+    }
+    uint32_t Id() const
+    {
+        return (_id);
+    }
+    uint64_t Timed(const uint64_t)
+    {
+        if (_fired != nullptr) {
+            _fired->push_back(_id);
+        }
+        return (0);
+    }
+
+private:
+    uint32_t _id;
+    std::vector<uint32_t>* _fired;
+};
+
+typedef Core::TimerList<TimedJob> JobList;
+typedef Core::TimerHeap<TimedJob, TimedJob::Hash> JobHeap;
+
+template <typename STORAGE>
+void CheckOrder()
+{
+    STORAGE storage;
+    const uint32_t count = 2000;
+
+    // Plenty of equal times, those should come out in the order they went in.
+    for (uint32_t index = 0; index < count; index++) {
+        storage.Insert(Core::TimedInfoType<TimedJob>((index * 7919) % 97, TimedJob(index)));
+    }
+    EXPECT_EQ(storage.Count(), count);
+
+    bool found = false;
+    for (uint32_t index = 0; index < count; index += 3) {
+        storage.Remove(TimedJob(index), found);
+        EXPECT_TRUE(found);
+    }
+    storage.Remove(TimedJob(count), found);
+    EXPECT_FALSE(found);
+
+    uint64_t lastTime = 0;
+    uint32_t lastId = 0;
+    uint32_t extracted = 0;
+    while (storage.IsEmpty() == false) {
+        uint64_t next = storage.NextTime();
+        Core::TimedInfoType<TimedJob> info(storage.Extract());
+
+        EXPECT_EQ(info.ScheduleTime(), next);
+        EXPECT_NE(info.Content().Id() % 3, 0u);
+        EXPECT_GE(info.ScheduleTime(), lastTime);
+        if ((extracted != 0) && (info.ScheduleTime() == lastTime)) {
+            EXPECT_GT(info.Content().Id(), lastId);
+        }
+        lastTime = info.ScheduleTime();
+        lastId = info.Content().Id();
+        extracted++;
+    }
+    EXPECT_EQ(extracted, count - ((count + 2) / 3));
+}
+
+TEST(Core_Timer, ListOrder)
+{
+    CheckOrder<JobList>();
+}
+
+TEST(Core_Timer, HeapOrder)
+{
+    CheckOrder<JobHeap>();
+}
+
+TEST(Core_Timer, HeapRevokeHead)
+{
+    JobHeap storage;
+    bool found = false;
+
+    storage.Insert(Core::TimedInfoType<TimedJob>(30, TimedJob(3)));
+    EXPECT_TRUE(storage.Insert(Core::TimedInfoType<TimedJob>(10, TimedJob(1))));
+    EXPECT_FALSE(storage.Insert(Core::TimedInfoType<TimedJob>(20, TimedJob(2))));
+    storage.Insert(Core::TimedInfoType<TimedJob>(40, TimedJob(1)));
+
+    // Both entries of job 1 go, one of them was the head.
+    EXPECT_TRUE(storage.Remove(TimedJob(1), found));
+    EXPECT_TRUE(found);
+    EXPECT_EQ(storage.Count(), 2u);
+    EXPECT_EQ(storage.NextTime(), 20u);
+    EXPECT_FALSE(storage.Remove(TimedJob(3), found));
+    EXPECT_EQ(storage.Extract().Content().Id(), 2u);
+    EXPECT_TRUE(storage.IsEmpty());
+}
+
+TEST(Core_Timer, HeapTimerFires)
+{
+    std::vector<uint32_t> fired;
+    Core::TimerType<TimedJob, JobHeap> timer(Core::Thread::DefaultStackSize(), _T("TestTimer"));
+    uint64_t now = Core::Time::Now().Ticks();
+
+    timer.Schedule(now + (30 * Core::Time::TicksPerMillisecond), TimedJob(3, &fired));
+    timer.Schedule(now + (10 * Core::Time::TicksPerMillisecond), TimedJob(1, &fired));
+    timer.Schedule(now + (20 * Core::Time::TicksPerMillisecond), TimedJob(2, &fired));
+    timer.Schedule(now + (20 * Core::Time::TicksPerMillisecond), TimedJob(4, &fired));
+    EXPECT_TRUE(timer.Revoke(TimedJob(4)));
+
+    uint32_t waited = 0;
+    while ((timer.Pending() != 0) && (waited++ < 100)) {
+        SleepMs(10);
+    }
+
+    ASSERT_EQ(fired.size(), 3u);
+    EXPECT_EQ(fired[0], 1u);
+    EXPECT_EQ(fired[1], 2u);
+    EXPECT_EQ(fired[2], 3u);
+}
+
+// Not so much a test, but a micro benchmark of the two administrations: many
+// pending timers that get rescheduled (revoke + schedule) and expire.
+template <typename STORAGE>
+uint64_t Churn(const uint32_t count, const uint32_t rounds)
+{
+    STORAGE storage;
+    uint32_t seed = 1;
+    bool found;
+
+    auto random = [&seed]() -> uint32_t { seed = (seed * 1103515245) + 12345; return (seed >> 8); };
+
+    uint64_t start = Core::Time::Now().Ticks();
+
+    for (uint32_t index = 0; index < count; index++) {
+        storage.Insert(Core::TimedInfoType<TimedJob>(random() % 1000000, TimedJob(index)));
+    }
+    for (uint32_t round = 0; round < rounds; round++) {
+        TimedJob job(random() % count);
+        storage.Remove(job, found);
+        storage.Insert(Core::TimedInfoType<TimedJob>(random() % 1000000, job));
+    }
+    while (storage.IsEmpty() == false) {
+        storage.Extract();
+    }
+
+    return (Core::Time::Now().Ticks() - start);
+}
+
+TEST(Core_Timer, Benchmark)
+{
+    const uint32_t rounds = 2000;
+
+    for (uint32_t count : { 100, 1000, 10000 }) {
+        uint64_t list = Churn<JobList>(count, rounds);
+        uint64_t heap = Churn<JobHeap>(count, rounds);
+
+        printf("%6u timers, %u reschedules: list %8u us, heap %8u us\n", count, rounds, static_cast<uint32_t>(list), static_cast<uint32_t>(heap));
+    }
+}
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,703 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <websocket/websocket.h>
+#include <zlib.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+// The byte by byte masking as it is described in RFC 6455.
+static void MaskScalar(uint8_t data[], const uint32_t length, const uint8_t key[4], const uint8_t offset)
+{
+    for (uint32_t index = 0; index < length; index++) {
+        data[index] ^= key[(index + offset) & 0x03];
+    }
+}
+
+static void Fill(uint8_t data[], const uint32_t length)
+{
+    for (uint32_t index = 0; index < length; index++) {
+        data[index] = static_cast<uint8_t>((index * 7) + (index >> 8));
+    }
+}
+
+TEST(WebSocket_Protocol, Mask)
+{
+    const uint8_t key[] = { 0x12, 0x34, 0x56, 0x78 };
+    uint8_t expected[300];
+    uint8_t buffer[304];
+
+    // All the tails and the unaligned starts.
+    for (uint32_t length = 0; length < 260; length++) {
+        for (uint8_t offset = 0; offset < 4; offset++) {
+            uint8_t* data = &buffer[(length + offset) & 0x03];
+
+            Fill(expected, length);
+            Fill(data, length);
+
+            MaskScalar(expected, length, key, offset);
+            Web::WebSocket::Protocol::Mask(data, length, key, offset);
+
+            ASSERT_EQ(::memcmp(expected, data, length), 0) << "length " << length << " offset " << static_cast<uint32_t>(offset);
+        }
+    }
+}
+
+TEST(WebSocket_Protocol, MaskedFrames)
+{
+    for (uint16_t length : { 1, 7, 125, 126, 127, 1000, 4000 }) {
+        Web::WebSocket::Protocol client(false, true);
+        Web::WebSocket::Protocol server(false, false);
+        uint8_t frame[4096 + 8];
+        uint8_t expected[4096];
+
+        Fill(expected, length);
+        ::memcpy(&frame[client.HeaderSize()], expected, length);
+
+        const uint16_t size = client.Encoder(frame, sizeof(frame) - client.HeaderSize(), length);
+        const uint8_t header = (length <= 125 ? 6 : 8);
+
+        ASSERT_EQ(size, header + length);
+        EXPECT_EQ(frame[0], 0x81);
+        EXPECT_EQ((frame[1] & 0x80), 0x80);
+
+        // Deliver it in two parts, the second one continues to unmask with the proper key byte.
+        uint16_t first = std::max<uint16_t>(header, std::min<uint16_t>(size, header + (length / 3)));
+        uint16_t received = first;
+
+        EXPECT_EQ(server.Decoder(frame, received), header);
+        EXPECT_EQ(received, first - header);
+
+        if (first < size) {
+            received = size - first;
+
+            EXPECT_EQ(server.Decoder(&frame[first], received), 0);
+            EXPECT_EQ(received, size - first);
+        }
+
+        EXPECT_TRUE(server.IsCompleteMessage());
+        EXPECT_EQ(::memcmp(&frame[header], expected, length), 0) << "length " << length;
+    }
+}
+
+TEST(WebSocket_Protocol, UnmaskedFrames)
+{
+    for (uint16_t length : { 1, 125, 126, 1000 }) {
+        Web::WebSocket::Protocol server(false, false);
+        uint8_t frame[1024 + 4];
+        uint8_t expected[1024];
+
+        Fill(expected, length);
+        ::memcpy(&frame[server.HeaderSize()], expected, length);
+
+        const uint16_t size = server.Encoder(frame, sizeof(frame) - server.HeaderSize(), length);
+        const uint8_t header = (length <= 125 ? 2 : 4);
+
+        ASSERT_EQ(size, header + length);
+        EXPECT_EQ(::memcmp(&frame[header], expected, length), 0) << "length " << length;
+    }
+}
+
+// Not so much a test, but a micro benchmark of the masking on frames from 64 bytes to 1 MiB.
+TEST(WebSocket_Protocol, Benchmark)
+{
+    const uint8_t key[] = { 0xA5, 0x5A, 0x3C, 0xC3 };
+    const uint32_t total = 64 * 1024 * 1024;
+    std::vector<uint8_t> data(1024 * 1024 + 1);
+
+    Fill(data.data(), static_cast<uint32_t>(data.size()));
+
+    for (uint32_t length = 64; length <= (1024 * 1024); length *= 4) {
+        const uint32_t rounds = total / length;
+        uint64_t start = Core::Time::Now().Ticks();
+
+        for (uint32_t round = 0; round < rounds; round++) {
+            MaskScalar(&data[1], length, key, 1);
+        }
+
+        uint64_t scalar = Core::Time::Now().Ticks() - start;
+
+        start = Core::Time::Now().Ticks();
+
+        for (uint32_t round = 0; round < rounds; round++) {
+            Web::WebSocket::Protocol::Mask(&data[1], length, key, 1);
+        }
+
+        uint64_t wide = Core::Time::Now().Ticks() - start;
+
+        printf("%8u byte frames: byte wise %6u MB/s, wide %6u MB/s\n", length,
+            static_cast<uint32_t>(total / std::max<uint64_t>(scalar, 1)),
+            static_cast<uint32_t>(total / std::max<uint64_t>(wide, 1)));
+    }
+}
+
+// Opens up what the serializer sees of a FileBody: where the body starts and how long it is.
+class RangedFileBody : public Web::FileBody {
+public:
+    RangedFileBody(const RangedFileBody&) = delete;
+    RangedFileBody& operator=(const RangedFileBody&) = delete;
+
+    RangedFileBody(const string& path)
+        : Web::FileBody(path, true)
+    {
+    }
+    ~RangedFileBody() override = default;
+
+public:
+    void Body(int64_t& start, uint32_t& length) const
+    {
+        length = Serialize();
+        start = Core::File::Position();
+        End();
+    }
+};
+
+static const string CreateTestFile(const uint32_t size)
+{
+    const string path(_T("/tmp/wpeframework_filebody.bin"));
+    Core::File file(path);
+    uint8_t data[256];
+
+    Fill(data, sizeof(data));
+
+    EXPECT_TRUE(file.Create());
+    for (uint32_t written = 0; written < size; written += sizeof(data)) {
+        file.Write(data, std::min(static_cast<uint32_t>(sizeof(data)), size - written));
+    }
+    file.Close();
+
+    return (path);
+}
+
+TEST(Web_FileBody, Range)
+{
+    const struct {
+        const TCHAR* Range;
+        Web::WebStatus Status;
+        const TCHAR* ContentRange;
+        int64_t Start;
+        uint32_t Length;
+    } cases[] = {
+        { _T("bytes=0-99"), Web::STATUS_PARTIAL_CONTENT, _T("bytes 0-99/1000"), 0, 100 },
+        { _T("bytes=100-100"), Web::STATUS_PARTIAL_CONTENT, _T("bytes 100-100/1000"), 100, 1 },
+        { _T("bytes=990-2000"), Web::STATUS_PARTIAL_CONTENT, _T("bytes 990-999/1000"), 990, 10 },
+        // Suffix ranges, the last N bytes.
+        { _T("bytes=-100"), Web::STATUS_PARTIAL_CONTENT, _T("bytes 900-999/1000"), 900, 100 },
+        { _T("bytes=-5000"), Web::STATUS_PARTIAL_CONTENT, _T("bytes 0-999/1000"), 0, 1000 },
+        // Open ended.
+        { _T("bytes=500-"), Web::STATUS_PARTIAL_CONTENT, _T("bytes 500-999/1000"), 500, 500 },
+        // Unsatisfiable.
+        { _T("bytes=1000-"), Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE, _T("bytes */1000"), 0, 1000 },
+        { _T("bytes=5000-6000"), Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE, _T("bytes */1000"), 0, 1000 },
+        { _T("bytes=-0"), Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE, _T("bytes */1000"), 0, 1000 },
+        // Not understood or multiple ranges, the whole file is sent.
+        { _T("bytes=0-10,20-30"), Web::STATUS_OK, _T(""), 0, 1000 },
+        { _T("bytes=20-10"), Web::STATUS_OK, _T(""), 0, 1000 },
+        { _T("bytes=a-b"), Web::STATUS_OK, _T(""), 0, 1000 },
+        { _T("items=0-10"), Web::STATUS_OK, _T(""), 0, 1000 },
+        { _T("bytes=-"), Web::STATUS_OK, _T(""), 0, 1000 },
+    };
+
+    const string path(CreateTestFile(1000));
+
+    for (const auto& entry : cases) {
+        RangedFileBody body(path);
+        string contentRange;
+        int64_t start;
+        uint32_t length;
+
+        EXPECT_EQ(body.Range(entry.Range, contentRange), entry.Status) << entry.Range;
+        EXPECT_EQ(contentRange, entry.ContentRange) << entry.Range;
+
+        body.Body(start, length);
+        EXPECT_EQ(start, entry.Start) << entry.Range;
+        EXPECT_EQ(length, entry.Length) << entry.Range;
+    }
+
+    Core::File(path).Destroy();
+}
+
+TEST(Web_FileBody, RangeOnChangedFile)
+{
+    const string path(CreateTestFile(1000));
+    RangedFileBody body(path);
+    string contentRange;
+    int64_t start;
+    uint32_t length;
+
+    // The file shrinks after it was assigned to the body, the range follows the file as it is now.
+    Core::File file(path);
+    EXPECT_TRUE(file.Open(false));
+    EXPECT_TRUE(file.SetSize(600));
+    file.Close();
+
+    EXPECT_EQ(body.Range(_T("bytes=500-"), contentRange), Web::STATUS_PARTIAL_CONTENT);
+    EXPECT_EQ(contentRange, _T("bytes 500-599/600"));
+
+    body.Body(start, length);
+    EXPECT_EQ(start, 500);
+    EXPECT_EQ(length, 100u);
+
+    EXPECT_EQ(body.Range(_T("bytes=700-"), contentRange), Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE);
+    EXPECT_EQ(contentRange, _T("bytes */600"));
+
+    Core::File(path).Destroy();
+}
+
+static std::vector<uint8_t> Text(const uint32_t length)
+{
+    static const char words[] = "the quick brown fox jumps over the lazy dog, pack my box with five dozen liquor jugs. ";
+    std::vector<uint8_t> result(length);
+
+    for (uint32_t index = 0; index < length; index++) {
+        result[index] = words[(index + (index / 997)) % (sizeof(words) - 1)];
+    }
+
+    return (result);
+}
+
+static std::vector<uint8_t> Noise(const uint32_t length)
+{
+    std::vector<uint8_t> result(length);
+    uint32_t state = 0x12345678;
+
+    for (uint32_t index = 0; index < length; index++) {
+        state ^= (state << 13);
+        state ^= (state >> 17);
+        state ^= (state << 5);
+        result[index] = static_cast<uint8_t>(state >> 11);
+    }
+
+    return (result);
+}
+
+// windowBits as in inflateInit2: 16 + MAX_WBITS for gzip, MAX_WBITS for zlib, -MAX_WBITS for raw deflate.
+static bool Inflate(const uint8_t data[], const uint32_t length, const int windowBits, std::vector<uint8_t>& result)
+{
+    z_stream stream;
+    uint8_t buffer[1024];
+    int status = Z_OK;
+
+    ::memset(&stream, 0, sizeof(stream));
+    result.clear();
+
+    if (inflateInit2(&stream, windowBits) == Z_OK) {
+        stream.next_in = const_cast<uint8_t*>(data);
+        stream.avail_in = length;
+
+        do {
+            stream.next_out = buffer;
+            stream.avail_out = sizeof(buffer);
+            status = inflate(&stream, Z_SYNC_FLUSH);
+            result.insert(result.end(), buffer, &(buffer[sizeof(buffer) - stream.avail_out]));
+        } while ((status == Z_OK) && ((stream.avail_in != 0) || (stream.avail_out == 0)));
+
+        inflateEnd(&stream);
+    }
+
+    return ((status == Z_STREAM_END) || ((windowBits < 0) && (status == Z_OK || status == Z_BUF_ERROR)));
+}
+
+// Collects the serialized response, split in its (lower case) headers and its body.
+class ResponseWriter : public Web::Response::Serializer {
+public:
+    ResponseWriter(const ResponseWriter&) = delete;
+    ResponseWriter& operator=(const ResponseWriter&) = delete;
+
+    ResponseWriter()
+        : Web::Response::Serializer()
+        , _done(false)
+    {
+    }
+    ~ResponseWriter() = default;
+
+public:
+    void Write(const Web::Response& response, std::map<string, string>& headers, std::vector<uint8_t>& body)
+    {
+        uint8_t buffer[512];
+        std::vector<uint8_t> output;
+
+        _done = false;
+        Submit(response);
+
+        while (_done == false) {
+            const uint16_t loaded = Serialize(buffer, sizeof(buffer));
+            output.insert(output.end(), buffer, &(buffer[loaded]));
+        }
+
+        const uint8_t separator[] = { '\r', '\n', '\r', '\n' };
+        std::vector<uint8_t>::iterator end(std::search(output.begin(), output.end(), separator, &(separator[sizeof(separator)])));
+
+        ASSERT_TRUE(end != output.end());
+
+        const string lines(output.begin(), end);
+        size_t offset = lines.find("\r\n");
+
+        headers.clear();
+
+        while (offset != string::npos) {
+            const size_t next = lines.find("\r\n", offset + 2);
+            const string line(lines.substr(offset + 2, (next == string::npos ? lines.length() : next) - offset - 2));
+            const size_t colon = line.find(':');
+
+            if (colon != string::npos) {
+                string key(line.substr(0, colon));
+                std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+                headers[key] = line.substr(line.find_first_not_of(' ', colon + 1));
+            }
+
+            offset = next;
+        }
+
+        body.assign(end + sizeof(separator), output.end());
+    }
+
+private:
+    void Serialized(const Web::Response&) override
+    {
+        _done = true;
+    }
+
+private:
+    bool _done;
+};
+
+static void CompressedResponse(const Web::EncodingTypes encoding, const int windowBits, const TCHAR name[])
+{
+    const std::vector<uint8_t> content(Text(20000));
+    Core::ProxyType<Web::TextBody> body(Core::ProxyType<Web::TextBody>::Create());
+    Web::Response response;
+    ResponseWriter writer;
+    std::map<string, string> headers;
+    std::vector<uint8_t> received, inflated;
+
+    *body = string(content.begin(), content.end());
+    response.ContentType = Web::MIME_TEXT;
+    response.Body(body);
+
+    EXPECT_TRUE(response.Compress(encoding, 1024));
+    writer.Write(response, headers, received);
+
+    EXPECT_EQ(headers["content-encoding"], name);
+    EXPECT_EQ(headers["vary"], _T("Accept-Encoding"));
+    EXPECT_EQ(headers["content-length"], Core::NumberType<uint32_t>(static_cast<uint32_t>(received.size())).Text());
+    EXPECT_LT(received.size(), content.size() / 4);
+
+    EXPECT_TRUE(Inflate(received.data(), static_cast<uint32_t>(received.size()), windowBits, inflated));
+    EXPECT_TRUE(inflated == content);
+}
+
+TEST(Web_Compression, Gzip)
+{
+    CompressedResponse(Web::ENCODING_GZIP, 16 + MAX_WBITS, _T("gzip"));
+}
+
+TEST(Web_Compression, Deflate)
+{
+    CompressedResponse(Web::ENCODING_DEFLATE, MAX_WBITS, _T("deflate"));
+}
+
+TEST(Web_Compression, BelowThreshold)
+{
+    const std::vector<uint8_t> content(Text(1000));
+    Core::ProxyType<Web::TextBody> body(Core::ProxyType<Web::TextBody>::Create());
+    Web::Response response;
+    ResponseWriter writer;
+    std::map<string, string> headers;
+    std::vector<uint8_t> received;
+
+    *body = string(content.begin(), content.end());
+    response.ContentType = Web::MIME_TEXT;
+    response.Body(body);
+
+    EXPECT_FALSE(response.Compress(Web::ENCODING_GZIP, 1024));
+    writer.Write(response, headers, received);
+
+    EXPECT_TRUE(headers.find("content-encoding") == headers.end());
+    EXPECT_TRUE(headers.find("vary") == headers.end());
+    EXPECT_TRUE(received == content);
+}
+
+TEST(Web_Compression, NotAccepted)
+{
+    // Sent as is, but it would have been compressed for another request.
+    const std::vector<uint8_t> content(Text(20000));
+    Core::ProxyType<Web::TextBody> body(Core::ProxyType<Web::TextBody>::Create());
+    Web::Response response;
+    ResponseWriter writer;
+    std::map<string, string> headers;
+    std::vector<uint8_t> received;
+
+    *body = string(content.begin(), content.end());
+    response.ContentType = Web::MIME_TEXT;
+    response.Body(body);
+
+    EXPECT_FALSE(response.Compress(Web::ENCODING_UNKNOWN, 1024));
+    writer.Write(response, headers, received);
+
+    EXPECT_TRUE(headers.find("content-encoding") == headers.end());
+    EXPECT_EQ(headers["vary"], _T("Accept-Encoding"));
+    EXPECT_TRUE(received == content);
+}
+
+static uint32_t Descriptors()
+{
+    uint32_t count = 0;
+    Core::Directory fds(_T("/proc/self/fd"));
+
+    while (fds.Next() == true) {
+        count++;
+    }
+
+    return (count);
+}
+
+TEST(Web_Compression, Incompressible)
+{
+    // Does not get any smaller, so it is sent as is. The file is rewound for that, not opened again.
+    const std::vector<uint8_t> content(Noise(20000));
+    const string path(_T("/tmp/wpeframework_noise.bin"));
+    Core::File file(path);
+
+    ASSERT_TRUE(file.Create());
+    file.Write(content.data(), static_cast<uint32_t>(content.size()));
+    file.Close();
+
+    const uint32_t descriptors = Descriptors();
+
+    for (uint8_t round = 0; round < 2; round++) {
+        Core::ProxyType<Web::FileBody> body(Core::ProxyType<Web::FileBody>::Create());
+        Web::Response response;
+        ResponseWriter writer;
+        std::map<string, string> headers;
+        std::vector<uint8_t> received;
+
+        *body = path;
+        response.ContentType = Web::MIME_TEXT;
+        response.Body(body);
+
+        EXPECT_FALSE(response.Compress(Web::ENCODING_GZIP, 1024));
+        writer.Write(response, headers, received);
+
+        EXPECT_TRUE(headers.find("content-encoding") == headers.end());
+        EXPECT_EQ(headers["content-length"], _T("20000"));
+        EXPECT_TRUE(received == content);
+        EXPECT_FALSE(body->IsOpen());
+    }
+
+    EXPECT_EQ(Descriptors(), descriptors);
+
+    file.Destroy();
+}
+
+// Negotiates permessage-deflate between a client and a server, as the upgrade does.
+static void Negotiate(Web::WebSocket::Protocol& client, Web::WebSocket::Protocol& server, const bool contextTakeover)
+{
+    string response;
+
+    client.Compression(true, contextTakeover);
+    server.Compression(true, contextTakeover);
+
+    const string offer(client.CompressionOffer());
+
+    EXPECT_EQ(offer, (contextTakeover ? _T("permessage-deflate") : _T("permessage-deflate; server_no_context_takeover; client_no_context_takeover")));
+    EXPECT_TRUE(server.CompressionOffered(offer, response));
+    EXPECT_TRUE(client.CompressionAccepted(response));
+    EXPECT_TRUE(client.IsCompressed());
+    EXPECT_TRUE(server.IsCompressed());
+}
+
+// Sends a message the way the WebSocketLink does, in frames with room for at most room bytes of payload.
+static void SendMessage(Web::WebSocket::Protocol& sender, const std::vector<uint8_t>& message, const uint16_t room, std::vector<uint8_t>& wire, uint32_t& frames)
+{
+    std::vector<uint8_t> frame(room + 14);
+    uint32_t offset = 0;
+    bool final = false;
+
+    frames = 0;
+
+    while (final == false) {
+        const uint8_t header = sender.HeaderSize();
+        uint16_t loaded = room;
+        uint16_t result;
+
+        do {
+            if (sender.IsStaging() == true) {
+                loaded = static_cast<uint16_t>(std::min(static_cast<uint32_t>(room), static_cast<uint32_t>(message.size()) - offset));
+                ::memcpy(sender.Staging(room), &(message.data()[offset]), loaded);
+                offset += loaded;
+                sender.Staged(loaded, (loaded < room));
+            }
+
+            result = sender.Deflate(&(frame[header]), room, final);
+
+        } while ((result == 0) && (final == false) && (loaded == room) && (sender.IsStaging() == true));
+
+        const uint16_t size = sender.Encoder(frame.data(), room, result, final);
+
+        if (size != 0) {
+            wire.insert(wire.end(), frame.begin(), frame.begin() + size);
+            frames++;
+        }
+    }
+}
+
+// Receives what is on the wire the way the WebSocketLink does, whole frames at a time.
+static void ReceiveMessages(Web::WebSocket::Protocol& receiver, std::vector<uint8_t>& wire, std::vector<uint8_t>& message)
+{
+    uint32_t result = 0;
+
+    message.clear();
+
+    while (result < wire.size()) {
+        uint16_t actualDataSize = static_cast<uint16_t>(std::min(static_cast<size_t>(0xFFFF), wire.size() - result));
+        const uint16_t headerSize = receiver.Decoder(&(wire[result]), actualDataSize);
+
+        ASSERT_FALSE((headerSize == 0) && (actualDataSize == 0));
+        ASSERT_TRUE(receiver.IsCompressedMessage());
+
+        uint8_t* inflated;
+        uint16_t length;
+
+        receiver.Inflate(&(wire[result + headerSize]), actualDataSize, ((receiver.IsCompleteMessage() == true) && (receiver.ReceiveInProgress() == false)));
+
+        while ((length = receiver.Inflated(inflated)) != 0) {
+            message.insert(message.end(), inflated, &(inflated[length]));
+        }
+
+        result += (headerSize + actualDataSize);
+    }
+}
+
+// Header size of the unmasked frame at the start of the wire.
+static uint8_t Header(const std::vector<uint8_t>& wire)
+{
+    return ((wire[1] & 0x7F) <= 125 ? 2 : 4);
+}
+
+TEST(WebSocket_Compression, FragmentedMessages)
+{
+    for (const bool masking : { false, true }) {
+        for (const uint16_t room : { 16, 125, 1000, 4000 }) {
+            Web::WebSocket::Protocol client(false, true);
+            Web::WebSocket::Protocol server(false, false);
+            Web::WebSocket::Protocol& sender(masking ? client : server);
+            Web::WebSocket::Protocol& receiver(masking ? server : client);
+            const std::vector<uint8_t> content(Text(50000));
+            std::vector<uint8_t> wire, received;
+            uint32_t frames;
+
+            Negotiate(client, server, true);
+            SendMessage(sender, content, room, wire, frames);
+
+            // Only the first frame carries the compressed flag (RSV1).
+            EXPECT_EQ((wire[0] & 0x40), 0x40);
+            EXPECT_LT(wire.size(), content.size() / 4);
+            if (room < 1000) {
+                EXPECT_GT(frames, 1u) << "room " << room;
+                EXPECT_EQ((wire[(wire[1] & 0x7F) + 2 + (masking ? 4 : 0)] & 0x40), 0) << "room " << room;
+            }
+
+            ReceiveMessages(receiver, wire, received);
+            EXPECT_TRUE(received == content) << "room " << room << " masking " << masking;
+        }
+    }
+}
+
+TEST(WebSocket_Compression, ContextTakeover)
+{
+    for (const bool takeover : { true, false }) {
+        Web::WebSocket::Protocol client(false, true);
+        Web::WebSocket::Protocol server(false, false);
+        // Hardly repeats itself, but the second message repeats the first one.
+        std::vector<uint8_t> content(Noise(3000));
+        for (uint8_t& entry : content) {
+            entry = 'a' + (entry & 0x0F);
+        }
+        std::vector<uint8_t> first, second, received;
+        uint32_t frames;
+
+        Negotiate(client, server, takeover);
+
+        SendMessage(server, content, 4000, first, frames);
+        SendMessage(server, content, 4000, second, frames);
+
+        if (takeover == true) {
+            // The second one refers back to the first one.
+            EXPECT_LT(second.size(), first.size() / 4);
+
+            std::vector<uint8_t> both(first);
+            both.insert(both.end(), second.begin(), second.end());
+            ReceiveMessages(client, both, received);
+
+            std::vector<uint8_t> expected(content);
+            expected.insert(expected.end(), content.begin(), content.end());
+            EXPECT_TRUE(received == expected);
+        } else {
+            // Every message stands on its own, it can be inflated without the ones before.
+            EXPECT_TRUE(first == second);
+
+            ReceiveMessages(client, first, received);
+            EXPECT_TRUE(received == content);
+            ReceiveMessages(client, second, received);
+            EXPECT_TRUE(received == content);
+
+            std::vector<uint8_t> inflated;
+            EXPECT_TRUE(Inflate(&(second[Header(second)]), static_cast<uint32_t>(second.size() - Header(second)), -MAX_WBITS, inflated));
+            EXPECT_TRUE(inflated == content);
+        }
+    }
+}
+
+TEST(WebSocket_Compression, SyncFlushTail)
+{
+    for (const uint32_t length : { 1, 10, 100, 5000 }) {
+        Web::WebSocket::Protocol client(false, true);
+        Web::WebSocket::Protocol server(false, false);
+        const std::vector<uint8_t> content(Text(length));
+        std::vector<uint8_t> wire, received, inflated;
+        uint32_t frames;
+
+        Negotiate(client, server, false);
+        SendMessage(server, content, 8000, wire, frames);
+
+        ASSERT_EQ(frames, 1u);
+
+        // The 0x00 0x00 0xFF 0xFF that ends the flush is left out ..
+        std::vector<uint8_t> payload(wire.begin() + Header(wire), wire.end());
+        const uint8_t tail[] = { 0x00, 0x00, 0xFF, 0xFF };
+
+        ASSERT_GE(payload.size(), 1u);
+        EXPECT_FALSE((payload.size() >= 4) && (::memcmp(&(payload[payload.size() - 4]), tail, sizeof(tail)) == 0)) << "length " << length;
+
+        // .. and with it appended again, it is a plain raw deflate stream.
+        payload.insert(payload.end(), tail, &(tail[sizeof(tail)]));
+        EXPECT_TRUE(Inflate(payload.data(), static_cast<uint32_t>(payload.size()), -MAX_WBITS, inflated));
+        EXPECT_TRUE(inflated == content) << "length " << length;
+
+        ReceiveMessages(client, wire, received);
+        EXPECT_TRUE(received == content) << "length " << length;
+    }
+}
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,364 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <plugins/plugins.h>
+
+#include <sys/socket.h>
+
+using namespace WPEFramework;
+
+namespace {
+
+// A channel on one end of a socket pair that is never upgraded, so nothing but the test
+// takes messages from its send queue. Serialize() is what the websocket would call.
+class Channel : public PluginHost::Channel {
+public:
+    Channel() = delete;
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    Channel(const SOCKET& connector)
+        : PluginHost::Channel(connector, Core::NodeId(_T("/tmp/wpechannel01")))
+    {
+        Open(0);
+        State(JSONRPC, false);
+    }
+    ~Channel() override
+    {
+        Close(Core::infinite);
+    }
+
+public:
+    using PluginHost::Channel::Limits;
+
+    // Start on the message at the head of the queue, without finishing it.
+    string Start(const uint16_t frame)
+    {
+        uint8_t buffer[64];
+
+        ASSERT(frame <= sizeof(buffer));
+
+        const uint16_t loaded = Serialize(buffer, frame);
+
+        return (string(reinterpret_cast<const char*>(buffer), loaded));
+    }
+    // Send out the message at the head of the queue, in frames of the given size.
+    string Next(const uint16_t frame = 64)
+    {
+        string result;
+        const uint32_t queued = QueuedMessages();
+
+        while ((QueuedMessages() == queued) && (queued != 0)) {
+            result += Start(frame);
+        }
+
+        return (result);
+    }
+
+private:
+    void LinkBody(Core::ProxyType<PluginHost::Request>&) override
+    {
+    }
+    void Received(Core::ProxyType<PluginHost::Request>&) override
+    {
+    }
+    void Send(const Core::ProxyType<Web::Response>&) override
+    {
+    }
+    void Send(const Core::ProxyType<Core::JSON::IElement>&) override
+    {
+    }
+    Core::ProxyType<Core::JSON::IElement> Element(const string&) override
+    {
+        return (Core::ProxyType<Core::JSON::IElement>());
+    }
+    void Received(Core::ProxyType<Core::JSON::IElement>&) override
+    {
+    }
+    uint16_t SendData(uint8_t*, const uint16_t) override
+    {
+        return (0);
+    }
+    uint16_t ReceiveData(uint8_t*, const uint16_t receivedSize) override
+    {
+        return (receivedSize);
+    }
+    void Received(const string&) override
+    {
+    }
+    void StateChange() override
+    {
+    }
+};
+
+class Core_Channel : public ::testing::Test {
+protected:
+    Core_Channel()
+        : _channel()
+        , _peer(INVALID_SOCKET)
+    {
+    }
+
+    void SetUp() override
+    {
+        int pair[2];
+
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+
+        _peer = pair[1];
+        _channel.reset(new Channel(pair[0]));
+
+        ASSERT_TRUE(_channel->IsOpen());
+    }
+    void TearDown() override
+    {
+        _channel.reset();
+        ::close(_peer);
+    }
+    static void TearDownTestCase()
+    {
+        Core::Singleton::Dispose();
+    }
+
+    static Core::ProxyType<Core::JSON::IElement> Notification(const string& event, const uint32_t sequence)
+    {
+        Core::ProxyType<Core::JSONRPC::Message> message(Core::ProxyType<Core::JSONRPC::Message>::Create());
+
+        message->Designator = event;
+        message->Parameters = Core::NumberType<uint32_t>(sequence).Text();
+
+        return (Core::ProxyType<Core::JSON::IElement>(message));
+    }
+    static Core::ProxyType<Core::JSON::IElement> Frame(const string& event, const uint32_t sequence)
+    {
+        // As the JSONRPC handler composes a notification up front for all its observers.
+        Core::ProxyType<Core::JSONRPC::Message> message(Core::ProxyType<Core::JSONRPC::Message>::Create());
+
+        message->Designator = _T("client.events.") + event;
+        message->Parameters = Core::NumberType<uint32_t>(sequence).Text();
+
+        return (Core::ProxyType<Core::JSON::IElement>(Core::ProxyType<Core::JSON::Serialized>::Create(*message, event)));
+    }
+    static Core::ProxyType<Core::JSON::IElement> Response(const uint32_t id)
+    {
+        Core::ProxyType<Core::JSONRPC::Message> message(Core::ProxyType<Core::JSONRPC::Message>::Create());
+
+        message->Id = id;
+        message->Result = _T("0");
+
+        return (Core::ProxyType<Core::JSON::IElement>(message));
+    }
+    // Short name of what was sent: "event:sequence" for a notification, "#id" for a response.
+    static string Name(const string& text)
+    {
+        Core::JSONRPC::Message message;
+
+        message.FromString(text);
+
+        return (message.Id.IsSet() == true ? _T("#") + Core::NumberType<uint32_t>(message.Id.Value()).Text() : message.Designator.Value() + ':' + message.Parameters.Value());
+    }
+    std::vector<string> Drain()
+    {
+        std::vector<string> result;
+
+        while (_channel->QueuedMessages() != 0) {
+            result.push_back(Name(_channel->Next()));
+        }
+
+        return (result);
+    }
+
+protected:
+    std::unique_ptr<Channel> _channel;
+    SOCKET _peer;
+};
+
+}
+
+TEST_F(Core_Channel, Unbounded)
+{
+    // Without limits nothing is dropped and the ring grows as needed.
+    for (uint32_t index = 0; index < 20; index++) {
+        _channel->Submit(Notification(_T("tick"), index));
+    }
+
+    EXPECT_EQ(_channel->QueuedMessages(), 20u);
+    EXPECT_EQ(_channel->PeakMessages(), 20u);
+
+    std::vector<string> sent(Drain());
+
+    ASSERT_EQ(sent.size(), 20u);
+    for (uint32_t index = 0; index < 20; index++) {
+        EXPECT_EQ(sent[index], _T("tick:") + Core::NumberType<uint32_t>(index).Text());
+    }
+
+    EXPECT_EQ(_channel->QueuedBytes(), 0u);
+    EXPECT_EQ(_channel->DroppedMessages(), 0u);
+}
+
+TEST_F(Core_Channel, WrapAroundWithHoles)
+{
+    // Move the head to the end of the ring of eight, so what follows wraps around.
+    for (uint32_t index = 0; index < 6; index++) {
+        _channel->Submit(Notification(_T("n"), index));
+    }
+    for (uint32_t index = 0; index < 5; index++) {
+        _channel->Next();
+    }
+
+    _channel->Submit(Response(0));
+    _channel->Submit(Notification(_T("n"), 6));
+    _channel->Submit(Response(1));
+    _channel->Submit(Notification(_T("n"), 7));
+    _channel->Submit(Notification(_T("n"), 8));
+
+    // Dropping n:6 and n:7 leaves holes on both sides of the wrap.
+    _channel->Limits(5, 0, Channel::DROP_OLDEST);
+    _channel->Submit(Notification(_T("n"), 9));
+
+    EXPECT_EQ(_channel->QueuedMessages(), 5u);
+    EXPECT_EQ(_channel->DroppedMessages(), 2u);
+    EXPECT_EQ(Drain(), std::vector<string>({ _T("n:5"), _T("#0"), _T("#1"), _T("n:8"), _T("n:9") }));
+
+    // Fill the ring with holes, the next one squeezes them out before it grows.
+    _channel->Limits(0, 0, Channel::DROP_OLDEST);
+    _channel->Submit(Notification(_T("n"), 20));
+    _channel->Submit(Notification(_T("n"), 21));
+    _channel->Submit(Response(10));
+    _channel->Submit(Notification(_T("n"), 22));
+    _channel->Submit(Notification(_T("n"), 23));
+    _channel->Submit(Response(11));
+    _channel->Submit(Notification(_T("n"), 24));
+
+    _channel->Limits(4, 0, Channel::DROP_OLDEST);
+    _channel->Submit(Response(12));
+
+    EXPECT_EQ(_channel->QueuedMessages(), 4u);
+
+    // Responses are always delivered, even beyond the limit.
+    _channel->Submit(Response(13));
+    _channel->Submit(Response(14));
+
+    EXPECT_EQ(_channel->QueuedMessages(), 6u);
+    EXPECT_EQ(_channel->DroppedMessages(), 6u);
+    EXPECT_EQ(Drain(), std::vector<string>({ _T("n:20"), _T("#10"), _T("#11"), _T("#12"), _T("#13"), _T("#14") }));
+    EXPECT_EQ(_channel->QueuedBytes(), 0u);
+}
+
+TEST_F(Core_Channel, CoalesceByEvent)
+{
+    _channel->Limits(3, 0, Channel::COALESCE);
+
+    _channel->Submit(Response(0));
+    _channel->Submit(Notification(_T("volume"), 1));
+    _channel->Submit(Notification(_T("mute"), 1));
+
+    // The newer volume takes the place of the queued one.
+    _channel->Submit(Notification(_T("volume"), 2));
+    _channel->Submit(Notification(_T("volume"), 3));
+
+    EXPECT_EQ(_channel->QueuedMessages(), 3u);
+    EXPECT_EQ(_channel->DroppedMessages(), 2u);
+
+    // Nothing to replace, so the oldest notification goes.
+    _channel->Submit(Notification(_T("power"), 1));
+
+    EXPECT_EQ(_channel->DroppedMessages(), 3u);
+    EXPECT_EQ(Drain(), std::vector<string>({ _T("#0"), _T("mute:1"), _T("power:1") }));
+
+    // Notifications composed up front are coalesced on their label, the event name.
+    _channel->Submit(Response(1));
+    _channel->Submit(Frame(_T("statechange"), 1));
+    _channel->Submit(Frame(_T("volume"), 1));
+    _channel->Submit(Frame(_T("statechange"), 2));
+
+    EXPECT_EQ(Drain(), std::vector<string>({ _T("#1"), _T("client.events.statechange:2"), _T("client.events.volume:1") }));
+
+    // The one being sent is not replaced, a newer one of the same event queues behind it.
+    _channel->Submit(Notification(_T("volume"), 4));
+    _channel->Submit(Response(2));
+    _channel->Submit(Notification(_T("mute"), 2));
+    const string sent(_channel->Start(8));
+    _channel->Submit(Notification(_T("volume"), 5));
+
+    EXPECT_EQ(Name(sent + _channel->Next()), _T("volume:4"));
+    EXPECT_EQ(Drain(), std::vector<string>({ _T("#2"), _T("volume:5") }));
+}
+
+TEST_F(Core_Channel, DropOldestNeverTouchesHead)
+{
+    string head;
+
+    Notification(_T("n"), 0)->ToString(head);
+
+    _channel->Limits(2, 0, Channel::DROP_OLDEST);
+    _channel->Submit(Notification(_T("n"), 0));
+
+    // Halfway the head, the oldest notification behind it is the one to go.
+    string sent(_channel->Start(8));
+
+    for (uint32_t index = 1; index < 10; index++) {
+        _channel->Submit(Notification(_T("n"), index));
+        EXPECT_EQ(_channel->QueuedMessages(), 2u);
+    }
+
+    EXPECT_EQ(_channel->DroppedMessages(), 8u);
+
+    sent += _channel->Next();
+
+    EXPECT_EQ(sent, head);
+    EXPECT_EQ(Drain(), std::vector<string>({ _T("n:9") }));
+
+    // The same with a byte limit, that the head exceeds all by itself.
+    _channel->Limits(0, 40, Channel::DROP_OLDEST);
+    _channel->Submit(Frame(_T("n"), 10));
+    sent = _channel->Start(8);
+
+    for (uint32_t index = 11; index < 20; index++) {
+        _channel->Submit(Frame(_T("n"), index));
+        EXPECT_EQ(_channel->QueuedMessages(), 1u);
+    }
+
+    EXPECT_EQ(Name(sent + _channel->Next()), _T("client.events.n:10"));
+    EXPECT_EQ(_channel->QueuedMessages(), 0u);
+}
+
+TEST_F(Core_Channel, Disconnect)
+{
+    _channel->Limits(2, 0, Channel::DISCONNECT);
+
+    _channel->Submit(Response(0));
+    _channel->Submit(Notification(_T("n"), 0));
+
+    EXPECT_TRUE(_channel->IsOpen());
+
+    // A client that does not keep up is closed, rather than losing anything.
+    _channel->Submit(Notification(_T("n"), 1));
+
+    EXPECT_FALSE(_channel->IsOpen());
+    EXPECT_EQ(_channel->DroppedMessages(), 0u);
+
+    // And nothing is queued after that.
+    _channel->Submit(Response(1));
+
+    EXPECT_EQ(_channel->QueuedMessages(), 2u);
+}
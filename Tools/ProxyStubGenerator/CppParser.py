@@ -85,6 +85,7 @@ class Metadata:
         self.is_property = False
         self.length = None
         self.maxlength = None
+        self.shared = False
         self.interface = None
         self.param = OrderedDict()
         self.retval = OrderedDict()
@@ -271,6 +272,11 @@ class Identifier():
                         raise ParserError("maxlength tag not allowed on return value")
                     skip = 1
                     continue
+                elif token[1:] == "SHARED":
+                    if tags_allowed:
+                        self.meta.shared = True
+                    else:
+                        raise ParserError("shared tag not allowed on return value")
                 elif token[1:] == "INTERFACE":
                     self.meta.interface = string[i + 1]
                     skip = 1
@@ -1291,6 +1297,8 @@ def __Tokenize(contents):
                     tagtokens.append(__ParseLength(token, "@length"))
                 if _find("@maxlength", token):
                     tagtokens.append(__ParseLength(token, "@maxlength"))
+                if _find("@shared", token):
+                    tagtokens.append("@SHARED")
                 if _find("@interface", token):
                     tagtokens.append(__ParseLength(token, "@interface"))
 
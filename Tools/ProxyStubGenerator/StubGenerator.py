@@ -366,6 +366,7 @@ def GenerateStubs(output_file, source_file, includePaths = [], defaults="", scan
                     self.is_input = self.is_inputptr or self.is_inputref
                     self.ptr_length = length
                     self.ptr_maxlength = maxlength
+                    self.is_shared = meta.shared
                     self.ptr_interface = self.interface
                     self.proxy = self.is_interface and (not self.is_ref or self.is_input)
                     self.origname = origname
@@ -383,6 +384,10 @@ def GenerateStubs(output_file, source_file, includePaths = [], defaults="", scan
                     self.str_nocv = TypeStr(self.type).replace("const ", "").replace("volatile ", "")
                     self.str_cv = type.CVString()
 
+                    if self.is_shared and (not self.is_ptr or self.is_ref or self.obj or interface):
+                        raise TypenameError(
+                            type_, "unable to serialise '%s %s': only buffers can be shared" %
+                            (self.CppType(), self.origname))
                     if not self.obj and self.is_nonconstptr and not self.is_inputptr and not self.is_outputptr and not interface:
                         raise TypenameError(
                             type_, "unable to serialise '%s %s': a non-const pointer requires an in/out tag" %
@@ -625,6 +630,9 @@ def GenerateStubs(output_file, source_file, includePaths = [], defaults="", scan
                             if not p.ptr_length and not p.ptr_interface:
                                 raise TypenameError(
                                     p.oclass, "unable to serialise '%s': length variable not defined" % (p.origname))
+                            if p.is_shared and p.length_type == "void":
+                                raise TypenameError(
+                                    p.oclass, "unable to serialise '%s': only buffers can be shared" % (p.origname))
 
             for m in emit_methods:
                 if m.omit:
@@ -705,7 +713,19 @@ def GenerateStubs(output_file, source_file, includePaths = [], defaults="", scan
                                 if p.is_ptr and not p.obj and not p.is_ref and p.length_type == "void":
                                     emit.Line("%s %s = %s; // storage" % (p.str_typename, p.name, NULLPTR))
                                 elif p.is_ptr and not p.obj and not p.is_ref:
-                                    if p.is_input:
+                                    if p.is_shared:
+                                        emit.Line("%s%s %s = %s;" %
+                                                  ("" if p.is_output else "const ", p.str_nocvref, p.name, NULLPTR))
+                                        lock = "RPC::BulkBuffer::Lock(channel, reader, %s)" % p.name
+                                        if p.is_output:
+                                            emit.Line("uint32_t %s_capacity = 0;" % p.name)
+                                            lock = "RPC::BulkBuffer::Lock(channel, reader, %s, %s_capacity)" % (p.name, p.name)
+                                        if p.is_input:
+                                            emit.Line("%s %s_length = static_cast<%s>(%s);" %
+                                                      (p.length_type, p.name, p.length_type, lock))
+                                        else:
+                                            emit.Line("%s;" % lock)
+                                    elif p.is_input:
                                         emit.Line("const %s %s = %s;" % (p.str_nocvref, p.name, NULLPTR))
                                         emit.Line("%s %s_length = reader.Lock%s(%s);" %
                                                   (p.length_type, p.name, p.RpcTypeNoCV(), p.name))
@@ -729,7 +749,26 @@ def GenerateStubs(output_file, source_file, includePaths = [], defaults="", scan
                             elif not p.is_ptr and not p.CheckRpcType():
                                 pass
                             else:
-                                if p.is_ptr and not p.obj and p.is_output and p.length_type != "void":
+                                if p.is_ptr and not p.obj and p.is_output and p.is_shared:
+                                    emit.Line()
+                                    emit.Line("// use the shared buffer in place, or make room if it came in the frame")
+                                    if p.length_constant and not p.is_input:
+                                        emit.Line("const %s %s = %s;" % (p.length_type, p.length_var, p.length_expr))
+                                    if p.maxlength_var:
+                                        length_var = p.maxlength_expr if p.maxlength_constant else p.maxlength_var
+                                    else:
+                                        length_var = p.length_var
+                                    emit.Line("if (%s_capacity < %s) {" % (p.name, length_var))
+                                    emit.IndentInc()
+                                    emit.Line("%s %s_storage = static_cast<%s>(ALLOCA(%s));" %
+                                              (p.str_nocvref, p.name, p.str_nocvref, length_var))
+                                    emit.Line("ASSERT(%s_storage != %s);" % (p.name, NULLPTR))
+                                    if p.is_input:
+                                        emit.Line("::memcpy(%s_storage, %s, %s);" % (p.name, p.name, p.length_var))
+                                    emit.Line("%s = %s_storage;" % (p.name, p.name))
+                                    emit.IndentDec()
+                                    emit.Line("}")
+                                elif p.is_ptr and not p.obj and p.is_output and p.length_type != "void":
                                     if p.is_output:
                                         emit.Line()
                                         if p.is_input:
@@ -875,12 +914,16 @@ def GenerateStubs(output_file, source_file, includePaths = [], defaults="", scan
                                 else:
                                     if p.length_var and p.length_ref and p.length_ref.is_output:
                                         emit.Line("writer.%s(%s);" % (p.length_ref.RpcType(), p.length_var))
-                                    emit.Line("if ((%s != %s) && (%s != 0)) {" % (p.name, NULLPTR, p.length_var))
-                                    emit.IndentInc()
-                                    emit.Line("writer.%s(%s, %s);" %
-                                              (p.RpcType(), p.length_var if p.length_var else p.maxlength_var, p.name))
-                                    emit.IndentDec()
-                                    emit.Line("}")
+                                    if p.is_shared:
+                                        emit.Line("RPC::BulkBuffer::Complete(channel, writer, %s, %s);" %
+                                                  (p.length_var if p.length_var else p.maxlength_var, p.name))
+                                    else:
+                                        emit.Line("if ((%s != %s) && (%s != 0)) {" % (p.name, NULLPTR, p.length_var))
+                                        emit.IndentInc()
+                                        emit.Line("writer.%s(%s, %s);" %
+                                                  (p.RpcType(), p.length_var if p.length_var else p.maxlength_var, p.name))
+                                        emit.IndentDec()
+                                        emit.Line("}")
                             elif p.is_nonconstref:
                                 if not p.is_length:
                                     if p.is_interface:
@@ -993,7 +1036,7 @@ def GenerateStubs(output_file, source_file, includePaths = [], defaults="", scan
                 for i, p in enumerate(params):
                     p.name += str(i)
                     if (not p.is_nonconstref and not p.is_nonconstptr) or (p.is_input and not p.is_length) or (
-                            p.is_ptr and p.obj) or (p.is_length and not params[p.length_target].is_input):
+                            p.is_ptr and p.obj) or (p.is_length and not params[p.length_target].is_input) or p.is_shared:
                         input_params += 1
 
                 method_line = PrototypeStr(m, orig_params) + (" override" if not USE_OLD_CPP else " /* override */")
@@ -1015,6 +1058,7 @@ def GenerateStubs(output_file, source_file, includePaths = [], defaults="", scan
 
                 proxy_params = 0
                 output_params = 0
+                shared_params = []
 
                 if not m.stub:
                     emit.Line("IPCMessage newMessage(BaseClass::Message(%i));" % count)
@@ -1044,7 +1088,15 @@ def GenerateStubs(output_file, source_file, includePaths = [], defaults="", scan
                                 if p.is_ptr and p.obj:
                                     proxy_params += 1
                                 if not p.obj and p.is_ptr:
-                                    if p.is_input:
+                                    if p.is_shared:
+                                        capacity = p.maxlength_expr if (p.is_output and p.maxlength_expr) else p.length_expr
+                                        emit.Line("RPC::BulkBuffer param%i_bulk(BaseClass::Channel(), %s);" % (c, capacity))
+                                        shared_params.append(p)
+                                        if p.is_input:
+                                            emit.Line("param%i_bulk.Write(writer, param%i, %s);" % (c, c, p.length_expr))
+                                        else:
+                                            emit.Line("param%i_bulk.Write(writer, %s, 0);" % (c, NULLPTR))
+                                    elif p.is_input:
                                         emit.Line("writer.%s(%s, param%i);" % (p.RpcType(), p.length_expr, c))
                                 elif not p.is_input and p.is_nonconstref and p.is_nonconstptr:
                                     pass
@@ -1067,6 +1119,10 @@ def GenerateStubs(output_file, source_file, includePaths = [], defaults="", scan
 
                     retval_has_proxy = retval.has_output and retval.is_interface
 
+                    # a shared buffer that fits neither the arena nor the frame fails the call
+                    shared_valid = " && ".join(["(%s_bulk.IsValid() == true)" % p.name for p in shared_params])
+                    shared_check = shared_valid if len(shared_params) == 1 else "(%s)" % shared_valid
+
                     emit.Line("// invoke the method handler")
                     if retval.has_output:
                         default = "{}"
@@ -1076,13 +1132,26 @@ def GenerateStubs(output_file, source_file, includePaths = [], defaults="", scan
                                   (retval.str_nocvref, retval.name, "_proxy" if retval_has_proxy else "", default))
                         # assume it's a status code
                         if isinstance(retval.typename, CppParser.Integer) and retval.typename.type == "uint32_t":
-                            emit.Line("if ((%s = Invoke(newMessage)) == Core::ERROR_NONE) {" % retval.name)
+                            if shared_params:
+                                emit.Line("if ((%s = (%s ? Invoke(newMessage) : Core::ERROR_INVALID_INPUT_LENGTH)) == Core::ERROR_NONE) {" %
+                                          (retval.name, shared_check))
+                            else:
+                                emit.Line("if ((%s = Invoke(newMessage)) == Core::ERROR_NONE) {" % retval.name)
+                        elif shared_params:
+                            emit.Line("if (%s && (Invoke(newMessage) == Core::ERROR_NONE)) {" % shared_valid)
                         else:
                             emit.Line("if (Invoke(newMessage) == Core::ERROR_NONE) {")
                         emit.IndentInc()
                     elif proxy_params + output_params > 0:
-                        emit.Line("if (Invoke(newMessage) == Core::ERROR_NONE) {")
+                        if shared_params:
+                            emit.Line("if (%s && (Invoke(newMessage) == Core::ERROR_NONE)) {" % shared_valid)
+                        else:
+                            emit.Line("if (Invoke(newMessage) == Core::ERROR_NONE) {")
                         emit.IndentInc()
+                    elif shared_params:
+                        emit.Line("if %s {" % shared_check)
+                        emit.Line("    Invoke(newMessage);")
+                        emit.Line("}")
                     else:
                         emit.Line("Invoke(newMessage);")
 
@@ -1127,11 +1196,14 @@ def GenerateStubs(output_file, source_file, includePaths = [], defaults="", scan
                         elif not p.obj and p.is_outputptr:
                             if p.length_var and p.length_ref and p.length_ref.is_output:
                                 emit.Line("%s = reader.%s();" % (p.length_ref.name, p.length_ref.RpcType()))
-                            emit.Line("if ((%s != 0) && (%s != 0)) {" % (p.name, p.length_expr))
-                            emit.IndentInc()
-                            emit.Line("reader.%s(%s, %s);" % (p.RpcType(), p.length_expr, p.name))
-                            emit.IndentDec()
-                            emit.Line("}")
+                            if p.is_shared:
+                                emit.Line("%s_bulk.Read(reader, %s);" % (p.name, p.name))
+                            else:
+                                emit.Line("if ((%s != 0) && (%s != 0)) {" % (p.name, p.length_expr))
+                                emit.IndentInc()
+                                emit.Line("reader.%s(%s, %s);" % (p.RpcType(), p.length_expr, p.name))
+                                emit.IndentDec()
+                                emit.Line("}")
                         elif p.is_nonconstref and not p.is_length:
                             emit.Line("%s = reader.%s();" % (p.name, p.RpcTypeNoCV()))
 
@@ -1281,6 +1353,13 @@ if __name__ == "__main__":
                            action="store",
                            default="",
                            help="specify output directory (default: generate files in the same directory as source)")
+    argparser.add_argument("--index",
+                           dest="index_file",
+                           metavar="FILE",
+                           action="store",
+                           default="",
+                           help="append the IDs of the generated interfaces to an index file, so the proxy/stub library\n"
+                                "they are built into can be loaded on first use (default: no index)")
     argparser.add_argument("--indent",
                            dest="indent_size",
                            metavar="SIZE",
@@ -1346,6 +1425,10 @@ if __name__ == "__main__":
         print("   @maxlength:<expr>   - specifies a maximum buffer length value (a constant, a parameter name or a math expression),")
         print("                         if not specified @length is used as maximum length, use round parenthesis for expressions",)
         print("                         e.g.: @length:bufferSize @length:(width*height*4)")
+        print("   @shared             - pass a (large) buffer through the shared memory arena of the channel,")
+        print("                         only its offset and length go over the socket. Without room in the arena a buffer")
+        print("                         of 60 KiB or more does not fit, the call is not made then (a status code returns")
+        print("                         ERROR_INVALID_INPUT_LENGTH)")
         print("")
         print("The tags shall be placed inside comments.")
         sys.exit()
@@ -1426,6 +1509,12 @@ if __name__ == "__main__":
                 else:
                     log.Info("can't evaluate interface ID \"%s\" of %s" % (str(f.id), f.obj.full_name), f.file)
 
+            # One line per interface, an ID that could not be evaluated is written as '*'
+            if args.index_file and not scan_only:
+                with open(args.index_file, "a") as index_file:
+                    for f in sorted_faces:
+                        index_file.write("%s %s\n" % (("0x%08X" % f.id) if isinstance(f.id, int) else "*", f.obj.full_name))
+
             if len(interface_files) > 1 and BE_VERBOSE:
                 print("")
 